@@ -0,0 +1,748 @@
+/** @file Benchmark.c
+ * Measure the solver speed on a corpus of grids. All grids are loaded in memory, then each one is solved several times by the same workers, so only the solving is measured. The throughput and the latency percentiles of each grid size are printed in a machine-readable format.
+ * @author Adrien RICCIARDI
+ */
+#include <Affinity.h>
+#include <Configuration.h>
+#include <dirent.h>
+#include <Grid.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Timer.h>
+#include <unistd.h>
+#include <Worker.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** The directory containing the default corpus. */
+#define BENCHMARK_DEFAULT_CORPUS_DIRECTORY "Tests"
+
+/** The size of the buffer holding a file path. */
+#define BENCHMARK_PATH_MAXIMUM_LENGTH 1024
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** How the results are printed. */
+typedef enum
+{
+	BENCHMARK_OUTPUT_FORMAT_JSON, //!< A single JSON object.
+	BENCHMARK_OUTPUT_FORMAT_CSV //!< A header line, then a line per grid size and a line for all grids.
+} TBenchmarkOutputFormat;
+
+/** A grid of the corpus. */
+typedef struct
+{
+	char *String_Grid; //!< The grid in the batch mode format, so it can be loaded again before each solving.
+	unsigned int Grid_Size; //!< The grid side size in cells.
+} TBenchmarkGrid;
+
+/** The measures of all grids having the same size. */
+typedef struct
+{
+	unsigned int Grids_Count; //!< How many corpus grids have this size.
+	unsigned int Failures_Count; //!< How many measured solvings did not find a solution.
+	unsigned long long *Pointer_Latencies; //!< The duration in nanoseconds of each measured solving.
+	unsigned int Latencies_Count; //!< How many solvings have been measured.
+	unsigned int Latencies_Capacity; //!< How many latencies the array can hold before being enlarged.
+} TBenchmarkSizeClass;
+
+/** The whole corpus measures for a threads count of the scaling mode. */
+typedef struct
+{
+	int Workers_Count; //!< How many threads solved the grids.
+	unsigned int Solvings_Count; //!< How many solvings have been measured.
+	unsigned int Failures_Count; //!< How many measured solvings did not find a solution.
+	unsigned long long Total_Latency; //!< The sum of all measured solvings durations in nanoseconds.
+	unsigned long long Busy_Time; //!< The time in nanoseconds all workers spent solving jobs during the measured solvings.
+} TBenchmarkScalingStep;
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** All grids to solve. */
+static TBenchmarkGrid *Pointer_Benchmark_Grids = NULL;
+/** How many grids the corpus contains. */
+static unsigned int Benchmark_Grids_Count = 0;
+
+/** The measures of each grid size, indexed by the grid size. */
+static TBenchmarkSizeClass Benchmark_Size_Classes[CONFIGURATION_GRID_MAXIMUM_SIZE + 1];
+
+/** The measures of each threads count of the scaling mode (the threads count is doubled each time, starting from 1, and the maximum count is always measured). */
+static TBenchmarkScalingStep Benchmark_Scaling_Steps[32];
+/** How many threads counts have been measured. */
+static unsigned int Benchmark_Scaling_Steps_Count = 0;
+
+/** The workers statistics before a measured solving. */
+static TWorkerStatistics Benchmark_Workers_Statistics_Before[CONFIGURATION_WORKERS_MAXIMUM_COUNT];
+/** The workers statistics after a measured solving. */
+static TWorkerStatistics Benchmark_Workers_Statistics_After[CONFIGURATION_WORKERS_MAXIMUM_COUNT];
+
+/** The grid given to the workers. */
+static TGrid Benchmark_Grid;
+
+/** The workers solving the grids. */
+static TWorkerPool Benchmark_Worker_Pool;
+/** How the workers search for the grid solutions. */
+static TWorkerAlgorithm Benchmark_Algorithm = WORKER_ALGORITHM_BACKTRACK;
+/** How the workers choose the next cell to fill. */
+static TWorkerCellSelectionHeuristic Benchmark_Cell_Selection_Heuristic = WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL;
+/** How much deduction the workers do each time they fill a cell. */
+static TGridPropagationLevel Benchmark_Propagation_Level = GRID_PROPAGATION_LEVEL_NONE;
+/** Where the workers run, or NULL to let the scheduler choose. */
+static char *String_Benchmark_Affinity_Policy = NULL;
+/** The processor of each worker. */
+static TAffinityProcessor Benchmark_Workers_Placement[CONFIGURATION_WORKERS_MAXIMUM_COUNT];
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Called when the program exits. */
+static void BenchmarkExit(void)
+{
+	WorkerUninitialize(&Benchmark_Worker_Pool);
+}
+
+/** Create the workers, give them the solving settings and bind them to their processors (the placement is printed to the error output).
+ * @param Workers_Count How many workers to create.
+ * @return 0 on success,
+ * @return -1 if the workers could not be created or bound.
+ */
+static int BenchmarkInitializeWorkers(int Workers_Count)
+{
+	if (WorkerInitialize(&Benchmark_Worker_Pool, Workers_Count) != 0) return -1;
+	WorkerSetAlgorithm(&Benchmark_Worker_Pool, Benchmark_Algorithm);
+	WorkerSetCellSelectionHeuristic(&Benchmark_Worker_Pool, Benchmark_Cell_Selection_Heuristic);
+	WorkerSetPropagationLevel(&Benchmark_Worker_Pool, Benchmark_Propagation_Level);
+	
+	if (String_Benchmark_Affinity_Policy != NULL)
+	{
+		if (AffinityComputePlacement(String_Benchmark_Affinity_Policy, Workers_Count, Benchmark_Workers_Placement) != 0) return -1;
+		if (WorkerBindToProcessors(&Benchmark_Worker_Pool, Benchmark_Workers_Placement) != 0) return -1;
+		AffinityShowPlacement(stderr, String_Benchmark_Affinity_Policy, Workers_Count, Benchmark_Workers_Placement);
+	}
+	return 0;
+}
+
+/** Add a grid to the corpus.
+ * @param String_Grid The grid in the batch mode format.
+ * @param Grid_Size The grid side size in cells.
+ * @return 0 on success,
+ * @return -1 if there is not enough memory.
+ */
+static int BenchmarkAddGrid(char *String_Grid, unsigned int Grid_Size)
+{
+	TBenchmarkGrid *Pointer_Grids;
+	
+	Pointer_Grids = realloc(Pointer_Benchmark_Grids, (Benchmark_Grids_Count + 1) * sizeof(TBenchmarkGrid));
+	if (Pointer_Grids == NULL) return -1;
+	Pointer_Benchmark_Grids = Pointer_Grids;
+	
+	Pointer_Benchmark_Grids[Benchmark_Grids_Count].String_Grid = strdup(String_Grid);
+	if (Pointer_Benchmark_Grids[Benchmark_Grids_Count].String_Grid == NULL) return -1;
+	Pointer_Benchmark_Grids[Benchmark_Grids_Count].Grid_Size = Grid_Size;
+	Benchmark_Grids_Count++;
+	Benchmark_Size_Classes[Grid_Size].Grids_Count++;
+	
+	return 0;
+}
+
+/** Add a grid file to the corpus.
+ * @param String_File_Name The grid file.
+ * @param Is_Unsupported_Grid_Skipped Set to 1 to ignore (with a warning) a grid whose size is not supported by this build, instead of failing.
+ * @return 0 on success,
+ * @return -1 if the grid could not be loaded.
+ */
+static int BenchmarkLoadGridFile(char *String_File_Name, int Is_Unsupported_Grid_Skipped)
+{
+	static char String_Grid[GRID_STRING_MAXIMUM_LENGTH + 1]; // Static to avoid using too much stack
+	int Result;
+	
+	Result = GridLoadFromFile(&Benchmark_Grid, String_File_Name);
+	if ((Result == -2) && Is_Unsupported_Grid_Skipped)
+	{
+		fprintf(stderr, "Warning : the grid file %s is skipped, its size is not supported (the maximum allowed size is %d).\n", String_File_Name, CONFIGURATION_GRID_MAXIMUM_SIZE);
+		return 0;
+	}
+	if (Result != 0)
+	{
+		fprintf(stderr, "Error : can't load the grid file %s.\n", String_File_Name);
+		return -1;
+	}
+	
+	// Keep the grid as a single line string, which is much smaller than a grid structure
+	GridConvertToString(&Benchmark_Grid, String_Grid);
+	if (BenchmarkAddGrid(String_Grid, Benchmark_Grid.Grid_Size) != 0)
+	{
+		fprintf(stderr, "Error : not enough memory to load the grid file %s.\n", String_File_Name);
+		return -1;
+	}
+	return 0;
+}
+
+/** Add all grids of a batch file (one grid per line, using the solver batch mode format) to the corpus.
+ * @param String_File_Name The batch file.
+ * @return 0 on success,
+ * @return -1 if a grid could not be loaded.
+ */
+static int BenchmarkLoadBatchFile(char *String_File_Name)
+{
+	FILE *Pointer_File;
+	static char String_Line[GRID_STRING_MAXIMUM_LENGTH + 3]; // +2 for the new line characters and +1 for terminating zero, static to avoid using too much stack
+	unsigned int Line_Number = 0;
+	
+	Pointer_File = fopen(String_File_Name, "rb");
+	if (Pointer_File == NULL)
+	{
+		fprintf(stderr, "Error : can't open the batch file %s.\n", String_File_Name);
+		return -1;
+	}
+	
+	while (fgets(String_Line, sizeof(String_Line), Pointer_File) != NULL)
+	{
+		// Silently ignore empty lines
+		Line_Number++;
+		if ((String_Line[0] == '\n') || (String_Line[0] == '\r')) continue;
+		
+		if ((GridLoadFromString(&Benchmark_Grid, String_Line) != 0) || (BenchmarkAddGrid(String_Line, Benchmark_Grid.Grid_Size) != 0))
+		{
+			fprintf(stderr, "Error : can't load the grid at line %u of the batch file %s.\n", Line_Number, String_File_Name);
+			fclose(Pointer_File);
+			return -1;
+		}
+	}
+	
+	fclose(Pointer_File);
+	return 0;
+}
+
+/** Compare two file names for qsort().
+ * @param Pointer_String_1 The first file name.
+ * @param Pointer_String_2 The second file name.
+ * @return The strcmp() result.
+ */
+static int BenchmarkCompareFileNames(const void *Pointer_String_1, const void *Pointer_String_2)
+{
+	return strcmp(*(char * const *) Pointer_String_1, *(char * const *) Pointer_String_2);
+}
+
+/** Add all the grid files of a directory (the ".txt" files) to the corpus, in alphabetical order so the runs are reproducible.
+ * @param String_Directory_Name The directory to scan.
+ * @param Is_Slow_Grids_Skipped Set to 1 to ignore the files starting with "Slow_", which are too slow to be solved without the most constrained cell heuristic.
+ * @return 0 on success (the grids too big for this build are skipped),
+ * @return -1 if a grid could not be loaded.
+ */
+static int BenchmarkLoadDirectory(char *String_Directory_Name, int Is_Slow_Grids_Skipped)
+{
+	DIR *Pointer_Directory;
+	struct dirent *Pointer_Entry;
+	char **Pointer_File_Names = NULL, **Pointer_Temporary_File_Names, String_Path[BENCHMARK_PATH_MAXIMUM_LENGTH];
+	unsigned int File_Names_Count = 0, i, Length;
+	int Return_Value = 0;
+	
+	Pointer_Directory = opendir(String_Directory_Name);
+	if (Pointer_Directory == NULL)
+	{
+		fprintf(stderr, "Error : can't open the directory %s.\n", String_Directory_Name);
+		return -1;
+	}
+	
+	// List the grid files
+	while ((Pointer_Entry = readdir(Pointer_Directory)) != NULL)
+	{
+		Length = strlen(Pointer_Entry->d_name);
+		if ((Length < 4) || (strcmp(&Pointer_Entry->d_name[Length - 4], ".txt") != 0)) continue;
+		if (Is_Slow_Grids_Skipped && (strncmp(Pointer_Entry->d_name, "Slow_", 5) == 0)) continue;
+		
+		Pointer_Temporary_File_Names = realloc(Pointer_File_Names, (File_Names_Count + 1) * sizeof(char *));
+		if (Pointer_Temporary_File_Names == NULL)
+		{
+			Return_Value = -1;
+			break;
+		}
+		Pointer_File_Names = Pointer_Temporary_File_Names;
+		Pointer_File_Names[File_Names_Count] = strdup(Pointer_Entry->d_name);
+		if (Pointer_File_Names[File_Names_Count] == NULL)
+		{
+			Return_Value = -1;
+			break;
+		}
+		File_Names_Count++;
+	}
+	closedir(Pointer_Directory);
+	if (Return_Value != 0) fprintf(stderr, "Error : not enough memory to list the directory %s.\n", String_Directory_Name);
+	
+	// Load the files in a reproducible order
+	qsort(Pointer_File_Names, File_Names_Count, sizeof(char *), BenchmarkCompareFileNames);
+	for (i = 0; i < File_Names_Count; i++)
+	{
+		if (Return_Value == 0)
+		{
+			snprintf(String_Path, sizeof(String_Path), "%s/%s", String_Directory_Name, Pointer_File_Names[i]);
+			Return_Value = BenchmarkLoadGridFile(String_Path, 1);
+		}
+		free(Pointer_File_Names[i]);
+	}
+	free(Pointer_File_Names);
+	
+	return Return_Value;
+}
+
+/** Solve the benchmark grid with all workers, the same way the solver does.
+ * @param String_Solution On output, contain the solved grid in the batch mode format if a solution has been found. Set to NULL when the solution is not needed.
+ * @return 0 if the grid has no solution,
+ * @return 1 if the grid has been solved.
+ */
+static int BenchmarkSolveGrid(char *String_Solution)
+{
+	TWorker *Pointer_Worker;
+	int Is_Grid_Solved;
+	
+	// Provide the whole grid to the first ready worker
+	WorkerWaitForAvailableWorker(&Benchmark_Worker_Pool, &Pointer_Worker);
+	GridCopy(&Benchmark_Grid, &Pointer_Worker->Grid);
+	WorkerSolve(Pointer_Worker);
+	
+	// Wait for a result, then make the workers available for the next grid
+	Is_Grid_Solved = WorkerWaitForCompletion(&Benchmark_Worker_Pool, &Pointer_Worker);
+	if (Is_Grid_Solved && (String_Solution != NULL)) GridConvertToString(&Pointer_Worker->Grid, String_Solution);
+	WorkerWaitForAllWorkersIdle(&Benchmark_Worker_Pool);
+	
+	return Is_Grid_Solved;
+}
+
+/** Replace each corpus grid by its solution. A solved grid is a job terminating as soon as it starts, so solving it measures how long it takes to give a job to a worker and to get the result back. The grids having no solution are removed from the corpus.
+ * @return 0 on success,
+ * @return -1 if there is not enough memory.
+ */
+static int BenchmarkReplaceGridsBySolutions(void)
+{
+	unsigned int Grid_Index, Kept_Grids_Count = 0, Size;
+	char *String_Solution;
+	
+	for (Grid_Index = 0; Grid_Index < Benchmark_Grids_Count; Grid_Index++)
+	{
+		String_Solution = malloc(GRID_STRING_MAXIMUM_LENGTH + 1); // The solution can be longer than the grid when empty cells are written with a single character
+		if (String_Solution == NULL) return -1;
+		
+		GridLoadFromString(&Benchmark_Grid, Pointer_Benchmark_Grids[Grid_Index].String_Grid);
+		GridUpdateFromCellValues(&Benchmark_Grid);
+		free(Pointer_Benchmark_Grids[Grid_Index].String_Grid);
+		Size = Pointer_Benchmark_Grids[Grid_Index].Grid_Size;
+		if (!BenchmarkSolveGrid(String_Solution))
+		{
+			free(String_Solution);
+			Benchmark_Size_Classes[Size].Grids_Count--;
+			continue;
+		}
+		
+		Pointer_Benchmark_Grids[Kept_Grids_Count].String_Grid = String_Solution;
+		Pointer_Benchmark_Grids[Kept_Grids_Count].Grid_Size = Size;
+		Kept_Grids_Count++;
+	}
+	Benchmark_Grids_Count = Kept_Grids_Count;
+	
+	return 0;
+}
+
+/** Record the duration of a solving.
+ * @param Pointer_Size_Class The size class of the solved grid.
+ * @param Latency The solving duration in nanoseconds.
+ * @return 0 on success,
+ * @return -1 if there is not enough memory.
+ */
+static int BenchmarkAddLatency(TBenchmarkSizeClass *Pointer_Size_Class, unsigned long long Latency)
+{
+	unsigned long long *Pointer_Latencies;
+	unsigned int Capacity;
+	
+	// Enlarge the array when it is full
+	if (Pointer_Size_Class->Latencies_Count == Pointer_Size_Class->Latencies_Capacity)
+	{
+		Capacity = Pointer_Size_Class->Latencies_Capacity * 2;
+		if (Capacity == 0) Capacity = 64;
+		Pointer_Latencies = realloc(Pointer_Size_Class->Pointer_Latencies, Capacity * sizeof(unsigned long long));
+		if (Pointer_Latencies == NULL) return -1;
+		Pointer_Size_Class->Pointer_Latencies = Pointer_Latencies;
+		Pointer_Size_Class->Latencies_Capacity = Capacity;
+	}
+	
+	Pointer_Size_Class->Pointer_Latencies[Pointer_Size_Class->Latencies_Count] = Latency;
+	Pointer_Size_Class->Latencies_Count++;
+	return 0;
+}
+
+/** Solve all corpus grids with the currently initialized workers. The previous measures are discarded.
+ * @param Workers_Count How many workers are initialized.
+ * @param Warm_Up_Repetitions_Count How many times each grid is solved before being measured.
+ * @param Repetitions_Count How many times each grid is solved and measured.
+ * @param Pointer_Busy_Time On output, contain the time in nanoseconds all workers spent solving jobs during the measured solvings.
+ * @return 0 on success,
+ * @return -1 if there is not enough memory.
+ */
+static int BenchmarkMeasureCorpus(int Workers_Count, int Warm_Up_Repetitions_Count, int Repetitions_Count, unsigned long long *Pointer_Busy_Time)
+{
+	unsigned int Grid_Index, Size;
+	unsigned long long Starting_Time, Latency;
+	int i, j, Is_Grid_Solved;
+	
+	// Forget the previous measures, but keep the allocated memory
+	for (Size = 0; Size <= CONFIGURATION_GRID_MAXIMUM_SIZE; Size++)
+	{
+		Benchmark_Size_Classes[Size].Latencies_Count = 0;
+		Benchmark_Size_Classes[Size].Failures_Count = 0;
+	}
+	*Pointer_Busy_Time = 0;
+	
+	for (Grid_Index = 0; Grid_Index < Benchmark_Grids_Count; Grid_Index++)
+	{
+		Size = Pointer_Benchmark_Grids[Grid_Index].Grid_Size;
+		for (i = 0; i < Warm_Up_Repetitions_Count + Repetitions_Count; i++)
+		{
+			// Only measure the solving, the grid was checked when the corpus was loaded
+			GridLoadFromString(&Benchmark_Grid, Pointer_Benchmark_Grids[Grid_Index].String_Grid);
+			GridUpdateFromCellValues(&Benchmark_Grid);
+			WorkerGetStatistics(&Benchmark_Worker_Pool, Benchmark_Workers_Statistics_Before);
+			Starting_Time = TimerGetNanoseconds();
+			Is_Grid_Solved = BenchmarkSolveGrid(NULL);
+			Latency = TimerGetNanoseconds() - Starting_Time;
+			
+			// Discard the warm-up solvings
+			if (i < Warm_Up_Repetitions_Count) continue;
+			WorkerGetStatistics(&Benchmark_Worker_Pool, Benchmark_Workers_Statistics_After);
+			for (j = 0; j < Workers_Count; j++) *Pointer_Busy_Time += Benchmark_Workers_Statistics_After[j].Busy_Time - Benchmark_Workers_Statistics_Before[j].Busy_Time;
+			if (!Is_Grid_Solved) Benchmark_Size_Classes[Size].Failures_Count++;
+			if (BenchmarkAddLatency(&Benchmark_Size_Classes[Size], Latency) != 0) return -1;
+		}
+	}
+	
+	return 0;
+}
+
+/** Compare two latencies for qsort().
+ * @param Pointer_Latency_1 The first latency.
+ * @param Pointer_Latency_2 The second latency.
+ * @return A negative value if the first latency is the shortest, 0 if both latencies are equal, a positive value if the first latency is the longest.
+ */
+static int BenchmarkCompareLatencies(const void *Pointer_Latency_1, const void *Pointer_Latency_2)
+{
+	unsigned long long Latency_1 = *(const unsigned long long *) Pointer_Latency_1, Latency_2 = *(const unsigned long long *) Pointer_Latency_2;
+	
+	if (Latency_1 < Latency_2) return -1;
+	if (Latency_1 > Latency_2) return 1;
+	return 0;
+}
+
+/** Get a percentile of sorted latencies, using the nearest rank method.
+ * @param Pointer_Latencies The latencies sorted in ascending order.
+ * @param Latencies_Count How many latencies there are (must not be 0).
+ * @param Percentile The percentile to compute, in range ]0; 100].
+ * @return The smallest latency that is greater than or equal to the requested percentage of all latencies.
+ */
+static unsigned long long BenchmarkGetPercentile(unsigned long long *Pointer_Latencies, unsigned int Latencies_Count, unsigned int Percentile)
+{
+	unsigned long long Rank;
+	
+	Rank = ((unsigned long long) Percentile * Latencies_Count + 99) / 100; // Round up
+	if (Rank == 0) Rank = 1;
+	return Pointer_Latencies[Rank - 1];
+}
+
+/** Print the statistics of a size class.
+ * @param Pointer_Size_Class The size class. Its latencies must be sorted.
+ * @param String_Name The size class name ("all" for the whole corpus, the grid size otherwise).
+ * @param Output_Format How to print the statistics.
+ */
+static void BenchmarkPrintSizeClass(TBenchmarkSizeClass *Pointer_Size_Class, char *String_Name, TBenchmarkOutputFormat Output_Format)
+{
+	unsigned long long Total_Latency = 0, Mean_Latency, Percentile_50, Percentile_90, Percentile_99, Maximum_Latency;
+	unsigned int i, Count;
+	double Throughput;
+	
+	// Compute the statistics
+	Count = Pointer_Size_Class->Latencies_Count;
+	for (i = 0; i < Count; i++) Total_Latency += Pointer_Size_Class->Pointer_Latencies[i];
+	Mean_Latency = Total_Latency / Count;
+	Throughput = Count / (Total_Latency / 1000000000.0);
+	Percentile_50 = BenchmarkGetPercentile(Pointer_Size_Class->Pointer_Latencies, Count, 50);
+	Percentile_90 = BenchmarkGetPercentile(Pointer_Size_Class->Pointer_Latencies, Count, 90);
+	Percentile_99 = BenchmarkGetPercentile(Pointer_Size_Class->Pointer_Latencies, Count, 99);
+	Maximum_Latency = Pointer_Size_Class->Pointer_Latencies[Count - 1];
+	
+	if (Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON) printf("{\"size\":\"%s\",\"grids\":%u,\"solvings\":%u,\"failures\":%u,\"grids_per_second\":%.3f,\"mean_ns\":%llu,\"p50_ns\":%llu,\"p90_ns\":%llu,\"p99_ns\":%llu,\"max_ns\":%llu}", String_Name,
+		Pointer_Size_Class->Grids_Count, Count, Pointer_Size_Class->Failures_Count, Throughput, Mean_Latency, Percentile_50, Percentile_90, Percentile_99, Maximum_Latency);
+	else printf("%s,%u,%u,%u,%.3f,%llu,%llu,%llu,%llu,%llu\n", String_Name, Pointer_Size_Class->Grids_Count, Count, Pointer_Size_Class->Failures_Count, Throughput, Mean_Latency, Percentile_50, Percentile_90, Percentile_99, Maximum_Latency);
+}
+
+/** Print the measures of a threads count of the scaling mode.
+ * @param Pointer_Scaling_Step The threads count measures.
+ * @param Pointer_Reference_Step The single thread measures.
+ * @param Output_Format How to print the measures.
+ */
+static void BenchmarkPrintScalingStep(TBenchmarkScalingStep *Pointer_Scaling_Step, TBenchmarkScalingStep *Pointer_Reference_Step, TBenchmarkOutputFormat Output_Format)
+{
+	double Throughput, Speedup, Efficiency, Idle_Fraction;
+	
+	// The idle fraction is the part of the available processing time (the solving duration multiplied by the threads count) during which the workers were not solving anything
+	Throughput = Pointer_Scaling_Step->Solvings_Count / (Pointer_Scaling_Step->Total_Latency / 1000000000.0);
+	Speedup = (double) Pointer_Reference_Step->Total_Latency / Pointer_Scaling_Step->Total_Latency;
+	Efficiency = Speedup / Pointer_Scaling_Step->Workers_Count;
+	Idle_Fraction = 1.0 - (double) Pointer_Scaling_Step->Busy_Time / ((double) Pointer_Scaling_Step->Total_Latency * Pointer_Scaling_Step->Workers_Count);
+	if (Idle_Fraction < 0) Idle_Fraction = 0; // The busy and total times are not measured at the same instants, so the busy time can be slightly bigger
+	
+	if (Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON) printf("{\"threads\":%d,\"solvings\":%u,\"failures\":%u,\"total_ns\":%llu,\"grids_per_second\":%.3f,\"speedup\":%.3f,\"efficiency\":%.3f,\"idle_fraction\":%.3f}", Pointer_Scaling_Step->Workers_Count, Pointer_Scaling_Step->Solvings_Count,
+		Pointer_Scaling_Step->Failures_Count, Pointer_Scaling_Step->Total_Latency, Throughput, Speedup, Efficiency, Idle_Fraction);
+	else printf("%d,%u,%u,%llu,%.3f,%.3f,%.3f,%.3f\n", Pointer_Scaling_Step->Workers_Count, Pointer_Scaling_Step->Solvings_Count, Pointer_Scaling_Step->Failures_Count, Pointer_Scaling_Step->Total_Latency, Throughput, Speedup, Efficiency, Idle_Fraction);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	int Option, Is_Batch_Corpus = 0, Is_Dispatch_Mode_Enabled = 0, Is_Most_Constrained_Cell_Heuristic_Enabled = 0, Propagation_Level = GRID_PROPAGATION_LEVEL_NONE, Repetitions_Count = 10, Warm_Up_Repetitions_Count = 1, Workers_Count, i, Result, Is_First_Size_Class = 1;
+	unsigned int Grid_Index, Size;
+	TBenchmarkOutputFormat Output_Format = BENCHMARK_OUTPUT_FORMAT_JSON;
+	TBenchmarkSizeClass All_Grids_Class;
+	int Is_Scaling_Mode_Enabled = 0, Scaling_Workers_Count;
+	unsigned long long Busy_Time;
+	TBenchmarkScalingStep *Pointer_Scaling_Step;
+	char String_Size[16];
+	DIR *Pointer_Directory;
+	
+	// Check options
+	while ((Option = getopt(argc, argv, "a:bdmo:p:r:sw:x")) != -1)
+	{
+		switch (Option)
+		{
+			case 'a':
+				String_Benchmark_Affinity_Policy = optarg;
+				break;
+			
+			case 'b':
+				Is_Batch_Corpus = 1;
+				break;
+			
+			case 'd':
+				Is_Dispatch_Mode_Enabled = 1;
+				break;
+			
+			case 'm':
+				Is_Most_Constrained_Cell_Heuristic_Enabled = 1;
+				Benchmark_Cell_Selection_Heuristic = WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL;
+				break;
+			
+			case 'o':
+				if (strcmp(optarg, "json") == 0) Output_Format = BENCHMARK_OUTPUT_FORMAT_JSON;
+				else if (strcmp(optarg, "csv") == 0) Output_Format = BENCHMARK_OUTPUT_FORMAT_CSV;
+				else
+				{
+					fprintf(stderr, "Error : the output format must be json or csv.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+			
+			case 'p':
+				Propagation_Level = atoi(optarg);
+				if ((Propagation_Level < GRID_PROPAGATION_LEVEL_NONE) || (Propagation_Level > GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES))
+				{
+					fprintf(stderr, "Error : the propagation level must be in range [%d; %d].\n", GRID_PROPAGATION_LEVEL_NONE, GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES);
+					return EXIT_FAILURE;
+				}
+				Benchmark_Propagation_Level = Propagation_Level;
+				break;
+			
+			case 'r':
+				Repetitions_Count = atoi(optarg);
+				if (Repetitions_Count <= 0)
+				{
+					fprintf(stderr, "Error : the repetitions count must be a number greater than or equal to 1.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+			
+			case 's':
+				Is_Scaling_Mode_Enabled = 1;
+				break;
+			
+			case 'w':
+				Warm_Up_Repetitions_Count = atoi(optarg);
+				if (Warm_Up_Repetitions_Count < 0)
+				{
+					fprintf(stderr, "Error : the warm-up repetitions count must be a positive number.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+			
+			case 'x':
+				Benchmark_Algorithm = WORKER_ALGORITHM_DANCING_LINKS;
+				break;
+			
+			default:
+				argc = 0; // Force usage display
+				break;
+		}
+	}
+	
+	// Check parameters
+	if (argc - optind < 1)
+	{
+		fprintf(stderr, "Usage : %s [-a Policy] [-b] [-d] [-m] [-o Format] [-p Level] [-r Repetitions] [-s] [-w Warm_Up_Repetitions] [-x] Maximum_Parallel_Threads [Grid_Files_Or_Directories...]\n"
+			"  -a : bind each thread to a logical processor using the compact, scatter or cores policy or a processors list (see the solver help), the placement is printed to the error output.\n"
+			"  -b : the provided files are batch files (one grid per line, like the solver batch mode).\n"
+			"  -d : dispatch latency mode, the workers are given the solutions of the corpus grids instead of the grids, so only the time needed to give a job to a worker and to get the result back is measured.\n"
+			"  -m : fill the most constrained cells first (see the solver help).\n"
+			"  -o : print the results as json (default) or csv.\n"
+			"  -p : set the constraint propagation level (see the solver help).\n"
+			"  -r : how many times each grid is solved and measured (default is 10).\n"
+			"  -s : measure the whole corpus with 1, 2, 4... threads up to Maximum_Parallel_Threads, and report the speedup, the parallel efficiency and the workers idle fraction of each threads count.\n"
+			"  -w : how many times each grid is solved before being measured, to fill the processor caches (default is 1).\n"
+			"  -x : use the dancing links algorithm (see the solver help).\n"
+			"When no grid is provided, all \".txt\" grid files of the \"%s\" directory are used, except the slow ones that need the -m or -x option.\n", argv[0], BENCHMARK_DEFAULT_CORPUS_DIRECTORY);
+		return EXIT_FAILURE;
+	}
+	Workers_Count = atoi(argv[optind]);
+	if ((Workers_Count <= 0) || (Workers_Count > CONFIGURATION_WORKERS_MAXIMUM_COUNT))
+	{
+		fprintf(stderr, "Error : maximum threads number must be in range [1; %d].\n", CONFIGURATION_WORKERS_MAXIMUM_COUNT);
+		return EXIT_FAILURE;
+	}
+	
+	// Load the whole corpus before measuring anything
+	if (argc - optind == 1) Result = BenchmarkLoadDirectory(BENCHMARK_DEFAULT_CORPUS_DIRECTORY, !Is_Most_Constrained_Cell_Heuristic_Enabled && (Benchmark_Algorithm == WORKER_ALGORITHM_BACKTRACK));
+	else
+	{
+		Result = 0;
+		for (i = optind + 1; (i < argc) && (Result == 0); i++)
+		{
+			if (Is_Batch_Corpus) Result = BenchmarkLoadBatchFile(argv[i]);
+			else
+			{
+				// A directory provides all its grid files
+				Pointer_Directory = opendir(argv[i]);
+				if (Pointer_Directory != NULL)
+				{
+					closedir(Pointer_Directory);
+					Result = BenchmarkLoadDirectory(argv[i], 0);
+				}
+				else Result = BenchmarkLoadGridFile(argv[i], 0);
+			}
+		}
+	}
+	if (Result != 0) return EXIT_FAILURE;
+	if (Benchmark_Grids_Count == 0)
+	{
+		fprintf(stderr, "Error : the corpus contains no grid.\n");
+		return EXIT_FAILURE;
+	}
+	
+	// Create all workers, the scaling mode raising the threads count of the same pool
+	if (BenchmarkInitializeWorkers(Workers_Count) != 0) return EXIT_FAILURE;
+	atexit(BenchmarkExit); // Automatically release the worker resources when the program exits
+	if (Is_Scaling_Mode_Enabled) Scaling_Workers_Count = 1; // Start from a single thread to get the reference duration
+	else Scaling_Workers_Count = Workers_Count;
+	WorkerSetWorkersCount(&Benchmark_Worker_Pool, Scaling_Workers_Count); // Only the first worker has been used yet, so this can't fail
+	
+	// Measure the job dispatching only
+	if (Is_Dispatch_Mode_Enabled)
+	{
+		if (BenchmarkReplaceGridsBySolutions() != 0)
+		{
+			fprintf(stderr, "Error : not enough memory to store the grids solutions.\n");
+			return EXIT_FAILURE;
+		}
+		if (Benchmark_Grids_Count == 0)
+		{
+			fprintf(stderr, "Error : the corpus contains no grid having a solution.\n");
+			return EXIT_FAILURE;
+		}
+	}
+	
+	// Solve the corpus with each threads count
+	while (1)
+	{
+		if (BenchmarkMeasureCorpus(Scaling_Workers_Count, Warm_Up_Repetitions_Count, Repetitions_Count, &Busy_Time) != 0)
+		{
+			fprintf(stderr, "Error : not enough memory to store the measures.\n");
+			return EXIT_FAILURE;
+		}
+		if (!Is_Scaling_Mode_Enabled) break;
+		
+		// Keep the whole corpus measures of this threads count
+		Pointer_Scaling_Step = &Benchmark_Scaling_Steps[Benchmark_Scaling_Steps_Count];
+		memset(Pointer_Scaling_Step, 0, sizeof(TBenchmarkScalingStep));
+		Pointer_Scaling_Step->Workers_Count = Scaling_Workers_Count;
+		Pointer_Scaling_Step->Busy_Time = Busy_Time;
+		for (Size = 0; Size <= CONFIGURATION_GRID_MAXIMUM_SIZE; Size++)
+		{
+			Pointer_Scaling_Step->Solvings_Count += Benchmark_Size_Classes[Size].Latencies_Count;
+			Pointer_Scaling_Step->Failures_Count += Benchmark_Size_Classes[Size].Failures_Count;
+			for (Grid_Index = 0; Grid_Index < Benchmark_Size_Classes[Size].Latencies_Count; Grid_Index++) Pointer_Scaling_Step->Total_Latency += Benchmark_Size_Classes[Size].Pointer_Latencies[Grid_Index];
+		}
+		Benchmark_Scaling_Steps_Count++;
+		
+		// Double the threads count until the requested maximum is reached, the maximum is always measured even if it is not a power of two
+		if (Scaling_Workers_Count == Workers_Count) break;
+		Scaling_Workers_Count *= 2;
+		if (Scaling_Workers_Count > Workers_Count) Scaling_Workers_Count = Workers_Count;
+		WorkerSetWorkersCount(&Benchmark_Worker_Pool, Scaling_Workers_Count); // The count only grows, so this can't fail
+	}
+	
+	// Compare all threads counts to the single thread one
+	if (Is_Scaling_Mode_Enabled)
+	{
+		if (Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON) printf("{\"maximum_threads\":%d,\"repetitions\":%d,\"warm_up_repetitions\":%d,\"algorithm\":\"%s\",\"most_constrained_cell_heuristic\":%s,\"propagation_level\":%d,\"affinity\":\"%s\",\"dispatch\":%s,\"grids\":%u,\"scaling\":[", Workers_Count, Repetitions_Count, Warm_Up_Repetitions_Count, Benchmark_Algorithm == WORKER_ALGORITHM_DANCING_LINKS ? "dancing_links" : "backtrack",
+			Is_Most_Constrained_Cell_Heuristic_Enabled ? "true" : "false", Propagation_Level, String_Benchmark_Affinity_Policy == NULL ? "none" : String_Benchmark_Affinity_Policy, Is_Dispatch_Mode_Enabled ? "true" : "false", Benchmark_Grids_Count);
+		else printf("threads,solvings,failures,total_ns,grids_per_second,speedup,efficiency,idle_fraction\n");
+		for (i = 0; i < (int) Benchmark_Scaling_Steps_Count; i++)
+		{
+			if ((Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON) && (i > 0)) putchar(',');
+			BenchmarkPrintScalingStep(&Benchmark_Scaling_Steps[i], &Benchmark_Scaling_Steps[0], Output_Format);
+		}
+		if (Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON) printf("]}\n");
+		return EXIT_SUCCESS;
+	}
+	
+	// Gather all measures to compute the whole corpus statistics
+	memset(&All_Grids_Class, 0, sizeof(All_Grids_Class));
+	for (Size = 0; Size <= CONFIGURATION_GRID_MAXIMUM_SIZE; Size++)
+	{
+		All_Grids_Class.Grids_Count += Benchmark_Size_Classes[Size].Grids_Count;
+		All_Grids_Class.Failures_Count += Benchmark_Size_Classes[Size].Failures_Count;
+		for (i = 0; i < (int) Benchmark_Size_Classes[Size].Latencies_Count; i++)
+		{
+			if (BenchmarkAddLatency(&All_Grids_Class, Benchmark_Size_Classes[Size].Pointer_Latencies[i]) != 0)
+			{
+				fprintf(stderr, "Error : not enough memory to store the measures.\n");
+				return EXIT_FAILURE;
+			}
+		}
+		qsort(Benchmark_Size_Classes[Size].Pointer_Latencies, Benchmark_Size_Classes[Size].Latencies_Count, sizeof(unsigned long long), BenchmarkCompareLatencies);
+	}
+	qsort(All_Grids_Class.Pointer_Latencies, All_Grids_Class.Latencies_Count, sizeof(unsigned long long), BenchmarkCompareLatencies);
+	
+	// Print the results
+	if (Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON) printf("{\"threads\":%d,\"repetitions\":%d,\"warm_up_repetitions\":%d,\"algorithm\":\"%s\",\"most_constrained_cell_heuristic\":%s,\"propagation_level\":%d,\"affinity\":\"%s\",\"dispatch\":%s,\"size_classes\":[", Workers_Count, Repetitions_Count, Warm_Up_Repetitions_Count, Benchmark_Algorithm == WORKER_ALGORITHM_DANCING_LINKS ? "dancing_links" : "backtrack",
+		Is_Most_Constrained_Cell_Heuristic_Enabled ? "true" : "false", Propagation_Level, String_Benchmark_Affinity_Policy == NULL ? "none" : String_Benchmark_Affinity_Policy, Is_Dispatch_Mode_Enabled ? "true" : "false");
+	else printf("size,grids,solvings,failures,grids_per_second,mean_ns,p50_ns,p90_ns,p99_ns,max_ns\n");
+	for (Size = 0; Size <= CONFIGURATION_GRID_MAXIMUM_SIZE; Size++)
+	{
+		if (Benchmark_Size_Classes[Size].Latencies_Count == 0) continue;
+		
+		if ((Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON) && !Is_First_Size_Class) putchar(',');
+		Is_First_Size_Class = 0;
+		sprintf(String_Size, "%ux%u", Size, Size);
+		BenchmarkPrintSizeClass(&Benchmark_Size_Classes[Size], String_Size, Output_Format);
+	}
+	if (Output_Format == BENCHMARK_OUTPUT_FORMAT_JSON)
+	{
+		printf("],\"all\":");
+		BenchmarkPrintSizeClass(&All_Grids_Class, "all", Output_Format);
+		printf("}\n");
+	}
+	else BenchmarkPrintSizeClass(&All_Grids_Class, "all", Output_Format);
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+/** @file Affinity.h
+ * Choose on which logical processors the worker threads run. The processors topology (packages, last level caches, physical cores and their SMT threads) is read from sysfs, so the workers can be kept on the same cores, spread over all cores, or given an explicit processors list.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_AFFINITY_H
+#define H_AFFINITY_H
+
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest logical processors count that can be described. */
+#define AFFINITY_PROCESSORS_MAXIMUM_COUNT 1024
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** Where a logical processor is located. */
+typedef struct
+{
+	int Processor_ID; //!< The logical processor number used by the operating system.
+	int Package_ID; //!< The physical processor the logical processor belongs to.
+	int Cache_ID; //!< The last level cache shared by the logical processor (on AMD processors, each CCX has its own L3 cache). It is the package ID if the cache topology is unknown.
+	int Core_ID; //!< The physical core the logical processor belongs to, unique inside a package.
+	int Thread_Index; //!< The logical processor rank among the SMT threads of its physical core, 0 for the first thread.
+} TAffinityProcessor;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Choose a logical processor for each worker. Only the processors the program is allowed to run on are used. When there are more workers than usable processors, the placement starts again from the first processor.
+ * @param String_Policy "compact" fills all SMT threads of a core, then the next cores of the same last level cache, then the next caches and packages, so the workers share as much cache as possible. "scatter" uses a single thread of each core first, spreading the workers over all packages first, then over the last level caches of each package, then uses the remaining SMT threads the same way. "cores" is like "scatter" but never uses the second thread of a core. Any other value is a comma-separated processors list, ranges being allowed (for instance "0,2,4-7"), the workers being given the processors in list order.
+ * @param Workers_Count How many workers must be placed.
+ * @param Placement On output, contain the processor of each worker. The array must have at least Workers_Count elements.
+ * @return 0 on success,
+ * @return -1 if the policy is unknown or if the processors list is bad,
+ * @return -2 if the processors topology can't be read, if a listed processor can't be used or if the policy leaves no usable processor.
+ * @note This function prints an error message if an error occurs.
+ */
+int AffinityComputePlacement(char *String_Policy, int Workers_Count, TAffinityProcessor Placement[]);
+
+/** Print where each worker runs.
+ * @param Pointer_File Where to print the placement.
+ * @param String_Policy The policy used to compute the placement.
+ * @param Workers_Count How many workers have been placed.
+ * @param Placement The processor of each worker.
+ */
+void AffinityShowPlacement(FILE *Pointer_File, char *String_Policy, int Workers_Count, TAffinityProcessor Placement[]);
+
+#endif
@@ -0,0 +1,83 @@
+/** @file Candidates_Board.h
+ * Compute the allowed numbers of all grid cells at once using SIMD instructions. Each grid row is stored in a vector register as 16 lanes of 16-bit candidates masks, so the row, column and square eliminations of a whole row are done with a few vector operations. The naked and hidden singles of the whole board are then found with vector operations too, and the board is updated in place when the singles are filled. Only 9x9 and 16x16 grids are handled, and only on processors supporting AVX2 (this is detected at runtime), the other cases must use the scalar grid functions.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_CANDIDATES_BOARD_H
+#define H_CANDIDATES_BOARD_H
+
+#include <Grid.h>
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** How many cells a vector register holds (this is a whole grid row). */
+#define CANDIDATES_BOARD_LANES_COUNT 16
+
+/** The most singles CandidatesBoardFindSingles() can report (a cell is reported only once). */
+#define CANDIDATES_BOARD_SINGLES_MAXIMUM_COUNT (CANDIDATES_BOARD_LANES_COUNT * CANDIDATES_BOARD_LANES_COUNT)
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A cell whose value has been deduced. */
+typedef struct
+{
+	uint8_t Row; //!< The cell row coordinate.
+	uint8_t Column; //!< The cell column coordinate.
+	uint8_t Number; //!< The only number the cell can contain.
+} TCandidatesBoardSingle;
+
+/** The allowed numbers of all grid cells. The board is computed once from the grid, then kept up to date while cells are filled, so looking for the singles again does not recompute it. */
+typedef struct
+{
+	uint16_t Candidates[CANDIDATES_BOARD_LANES_COUNT][CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32))); //!< The allowed numbers of each cell, indexed by row then lane. The filled cells and the lanes holding no cell have no allowed number.
+	const uint8_t *Pointer_Lanes_Columns; //!< The column of the cell held by each lane.
+	uint8_t Columns_Lanes[CANDIDATES_BOARD_LANES_COUNT]; //!< The lane holding each column.
+	unsigned int Grid_Size; //!< The grid side size in cells.
+	unsigned int Square_Size; //!< The side size of a square in cells.
+} TCandidatesBoard;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Tell whether the SIMD kernel can be used for the specified grid size on this processor.
+ * @param Grid_Size The grid side size in cells.
+ * @return 0 if the scalar grid functions must be used,
+ * @return 1 if the other functions of this module can be called.
+ */
+int CandidatesBoardIsAvailable(unsigned int Grid_Size);
+
+/** Count the allowed numbers of all grid cells.
+ * @param Pointer_Grid The concerned grid.
+ * @param Candidates_Counts On output, contain the allowed numbers count of each cell (indexed by row then column). The counts of the filled cells are meaningless.
+ * @warning Make sure CandidatesBoardIsAvailable() returned 1 for the grid size before calling this function.
+ */
+void CandidatesBoardCountCandidates(TGrid *Pointer_Grid, uint16_t Candidates_Counts[CANDIDATES_BOARD_LANES_COUNT][CANDIDATES_BOARD_LANES_COUNT]);
+
+/** Compute the allowed numbers of all grid cells.
+ * @param Pointer_Board On output, contain the board of the grid.
+ * @param Pointer_Grid The concerned grid, its bitmasks must match its cell values.
+ * @warning Make sure CandidatesBoardIsAvailable() returned 1 for the grid size before calling this function.
+ */
+void CandidatesBoardInitialize(TCandidatesBoard *Pointer_Board, TGrid *Pointer_Grid);
+
+/** Update the board after a grid cell has been filled : the cell has no allowed number anymore, and the number is removed from the cells sharing a row, a column or a square with the cell.
+ * @param Pointer_Board The board to update.
+ * @param Row The filled cell row coordinate.
+ * @param Column The filled cell column coordinate.
+ * @param Number The number put in the cell.
+ */
+void CandidatesBoardFillCell(TCandidatesBoard *Pointer_Board, unsigned int Row, unsigned int Column, unsigned int Number);
+
+/** Check all grid cells and units, and find the cells whose value can be deduced.
+ * @param Pointer_Board The board of the grid, it must be up to date with the grid cell values.
+ * @param Pointer_Grid The concerned grid, its bitmasks must match its cell values.
+ * @param Propagation_Level GRID_PROPAGATION_LEVEL_FORWARD_CHECKING only looks for the empty cells having no allowed number, GRID_PROPAGATION_LEVEL_NAKED_SINGLES also reports the cells having a single allowed number, GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES also reports the only cell of a row, a column or a square allowing a number and fails if a number missing from a unit can't be placed anywhere in the unit.
+ * @param Singles On output, contain the deduced cells, each cell being reported once. The deductions are made from the grid as it was when the function was called, so filling a single can make a following single of the list impossible, which means that the grid is wrong.
+ * @return -1 if the grid is wrong,
+ * @return The amount of deduced cells (0 if nothing could be deduced).
+ */
+int CandidatesBoardFindSingles(TCandidatesBoard *Pointer_Board, TGrid *Pointer_Grid, TGridPropagationLevel Propagation_Level, TCandidatesBoardSingle Singles[CANDIDATES_BOARD_SINGLES_MAXIMUM_COUNT]);
+
+#endif
@@ -6,6 +6,7 @@
 #define H_CELLS_STACK_H
 
 #include <Configuration.h>
+#include <stdint.h>
 
 //-------------------------------------------------------------------------------------------------
 // Constants
@@ -16,18 +17,18 @@
 //-------------------------------------------------------------------------------------------------
 // Types
 //-------------------------------------------------------------------------------------------------
-/** A cell coordinates. */
+/** A cell coordinates, packed in two bytes so the stacks stay small enough to be quickly copied. */
 typedef struct
 {
-	int Row; //!< The cell row coordinate.
-	int Column; //!< The cell column coordinate.
+	uint8_t Row; //!< The cell row coordinate.
+	uint8_t Column; //!< The cell column coordinate.
 } TCellsStackCellCoordinates;
 
 /** A cell stack, made of a stack pointer and coordinates array. */
 typedef struct
 {
+	int Stack_Index; //!< The stack top. This is a fully ascending stack. It is located before the stack content, so copying the used part of a stack is a single contiguous copy.
 	TCellsStackCellCoordinates Cells_Coordinates[CELLS_STACK_ELEMENTS_COUNT]; //!< The stack content.
-	int Stack_Index; //!< The stack top. This is a fully ascending stack.
 } TCellsStack;
 
 //-------------------------------------------------------------------------------------------------
@@ -61,4 +62,13 @@ int CellsStackReadTop(TCellsStack *Pointer_Stack, int *Pointer_Cell_Row, int *Po
  */
 void CellsStackRemoveTop(TCellsStack *Pointer_Stack);
 
+/** Remove a cell located anywhere in the stack. The removed cell is replaced by the stack top, so the order of the remaining cells is not kept.
+ * @param Pointer_Stack The stack to remove the cell from.
+ * @param Cell_Row The cell row coordinate.
+ * @param Cell_Column The cell column coordinate.
+ * @return 1 if the cell was found and removed,
+ * @return 0 if the cell is not in the stack.
+ */
+int CellsStackRemoveCell(TCellsStack *Pointer_Stack, int Cell_Row, int Cell_Column);
+
 #endif
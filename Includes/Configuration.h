@@ -8,10 +8,18 @@
 //-------------------------------------------------------------------------------------------------
 // Constants and macros
 //-------------------------------------------------------------------------------------------------
-/** Width and height of a grid in cells (a grid is made of CONFIGURATION_GRID_MAXIMUM_SIZE x CONFIGURATION_GRID_MAXIMUM_SIZE cells). */
-#define CONFIGURATION_GRID_MAXIMUM_SIZE 16
+/** Width and height of the biggest grid in cells (a grid is made of CONFIGURATION_GRID_MAXIMUM_SIZE x CONFIGURATION_GRID_MAXIMUM_SIZE cells). The grid bitmasks use the smallest integer type holding this amount of numbers, so the default value keeps the 9x9 and 16x16 grids as compact as possible. Build with "make GRID_MAXIMUM_SIZE=64" to also solve the 25x25 to 64x64 grids. The maximum value is 64. */
+#ifndef CONFIGURATION_GRID_MAXIMUM_SIZE
+	#define CONFIGURATION_GRID_MAXIMUM_SIZE 16
+#endif
+
+/** The size in bytes of a processor cache line, the data written by different threads are kept in different cache lines to avoid slowing down the threads. */
+#define CONFIGURATION_CACHE_LINE_SIZE 64
 
 /** The maximum amount of threads that are allowed to run simultaneously. */
 #define CONFIGURATION_WORKERS_MAXIMUM_COUNT 1024
 
+/** Set to 1 to use the SIMD instructions of the processor (when they are available at runtime) to speed up some grid operations, set to 0 to always use the scalar code. */
+#define CONFIGURATION_IS_SIMD_ENABLED 1
+
 #endif
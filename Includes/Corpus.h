@@ -0,0 +1,74 @@
+/** @file Corpus.h
+ * Read big grid collections having a grid per line, in the common one-line format (see GridLoadFromCorpusRecord()). The file is memory-mapped, so the grids are parsed straight from the page cache without being copied to a line buffer first. When the file is opened, it is split into chunks whose records are counted by several threads at the same time, which also brings the whole file into memory at the full memory bandwidth before the first grid is solved. The chunks start on a record, so each chunk can then be read by its own thread.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_CORPUS_H
+#define H_CORPUS_H
+
+#include <Grid.h>
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A part of a grid collection, made of whole records. */
+typedef struct
+{
+	size_t Starting_Offset; //!< The first byte of the chunk first record.
+	size_t Ending_Offset; //!< The byte following the chunk last record, which is the next chunk starting offset.
+	size_t Read_Offset; //!< Where the next record of the chunk is looked for.
+	unsigned long long Records_Count; //!< How many records the chunk contains.
+} TCorpusChunk;
+
+/** A memory-mapped grid collection and its reading positions. */
+typedef struct
+{
+	const char *Pointer_Data; //!< The file content, or NULL if the file is empty.
+	size_t Size; //!< The file size in bytes.
+	TCorpusChunk *Pointer_Chunks; //!< The file chunks, in the file order.
+	int Chunks_Count; //!< How many chunks the file has been split into (0 for an empty file).
+	int Read_Chunk_Index; //!< The chunk CorpusReadGrid() is reading.
+	unsigned long long Records_Count; //!< How many records the file contains, the empty lines not being records. This tells how many grids remain to be read.
+} TCorpus;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Map a grid collection file, split it into chunks and count their records.
+ * @param Pointer_Corpus The corpus to open.
+ * @param String_File_Name The file name.
+ * @param Threads_Count How many threads can count the records, which is also the biggest chunks count. The small files are made of a single chunk counted by the calling thread.
+ * @return 0 on success,
+ * @return -1 if the file can't be opened or mapped,
+ * @return -2 if the counting threads can't be created.
+ * @note This function prints an error message if an error occurs.
+ */
+int CorpusOpen(TCorpus *Pointer_Corpus, char *String_File_Name, int Threads_Count);
+
+/** Load the next record of a corpus. The empty lines are skipped, and a bad record is skipped too so the next grids can be read.
+ * @param Pointer_Corpus The corpus.
+ * @param Pointer_Grid On output, contain the record cell values. Call GridUpdateFromCellValues() to prepare the grid to be solved.
+ * @return 1 if a grid was loaded,
+ * @return 0 if all records have been read,
+ * @return -2 if the record cells count does not match a supported grid size,
+ * @return -3 if the record contains a bad character.
+ */
+int CorpusReadGrid(TCorpus *Pointer_Corpus, TGrid *Pointer_Grid);
+
+/** Load the next record of a chunk, like CorpusReadGrid() but without leaving the chunk. The chunks are independent, so several threads can read different chunks of the same corpus at the same time.
+ * @param Pointer_Corpus The corpus.
+ * @param Chunk_Index The chunk to read, in range [0; Chunks_Count - 1].
+ * @param Pointer_Grid On output, contain the record cell values. Call GridUpdateFromCellValues() to prepare the grid to be solved.
+ * @return 1 if a grid was loaded,
+ * @return 0 if all chunk records have been read,
+ * @return -2 if the record cells count does not match a supported grid size,
+ * @return -3 if the record contains a bad character.
+ */
+int CorpusReadChunkGrid(TCorpus *Pointer_Corpus, int Chunk_Index, TGrid *Pointer_Grid);
+
+/** Unmap a corpus file and release its chunks.
+ * @param Pointer_Corpus The corpus to close.
+ */
+void CorpusClose(TCorpus *Pointer_Corpus);
+
+#endif
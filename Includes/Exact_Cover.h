@@ -0,0 +1,115 @@
+/** @file Exact_Cover.h
+ * Solve grids as an exact cover problem with the dancing links (Donald Knuth's Algorithm X). Each candidate (a number in an empty cell) is a matrix row satisfying four constraints (the matrix columns) : the cell is filled, and the number is present in the cell row, column and square. Choosing the column having the fewest rows first prunes the search tree much more than filling the cells in order.
+ * The matrix nodes are stored in a single array and linked by their indexes. The four nodes of a candidate are consecutive, so walking a row needs no link and a node is much smaller than a classic dancing links one.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_EXACT_COVER_H
+#define H_EXACT_COVER_H
+
+#include <Grid.h>
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A matrix node. The column headers are the first nodes of the matrix, the candidates nodes follow. */
+typedef struct
+{
+	int32_t Up; //!< The previous node of the same column (or the column header).
+	int32_t Down; //!< The next node of the same column (or the column header).
+	int32_t Column; //!< The column the node belongs to.
+} TExactCoverNode;
+
+/** A matrix column header, the columns that are not covered yet are linked together. */
+typedef struct
+{
+	int32_t Left; //!< The previous uncovered column.
+	int32_t Right; //!< The next uncovered column.
+	int32_t Size; //!< How many rows remain in the column.
+} TExactCoverColumn;
+
+/** The cell and the number of a matrix row. */
+typedef struct
+{
+	uint8_t Row; //!< The cell row coordinate.
+	uint8_t Column; //!< The cell column coordinate.
+	uint8_t Number; //!< The number put in the cell.
+} TExactCoverCandidate;
+
+/** A node of the search tree, covering a column and trying its rows one after the other. */
+typedef struct
+{
+	int Column; //!< The covered column.
+	int32_t *Pointer_Rows; //!< A node of each column row, taken when the search node was entered.
+	int Rows_Count; //!< How many rows can be tried. The rows given to other workers are removed from the end of the rows list.
+	int Tried_Rows_Count; //!< How many rows have been tried, the last tried one is the row currently explored.
+} TExactCoverSearchNode;
+
+/** An exact cover matrix and its search state. All arrays are allocated when the first matrix is built, and grown only when a bigger grid is loaded, so solving many grids does not allocate memory. */
+typedef struct
+{
+	TExactCoverNode *Pointer_Nodes; //!< All matrix nodes, the column headers first.
+	TExactCoverColumn *Pointer_Columns; //!< All column headers, the last one is the root of the uncovered columns list.
+	TExactCoverCandidate *Pointer_Candidates; //!< The cell and the number of each row.
+	TExactCoverSearchNode *Pointer_Search_Nodes; //!< The nodes of the search tree branch currently explored, indexed by depth.
+	int32_t *Pointer_Search_Rows; //!< The rows lists of the search nodes.
+	int Nodes_Capacity; //!< How many nodes can be stored.
+	int Columns_Capacity; //!< How many column headers can be stored.
+	int Candidates_Capacity; //!< How many rows can be stored.
+	int Search_Nodes_Capacity; //!< How many search nodes can be stored.
+	int Search_Rows_Capacity; //!< How many rows the search nodes lists can store.
+	int Columns_Count; //!< How many columns the current matrix has, not counting the root.
+	int First_Row_Node; //!< The index of the first row node, it is a multiple of 4 so the first node of a row is found by clearing the two lowest index bits.
+	int Grid_Size; //!< The size of the grid the matrix was built from.
+} TExactCoverMatrix;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Create the matrix of a grid. The filled cells are not part of the matrix, and only the numbers allowed in each empty cell become rows, so the matrix is as small as possible.
+ * @param Pointer_Matrix The matrix to build. It must have been zeroed before its first use.
+ * @param Pointer_Grid The grid to solve, its bitmasks and empty cells stack must match its cell values.
+ * @return 0 on success,
+ * @return -1 if there is not enough memory.
+ */
+int ExactCoverBuildMatrix(TExactCoverMatrix *Pointer_Matrix, TGrid *Pointer_Grid);
+
+/** Release the memory of a matrix. It can be built again afterwards.
+ * @param Pointer_Matrix The matrix to release.
+ */
+void ExactCoverReleaseMatrix(TExactCoverMatrix *Pointer_Matrix);
+
+/** Start exploring a search tree node : the uncovered column having the fewest rows is chosen, its rows are recorded in the search node, then the column is covered.
+ * @param Pointer_Matrix The matrix.
+ * @param Depth The depth of the node, the search nodes of the shallower depths must have a tried row.
+ * @return 0 if all columns are covered (the tried rows of the shallower nodes are a solution),
+ * @return 1 if a column has been chosen (the node has no row if this column can't be covered anymore).
+ */
+int ExactCoverEnterNode(TExactCoverMatrix *Pointer_Matrix, int Depth);
+
+/** Terminate the exploration of a search tree node, uncovering its column.
+ * @param Pointer_Matrix The matrix.
+ * @param Depth The depth of the node.
+ */
+void ExactCoverLeaveNode(TExactCoverMatrix *Pointer_Matrix, int Depth);
+
+/** Put a row in the solution, covering the columns of its other nodes.
+ * @param Pointer_Matrix The matrix.
+ * @param Row_Node A node of the row, belonging to the column covered by the current search node.
+ */
+void ExactCoverSelectRow(TExactCoverMatrix *Pointer_Matrix, int Row_Node);
+
+/** Remove a row from the solution, undoing ExactCoverSelectRow().
+ * @param Pointer_Matrix The matrix.
+ * @param Row_Node The node given to ExactCoverSelectRow().
+ */
+void ExactCoverDeselectRow(TExactCoverMatrix *Pointer_Matrix, int Row_Node);
+
+/** Put the number of a row in its grid cell.
+ * @param Pointer_Matrix The matrix.
+ * @param Row_Node A node of the row.
+ * @param Pointer_Grid The grid to fill. Call GridUpdateFromCellValues() once all cells are set.
+ */
+void ExactCoverSetCellValue(TExactCoverMatrix *Pointer_Matrix, int Row_Node, TGrid *Pointer_Grid);
+
+#endif
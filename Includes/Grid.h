@@ -7,41 +7,183 @@
 
 #include <Cells_Stack.h>
 #include <Configuration.h>
+#include <stdint.h>
 
 //-------------------------------------------------------------------------------------------------
 // Constants
 //-------------------------------------------------------------------------------------------------
-/** Specific value telling that the cell is empty (must be a value that can't be present in a grid to solve). */
-#define GRID_EMPTY_CELL_VALUE 1000
+/** Specific value telling that the cell is empty (must be a value that can't be present in a grid to solve and that fits in a cell). */
+#define GRID_EMPTY_CELL_VALUE 0xFF
+
+/** The bitmask having only the bit of the specified number set.
+ * @param Number The number.
+ * @return The bitmask.
+ */
+#define GRID_BITMASK_NUMBER(Number) ((TGridBitmask) 1 << (Number))
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+	/** Count the numbers of a bitmask. */
+	#define GRID_BITMASK_COUNT_NUMBERS(Bitmask) __builtin_popcount(Bitmask)
+	/** Get the smallest number of a bitmask (the bitmask must not be empty). */
+	#define GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask) __builtin_ctz(Bitmask)
+	/** Get the biggest number of a bitmask (the bitmask must not be empty). */
+	#define GRID_BITMASK_GET_BIGGEST_NUMBER(Bitmask) (31 - __builtin_clz(Bitmask))
+#else
+	/** Count the numbers of a bitmask. */
+	#define GRID_BITMASK_COUNT_NUMBERS(Bitmask) __builtin_popcountll(Bitmask)
+	/** Get the smallest number of a bitmask (the bitmask must not be empty). */
+	#define GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask) __builtin_ctzll(Bitmask)
+	/** Get the biggest number of a bitmask (the bitmask must not be empty). */
+	#define GRID_BITMASK_GET_BIGGEST_NUMBER(Bitmask) (63 - __builtin_clzll(Bitmask))
+#endif
+
+/** Access the bitmask telling which numbers can be placed in a row of a grid, the grid size being provided by the caller (when it is a compile-time constant, all offsets are computed at compile time).
+ * @param Pointer_Grid The grid.
+ * @param Size The grid size.
+ * @param Row The row index.
+ * @return The bitmask (it can be assigned).
+ */
+#define GRID_SIZED_ROW_BITMASK(Pointer_Grid, Size, Row) ((Pointer_Grid)->Packed_Content[Row])
+/** Access the bitmask telling which numbers can be placed in a column of a grid, the grid size being provided by the caller.
+ * @param Pointer_Grid The grid.
+ * @param Size The grid size.
+ * @param Column The column index.
+ * @return The bitmask (it can be assigned).
+ */
+#define GRID_SIZED_COLUMN_BITMASK(Pointer_Grid, Size, Column) ((Pointer_Grid)->Packed_Content[(Size) + (Column)])
+/** Access the bitmask telling which numbers can be placed in a square of a grid, the grid size being provided by the caller.
+ * @param Pointer_Grid The grid.
+ * @param Size The grid size.
+ * @param Square The square index.
+ * @return The bitmask (it can be assigned).
+ */
+#define GRID_SIZED_SQUARE_BITMASK(Pointer_Grid, Size, Square) ((Pointer_Grid)->Packed_Content[2 * (Size) + (Square)])
+/** Access a cell of a grid, the grid size being provided by the caller.
+ * @param Pointer_Grid The grid.
+ * @param Size The grid size.
+ * @param Row The cell row coordinate.
+ * @param Column The cell column coordinate.
+ * @return The cell content (it can be assigned).
+ */
+#define GRID_SIZED_CELL(Pointer_Grid, Size, Row, Column) (((uint8_t *) &(Pointer_Grid)->Packed_Content[3 * (Size)])[(Row) * (Size) + (Column)])
+/** Get the empty cells stack of a grid, which follows the cells, the grid size being provided by the caller. The stack top is the last empty cell.
+ * @param Pointer_Grid The grid.
+ * @param Size The grid size.
+ * @return The address of the stack first element.
+ */
+#define GRID_SIZED_GET_EMPTY_CELLS(Pointer_Grid, Size) ((TCellsStackCellCoordinates *) &GRID_SIZED_CELL(Pointer_Grid, Size, Size, 0))
+/** Get the index of the square in which a cell is located, the grid dimensions being provided by the caller.
+ * @param Size The grid size.
+ * @param Square_Width The horizontal size of a square in cells.
+ * @param Square_Height The vertical size of a square in cells.
+ * @param Row The cell row coordinate.
+ * @param Column The cell column coordinate.
+ * @return The square index (see GRID_SIZED_SQUARE_BITMASK()).
+ */
+#define GRID_SIZED_GET_CELL_SQUARE_INDEX(Size, Square_Width, Square_Height, Row, Column) ((Row) / (Square_Height) * ((Size) / (Square_Width)) + (Column) / (Square_Width))
+
+/** Access the bitmask telling which numbers can be placed in a row of a grid.
+ * @param Pointer_Grid The grid.
+ * @param Row The row index.
+ * @return The bitmask (it can be assigned).
+ */
+#define GRID_ROW_BITMASK(Pointer_Grid, Row) GRID_SIZED_ROW_BITMASK(Pointer_Grid, (Pointer_Grid)->Grid_Size, Row)
+/** Access the bitmask telling which numbers can be placed in a column of a grid.
+ * @param Pointer_Grid The grid.
+ * @param Column The column index.
+ * @return The bitmask (it can be assigned).
+ */
+#define GRID_COLUMN_BITMASK(Pointer_Grid, Column) GRID_SIZED_COLUMN_BITMASK(Pointer_Grid, (Pointer_Grid)->Grid_Size, Column)
+/** Access the bitmask telling which numbers can be placed in a square of a grid.
+ * @param Pointer_Grid The grid.
+ * @param Square The square index.
+ * @return The bitmask (it can be assigned).
+ */
+#define GRID_SQUARE_BITMASK(Pointer_Grid, Square) GRID_SIZED_SQUARE_BITMASK(Pointer_Grid, (Pointer_Grid)->Grid_Size, Square)
+/** Access a cell of a grid.
+ * @param Pointer_Grid The grid.
+ * @param Row The cell row coordinate.
+ * @param Column The cell column coordinate.
+ * @return The cell content (it can be assigned).
+ */
+#define GRID_CELL(Pointer_Grid, Row, Column) GRID_SIZED_CELL(Pointer_Grid, (Pointer_Grid)->Grid_Size, Row, Column)
+/** Get the empty cells stack of a grid, which follows the cells. The stack top is the last empty cell.
+ * @param Pointer_Grid The grid.
+ * @return The address of the stack first element.
+ */
+#define GRID_GET_EMPTY_CELLS(Pointer_Grid) GRID_SIZED_GET_EMPTY_CELLS(Pointer_Grid, (Pointer_Grid)->Grid_Size)
+
+/** The longest string GridConvertToString() can produce, without the terminating zero (the grids bigger than 16x16 use 2-digit numbers separated by spaces). */
+#define GRID_STRING_MAXIMUM_LENGTH (CONFIGURATION_GRID_MAXIMUM_SIZE <= 16 ? CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE : CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE * 3)
 
 //-------------------------------------------------------------------------------------------------
 // Types
 //-------------------------------------------------------------------------------------------------
-/** Contain all needed information to run the backtrack algorithm. */
+/** How much deduction is done after a cell has been filled. Each level includes the previous ones. */
+typedef enum
+{
+	GRID_PROPAGATION_LEVEL_NONE, //!< No deduction is done, a dead cell is discovered only when the backtrack algorithm reaches it.
+	GRID_PROPAGATION_LEVEL_FORWARD_CHECKING, //!< Fail as soon as an empty cell sharing a row, a column or a square with the filled cell has no allowed number left.
+	GRID_PROPAGATION_LEVEL_NAKED_SINGLES, //!< Also fill the cells having a single allowed number, and propagate these new values.
+	GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES //!< Also fill the cells that are the only place of a number in a row, a column or a square, and fail if a missing number has no place left.
+} TGridPropagationLevel;
+
+/** A set of numbers, a set bit telling that the number corresponding to the bit index is in the set. The smallest type holding all numbers of the biggest allowed grid is used, so the small grids do not pay for the big ones when they are not needed. */
+#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 16
+	typedef uint16_t TGridBitmask;
+#elif CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+	typedef uint32_t TGridBitmask;
+#elif CONFIGURATION_GRID_MAXIMUM_SIZE <= 64
+	typedef uint64_t TGridBitmask;
+#else
+	#error "CONFIGURATION_GRID_MAXIMUM_SIZE can't be greater than 64."
+#endif
+
+/** Grid size dependent data (dimensions, precomputed tables and functions specialized for this size). The content is private to the grid module. */
+typedef struct TGridGeometry TGridGeometry;
+
+/** Contain all needed information to run the backtrack algorithm. All grid data are packed for the grid size at the structure end, so the used part of a grid is a single small block that GridCopy() copies at once, whatever the biggest supported grid is. */
 typedef struct
 {
-	int Cells[CONFIGURATION_GRID_MAXIMUM_SIZE][CONFIGURATION_GRID_MAXIMUM_SIZE]; //!< Cells content.
-	unsigned int Grid_Size; //!< Grid size (height and width) in cells. It is not supposed to change during program execution but it is made available for functions that do not have access to grid module private variables.
-	unsigned int Allowed_Numbers_Bitmask_Rows[CONFIGURATION_GRID_MAXIMUM_SIZE]; //!< Tell which numbers can be placed in each row (a bit is set when the number is allowed).
-	unsigned int Allowed_Numbers_Bitmask_Columns[CONFIGURATION_GRID_MAXIMUM_SIZE]; //!< Tell which numbers can be placed in each column (a bit is set when the number is allowed).
-	unsigned int Allowed_Numbers_Bitmask_Squares[CONFIGURATION_GRID_MAXIMUM_SIZE]; //!< Tell which numbers can be placed in each square (a bit is set when the number is allowed).
-	TCellsStack Empty_Cells_Stack; //!< Contain all grid empty cells to avoid loosing time searching for them.
+	const TGridGeometry *Pointer_Geometry; //!< The data and functions matching the grid size, they are chosen when the grid is loaded.
+	unsigned int Grid_Size; //!< Grid size (height and width) in cells. It is made available for functions that do not have access to the grid geometry.
+	int Empty_Cells_Count; //!< How many cells are in the empty cells stack (see GRID_GET_EMPTY_CELLS()), this is the stack top index.
+	TGridBitmask Packed_Content[3 * CONFIGURATION_GRID_MAXIMUM_SIZE + (CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE * (1 + sizeof(TCellsStackCellCoordinates)) + sizeof(TGridBitmask) - 1) / sizeof(TGridBitmask)]; //!< The bitmasks telling which numbers can be placed in each row, then in each column and in each square (see GRID_ROW_BITMASK() and its siblings), followed by the cells content, a row after the other with the grid size as row stride (see GRID_CELL()), and by the empty cells stack, which contains all grid empty cells to avoid loosing time searching for them. Each part is as long as the grid size needs.
 } TGrid;
 
 //-------------------------------------------------------------------------------------------------
 // Functions
 //-------------------------------------------------------------------------------------------------
-/** Load the grid content from a file.
+/** Load the grid content from a file. Each grid row is a line. A line is made of one character per cell ('0' to '9' then 'A' to 'F', '.' for an empty cell) or, if it contains spaces or tabulations, of decimal numbers separated by blanks ('.' for an empty cell). The second format is needed for the grids bigger than 16x16. Only the cell values are loaded, call GridUpdateFromCellValues() to prepare the grid to be solved.
  * @param Pointer_Grid In which grid to put the read content.
  * @param String_File_Name Name of the file describing the grid.
  * @return 0 if the grid was correctly loaded,
  * @return -1 if the file was not found,
- * @return -2 if the grid size is not 6, 9, 12 or 16,
+ * @return -2 if the grid size is not supported (6, 9, 12, 16, 25, 36, 49 or 64, up to CONFIGURATION_GRID_MAXIMUM_SIZE),
  * @return -3 if cells data are bad.
  */
 int GridLoadFromFile(TGrid *Pointer_Grid, char *String_File_Name);
 
-/** Copy a grid cell values and internal bitmasks to another grid.
+/** Load the grid content from a single line string, all rows being concatenated (this is the batch mode format). Only the cell values are loaded, call GridUpdateFromCellValues() to prepare the grid to be solved.
+ * @param Pointer_Grid In which grid to put the read content.
+ * @param String_Grid The grid characters, using the same formats than grid files (the numbers format is detected when the string contains a space or a tabulation). Trailing new line characters are ignored.
+ * @return 0 if the grid was correctly loaded,
+ * @return -2 if the grid size is not supported (6, 9, 12, 16, 25, 36, 49 or 64, up to CONFIGURATION_GRID_MAXIMUM_SIZE),
+ * @return -3 if cells data are bad.
+ */
+int GridLoadFromString(TGrid *Pointer_Grid, char *String_Grid);
+
+/** Load the grid content from a corpus record, using the common one-line format of the big grid collections : all rows are concatenated, the numbers start from 1 ('1' to '9' then 'A' to 'Z', whatever the case) and '0' or '.' is an empty cell. Only the cell values are loaded, call GridUpdateFromCellValues() to prepare the grid to be solved.
+ * @param Pointer_Grid In which grid to put the read content.
+ * @param Pointer_Record The record characters. The record does not need to be terminated, so it can be read straight from a memory-mapped file.
+ * @param Length The record characters count, without the new line characters.
+ * @return 0 if the grid was correctly loaded,
+ * @return -2 if the grid size is not supported (6, 9, 12, 16 or 25, up to CONFIGURATION_GRID_MAXIMUM_SIZE, as the bigger grids can't have a character per cell),
+ * @return -3 if cells data are bad.
+ */
+int GridLoadFromCorpusRecord(TGrid *Pointer_Grid, const char *Pointer_Record, unsigned int Length);
+
+/** Copy a grid cell values and internal bitmasks to another grid. The grid is copied with a single copy stopping at the used part of the empty cells stack and nothing is recomputed, so the source grid bitmasks and empty cells stack must match its cell values (use GridUpdateFromCellValues() after having modified cells with GridSetCellValue()).
  * @param Pointer_Grid_Source The grid to copy from.
  * @param Pointer_Grid_Destination The grid to copy to.
  */
@@ -52,19 +194,40 @@ void GridCopy(TGrid *Pointer_Grid_Source, TGrid *Pointer_Grid_Destination);
  */
 void GridShow(TGrid *Pointer_Grid);
 
+/** Convert the grid to a single line string, all rows being concatenated (this is the batch mode format).
+ * @param Pointer_Grid The grid to convert.
+ * @param Pointer_Output_String On output, contain the grid characters (the grids bigger than 16x16 use the numbers format). Make sure string has at least GRID_STRING_MAXIMUM_LENGTH + 1 bytes room.
+ */
+void GridConvertToString(TGrid *Pointer_Grid, char *Pointer_Output_String);
+
+/** Convert the grid to a corpus record, see GridLoadFromCorpusRecord() for the format ('.' is used for the empty cells).
+ * @param Pointer_Grid The grid to convert, its size must be supported by the corpus format.
+ * @param Pointer_Output_String On output, contain the grid characters. Make sure string has at least GRID_STRING_MAXIMUM_LENGTH + 1 bytes room.
+ */
+void GridConvertToCorpusString(TGrid *Pointer_Grid, char *Pointer_Output_String);
+
 /** Retrieve the allowed numbers for a cell.
  * @param Pointer_Grid The concerned grid.
  * @param Cell_Row Row coordinate.
  * @param Cell_Column Column coordinate.
  * @return A bitmask containing all allowed numbers.
  */
-unsigned int GridGetCellMissingNumbers(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column);
+TGridBitmask GridGetCellMissingNumbers(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column);
+
+/** Tell which square contains a cell. The squares are numbered from the grid top-left corner to the grid bottom-right corner, row of squares after row of squares.
+ * @param Pointer_Grid The concerned grid.
+ * @param Cell_Row Row coordinate.
+ * @param Cell_Column Column coordinate.
+ * @return The square index, in range [0; grid size - 1].
+ */
+unsigned int GridGetCellSquareIndex(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column);
 
 /** Display a human-readable list of the missing numbers in the provided mask.
+ * @param Pointer_Grid The grid the mask belongs to.
  * @param Bitmask_Missing_Numbers A mask of the missing numbers, each set bit tells that the number corresponding to the bit index is missing.
  * @note This is a debug function.
  */
-void GridShowMissingNumbers(unsigned int Bitmask_Missing_Numbers);
+void GridShowMissingNumbers(TGrid *Pointer_Grid, TGridBitmask Bitmask_Missing_Numbers);
 
 /** Set the value of a cell.
  * @param Pointer_Grid The grid to set cell value.
@@ -91,6 +254,43 @@ void GridRemoveCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, uns
  */
 void GridRestoreCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number);
 
+/** Find the empty cell having the fewest allowed numbers and move it to the top of the empty cells stack, so it is the next cell filled by the backtrack algorithm. Exploring the most constrained cells first greatly reduces the search tree size.
+ * @param Pointer_Grid The concerned grid.
+ * @note Only the stack order is modified, so restoring a cell by pushing it back to the stack stays valid.
+ */
+void GridMoveMostConstrainedCellToStackTop(TGrid *Pointer_Grid);
+
+/** Deduce the consequences of a cell that has just been filled (its value must have been set and removed from the missing numbers). All cells filled by the deduction are pushed to a dedicated stack, so they can be restored with GridRestoreForcedCells() when the backtrack algorithm goes back.
+ * @param Pointer_Grid The concerned grid.
+ * @param Cell_Row Row coordinate of the filled cell.
+ * @param Cell_Column Column coordinate of the filled cell.
+ * @param Propagation_Level What kind of deduction to do.
+ * @param Pointer_Forced_Cells_Stack On output, contain the cells filled by the deduction (on top of the previous stack content). The cells are also removed from the grid empty cells stack.
+ * @return 0 if the grid can't be solved anymore,
+ * @return 1 if no contradiction was found.
+ */
+int GridPropagateConstraints(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, TGridPropagationLevel Propagation_Level, TCellsStack *Pointer_Forced_Cells_Stack);
+
+/** Tell how GridPropagateConstraints() makes its deductions for this grid. The SIMD candidates board finds the hidden singles of all rows, columns and squares, while the scalar code only checks the units of the filled cells, so the explored nodes count depends on the path.
+ * @param Pointer_Grid The concerned grid.
+ * @param Propagation_Level The deduction level.
+ * @return 0 if the scalar code is used,
+ * @return 1 if the SIMD candidates board is used.
+ */
+int GridIsCandidatesBoardUsed(TGrid *Pointer_Grid, TGridPropagationLevel Propagation_Level);
+
+/** Empty all cells filled by GridPropagateConstraints() since the forced cells stack had the specified size.
+ * @param Pointer_Grid The concerned grid.
+ * @param Pointer_Forced_Cells_Stack The stack filled by GridPropagateConstraints().
+ * @param Stack_Index The forced cells stack index to go back to.
+ */
+void GridRestoreForcedCells(TGrid *Pointer_Grid, TCellsStack *Pointer_Forced_Cells_Stack, int Stack_Index);
+
+/** Recreate the bitmasks and the empty cells stack from the cell values. Call this function after having loaded a grid or after having directly modified cell values with GridSetCellValue() to create a new grid to solve.
+ * @param Pointer_Grid The grid to update.
+ */
+void GridUpdateFromCellValues(TGrid *Pointer_Grid);
+
 /** Tell if the grid is correctly filled (i.e. all cells are filled and no value is at a wrong position).
  * @param Pointer_Grid The grid to check.
  * @return 0 if the grid is erroneously filled,
@@ -99,9 +299,10 @@ void GridRestoreCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, un
 int GridIsCorrectlyFilled(TGrid *Pointer_Grid);
 
 /** Convert a bitmask to a displayable binary representation.
+ * @param Pointer_Grid The grid the bitmask belongs to.
  * @param Bitmask The bitmask to visualize.
  * @param Pointer_Output_String On output, contain the binary string. Make sure string has enough at least twice grid size room.
  */
-void GridConvertBitmaskToString(unsigned int Bitmask, char *Pointer_Output_String);
+void GridConvertBitmaskToString(TGrid *Pointer_Grid, TGridBitmask Bitmask, char *Pointer_Output_String);
 
 #endif
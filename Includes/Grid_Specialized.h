@@ -0,0 +1,448 @@
+/** @file Grid_Specialized.h
+ * Grid functions run for each search tree node, written for a single grid size. Grid.c includes this file once per supported grid size, so all grid dimensions are compile-time constants : divisions become multiplications and loops can be unrolled.
+ * Define the following macros before including this file (they are undefined at the end of the file) :
+ *   - GRID_SPECIALIZED_SIZE : the grid side size in cells,
+ *   - GRID_SPECIALIZED_SQUARE_WIDTH : the horizontal size of a square in cells,
+ *   - GRID_SPECIALIZED_SQUARE_HEIGHT : the vertical size of a square in cells,
+ *   - GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER : the number added to all cell values when the grid is displayed,
+ *   - GRID_SPECIALIZED_SUFFIX : the suffix appended to all generated names (like _9x9).
+ * @note There is no include guard as this file is included several times on purpose. It must only be included by Grid.c.
+ * @author Adrien RICCIARDI
+ */
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** Append the suffix to a name (the indirection is needed to expand the suffix macro). */
+#define GRID_SPECIALIZED_CONCATENATE_EXPANDED(Name, Suffix) Name##Suffix
+/** Append the suffix to a name. */
+#define GRID_SPECIALIZED_CONCATENATE(Name, Suffix) GRID_SPECIALIZED_CONCATENATE_EXPANDED(Name, Suffix)
+/** Give the name of a function or variable generated for this grid size. */
+#define GRID_SPECIALIZED_NAME(Name) GRID_SPECIALIZED_CONCATENATE(Name, GRID_SPECIALIZED_SUFFIX)
+
+/** The data of this grid size. */
+#define GRID_SPECIALIZED_GEOMETRY GRID_SPECIALIZED_NAME(Grid_Geometry)
+
+/** How many squares are in a row of squares. */
+#define GRID_SPECIALIZED_SQUARES_HORIZONTAL_COUNT (GRID_SPECIALIZED_SIZE / GRID_SPECIALIZED_SQUARE_WIDTH)
+
+/** How many cells share a row, a column or a square with a cell (the cell itself is not counted). */
+#define GRID_SPECIALIZED_PEERS_COUNT (2 * (GRID_SPECIALIZED_SIZE - 1) + (GRID_SPECIALIZED_SQUARE_WIDTH - 1) * (GRID_SPECIALIZED_SQUARE_HEIGHT - 1))
+
+/** A bitmask with all the grid numbers set. */
+#define GRID_SPECIALIZED_ALL_NUMBERS_BITMASK ((TGridBitmask) -1 >> (sizeof(TGridBitmask) * 8 - GRID_SPECIALIZED_SIZE))
+
+/** Get the square index (in the Bitmask_Squares array) in which the cell is located.
+ * @param Row Cell row coordinate.
+ * @param Column Cell column coordinate.
+ * @return The square index in the Bitmask_Squares array.
+ */
+#define GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Row, Column) (GRID_SPECIALIZED_GEOMETRY.Cell_Square_Indexes[Row][Column])
+
+/** Access to the allowed numbers bitmask of a row of a grid of this size, the grid content offsets being compile-time constants. */
+#define GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Row) GRID_SIZED_ROW_BITMASK(Pointer_Grid, GRID_SPECIALIZED_SIZE, Row)
+/** Access to the allowed numbers bitmask of a column of a grid of this size. */
+#define GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Column) GRID_SIZED_COLUMN_BITMASK(Pointer_Grid, GRID_SPECIALIZED_SIZE, Column)
+/** Access to the allowed numbers bitmask of a square of a grid of this size. */
+#define GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, Square) GRID_SIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_SIZE, Square)
+/** Access to a cell of a grid of this size, the row stride being a compile-time constant. */
+#define GRID_SPECIALIZED_CELL(Pointer_Grid, Row, Column) GRID_SIZED_CELL(Pointer_Grid, GRID_SPECIALIZED_SIZE, Row, Column)
+/** Get the empty cells stack of a grid of this size. */
+#define GRID_SPECIALIZED_GET_EMPTY_CELLS(Pointer_Grid) GRID_SIZED_GET_EMPTY_CELLS(Pointer_Grid, GRID_SPECIALIZED_SIZE)
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** All data of this grid size, filled the first time a grid of this size is loaded. */
+static TGridGeometry GRID_SPECIALIZED_GEOMETRY;
+/** The cells sharing a row, a column or a square with each cell. The table is sized for this grid size only, so the small grids do not pay for the biggest supported one. */
+static TGridPeerCoordinates GRID_SPECIALIZED_NAME(Grid_Peers)[GRID_SPECIALIZED_SIZE][GRID_SPECIALIZED_SIZE][GRID_SPECIALIZED_PEERS_COUNT];
+/** Make sure the data are filled only once, even when several threads load their first grid of this size at the same time. */
+static pthread_once_t GRID_SPECIALIZED_NAME(Grid_Geometry_Once_Control) = PTHREAD_ONCE_INIT;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** See GridGenerateInitialBitmasks() for description. */
+static void GRID_SPECIALIZED_NAME(GridGenerateInitialBitmasks)(TGrid *Pointer_Grid)
+{
+	unsigned int Row, Column;
+	int Number;
+	TGridBitmask Bitmask_Number;
+	
+	// All numbers are allowed in an empty grid (there are as many squares as rows)
+	for (Row = 0; Row < GRID_SPECIALIZED_SIZE; Row++)
+	{
+		GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Row) = GRID_SPECIALIZED_ALL_NUMBERS_BITMASK;
+		GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Row) = GRID_SPECIALIZED_ALL_NUMBERS_BITMASK;
+		GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, Row) = GRID_SPECIALIZED_ALL_NUMBERS_BITMASK;
+	}
+	
+	// Forbid the numbers already present in each row, column and square
+	for (Row = 0; Row < GRID_SPECIALIZED_SIZE; Row++)
+	{
+		for (Column = 0; Column < GRID_SPECIALIZED_SIZE; Column++)
+		{
+			Number = GRID_SPECIALIZED_CELL(Pointer_Grid, Row, Column);
+			if (Number == GRID_EMPTY_CELL_VALUE) continue;
+			
+			Bitmask_Number = GRID_BITMASK_NUMBER(Number);
+			GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Row) &= ~Bitmask_Number;
+			GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Column) &= ~Bitmask_Number;
+			GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Row, Column)) &= ~Bitmask_Number;
+		}
+	}
+}
+
+/** Remove a cell from the grid empty cells stack, the stack top taking its place.
+ * @param Pointer_Grid The concerned grid.
+ * @param Cell_Row Row coordinate of the cell.
+ * @param Cell_Column Column coordinate of the cell.
+ */
+static inline void GRID_SPECIALIZED_NAME(GridRemoveEmptyCell)(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column)
+{
+	int i;
+	TCellsStackCellCoordinates *Pointer_Cells_Coordinates;
+	
+	Pointer_Cells_Coordinates = GRID_SPECIALIZED_GET_EMPTY_CELLS(Pointer_Grid);
+	
+	// Start searching from the top as recently pushed cells are more likely to be removed
+	for (i = Pointer_Grid->Empty_Cells_Count - 1; i >= 0; i--)
+	{
+		if ((Pointer_Cells_Coordinates[i].Row == Cell_Row) && (Pointer_Cells_Coordinates[i].Column == Cell_Column))
+		{
+			Pointer_Grid->Empty_Cells_Count--;
+			Pointer_Cells_Coordinates[i] = Pointer_Cells_Coordinates[Pointer_Grid->Empty_Cells_Count];
+			return;
+		}
+	}
+}
+
+/** Fill a cell whose value has been deduced by the constraint propagation.
+ * @param Pointer_Grid The concerned grid.
+ * @param Cell_Row Row coordinate of the cell.
+ * @param Cell_Column Column coordinate of the cell.
+ * @param Number The cell value.
+ * @param Pointer_Forced_Cells_Stack The stack recording all deduced cells.
+ */
+static inline void GRID_SPECIALIZED_NAME(GridForceCellValue)(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number, TCellsStack *Pointer_Forced_Cells_Stack)
+{
+	TGridBitmask Bitmask_Number;
+	
+	GRID_SPECIALIZED_CELL(Pointer_Grid, Cell_Row, Cell_Column) = Number;
+	
+	// Remove the number from the cell units
+	Bitmask_Number = ~GRID_BITMASK_NUMBER(Number);
+	GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Cell_Row) &= Bitmask_Number;
+	GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Cell_Column) &= Bitmask_Number;
+	GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column)) &= Bitmask_Number;
+	
+	GRID_SPECIALIZED_NAME(GridRemoveEmptyCell)(Pointer_Grid, Cell_Row, Cell_Column);
+	CellsStackPush(Pointer_Forced_Cells_Stack, Cell_Row, Cell_Column);
+}
+
+/** Make sure a cell sharing a unit with a filled cell still has allowed numbers, and fill it if it has only one allowed number (depending on the propagation level).
+ * @param Pointer_Grid The concerned grid.
+ * @param Cell_Row Row coordinate of the cell.
+ * @param Cell_Column Column coordinate of the cell.
+ * @param Propagation_Level What kind of deduction to do.
+ * @param Pointer_Forced_Cells_Stack The stack recording all deduced cells.
+ * @return 0 if the cell is empty and has no allowed number,
+ * @return 1 if the cell is filled or has at least one allowed number.
+ */
+static inline int GRID_SPECIALIZED_NAME(GridCheckPeerCell)(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, TGridPropagationLevel Propagation_Level, TCellsStack *Pointer_Forced_Cells_Stack)
+{
+	TGridBitmask Bitmask_Missing_Numbers;
+	
+	if (GRID_SPECIALIZED_CELL(Pointer_Grid, Cell_Row, Cell_Column) != GRID_EMPTY_CELL_VALUE) return 1;
+	
+	Bitmask_Missing_Numbers = GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Cell_Row) & GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Cell_Column) & GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column));
+	if (Bitmask_Missing_Numbers == 0) return 0;
+	
+	// Is this a naked single (only one bit is set) ?
+	if ((Propagation_Level >= GRID_PROPAGATION_LEVEL_NAKED_SINGLES) && ((Bitmask_Missing_Numbers & (Bitmask_Missing_Numbers - 1)) == 0)) GRID_SPECIALIZED_NAME(GridForceCellValue)(Pointer_Grid, Cell_Row, Cell_Column, GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask_Missing_Numbers), Pointer_Forced_Cells_Stack);
+	return 1;
+}
+
+/** Fill the hidden singles of a unit (a row, a column or a square), which are the numbers that can be placed in only one cell of the unit.
+ * @param Pointer_Grid The concerned grid.
+ * @param Row_Start The unit first row.
+ * @param Row_End The row following the unit last row.
+ * @param Column_Start The unit first column.
+ * @param Column_End The column following the unit last column.
+ * @param Pointer_Forced_Cells_Stack The stack recording all deduced cells.
+ * @return 0 if a number missing from the unit can't be placed anywhere in the unit,
+ * @return 1 if no contradiction was found.
+ */
+static inline int GRID_SPECIALIZED_NAME(GridFillUnitHiddenSingles)(TGrid *Pointer_Grid, unsigned int Row_Start, unsigned int Row_End, unsigned int Column_Start, unsigned int Column_End, TCellsStack *Pointer_Forced_Cells_Stack)
+{
+	unsigned int Row, Column, Number;
+	int Value, Is_Cell_Found;
+	TGridBitmask Bitmask_Missing_Numbers, Bitmask_Seen_Once = 0, Bitmask_Seen_Twice = 0, Bitmask_Placed_Numbers = 0, Bitmask_Hidden_Singles;
+	
+	// Find how many cells allow each number
+	for (Row = Row_Start; Row < Row_End; Row++)
+	{
+		for (Column = Column_Start; Column < Column_End; Column++)
+		{
+			Value = GRID_SPECIALIZED_CELL(Pointer_Grid, Row, Column);
+			if (Value != GRID_EMPTY_CELL_VALUE)
+			{
+				Bitmask_Placed_Numbers |= GRID_BITMASK_NUMBER(Value);
+				continue;
+			}
+			
+			Bitmask_Missing_Numbers = GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Row) & GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Column) & GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Row, Column));
+			Bitmask_Seen_Twice |= Bitmask_Seen_Once & Bitmask_Missing_Numbers;
+			Bitmask_Seen_Once |= Bitmask_Missing_Numbers;
+		}
+	}
+	
+	// A number that is not placed yet must be allowed somewhere
+	if (~(Bitmask_Placed_Numbers | Bitmask_Seen_Once) & GRID_SPECIALIZED_ALL_NUMBERS_BITMASK) return 0;
+	
+	// Fill the only cell allowing each hidden single
+	Bitmask_Hidden_Singles = Bitmask_Seen_Once & ~Bitmask_Seen_Twice;
+	while (Bitmask_Hidden_Singles != 0)
+	{
+		Number = GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask_Hidden_Singles);
+		Bitmask_Hidden_Singles &= Bitmask_Hidden_Singles - 1;
+		
+		// Find the cell allowing the number
+		Is_Cell_Found = 0;
+		for (Row = Row_Start; (Row < Row_End) && !Is_Cell_Found; Row++)
+		{
+			for (Column = Column_Start; (Column < Column_End) && !Is_Cell_Found; Column++)
+			{
+				if (GRID_SPECIALIZED_CELL(Pointer_Grid, Row, Column) != GRID_EMPTY_CELL_VALUE) continue;
+				
+				Bitmask_Missing_Numbers = GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Row) & GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Column) & GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Row, Column));
+				if (Bitmask_Missing_Numbers & GRID_BITMASK_NUMBER(Number))
+				{
+					GRID_SPECIALIZED_NAME(GridForceCellValue)(Pointer_Grid, Row, Column, Number, Pointer_Forced_Cells_Stack);
+					Is_Cell_Found = 1;
+				}
+			}
+		}
+		
+		// The cell can't be found if it has already been filled with another hidden single, so the grid is wrong
+		if (!Is_Cell_Found) return 0;
+	}
+	
+	return 1;
+}
+
+/** See GridMoveMostConstrainedCellToStackTop() for description. */
+static void GRID_SPECIALIZED_NAME(GridMoveMostConstrainedCellToStackTop)(TGrid *Pointer_Grid)
+{
+	TCellsStackCellCoordinates *Pointer_Cells_Coordinates, Temporary_Coordinates;
+	int i, Top_Index, Best_Index, Is_Candidates_Board_Computed = 0;
+	unsigned int Row, Column, Candidates_Count, Best_Candidates_Count = GRID_SPECIALIZED_SIZE + 1;
+	uint16_t Candidates_Counts[CANDIDATES_BOARD_LANES_COUNT][CANDIDATES_BOARD_LANES_COUNT];
+	
+	// Nothing to choose if there is less than two empty cells
+	Top_Index = Pointer_Grid->Empty_Cells_Count - 1;
+	if (Top_Index <= 0) return;
+	Pointer_Cells_Coordinates = GRID_SPECIALIZED_GET_EMPTY_CELLS(Pointer_Grid);
+	Best_Index = Top_Index;
+	
+	// Look for the empty cell having the fewest allowed numbers, starting from the stack top so the default cells order is kept when several cells have the same count
+	for (i = Top_Index; i >= 0; i--)
+	{
+		Row = Pointer_Cells_Coordinates[i].Row;
+		Column = Pointer_Cells_Coordinates[i].Column;
+		
+		// A cell with a single allowed number is usually found near the stack top, so the vector instructions are worth it only when more than a row worth of cells must be scanned
+		if (GRID_SPECIALIZED_GEOMETRY.Is_Candidates_Board_Used && (Top_Index - i >= GRID_SPECIALIZED_SIZE))
+		{
+			if (!Is_Candidates_Board_Computed)
+			{
+				CandidatesBoardCountCandidates(Pointer_Grid, Candidates_Counts);
+				Is_Candidates_Board_Computed = 1;
+			}
+			Candidates_Count = Candidates_Counts[Row][Column];
+		}
+		else Candidates_Count = GRID_BITMASK_COUNT_NUMBERS(GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Row) & GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Column) & GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Row, Column)));
+		
+		if (Candidates_Count < Best_Candidates_Count)
+		{
+			Best_Candidates_Count = Candidates_Count;
+			Best_Index = i;
+			
+			// No cell can be more constrained than a cell with a single (or no) allowed number
+			if (Candidates_Count <= 1) break;
+		}
+	}
+	
+	// Exchange the stack top with the chosen cell
+	if (Best_Index != Top_Index)
+	{
+		Temporary_Coordinates = Pointer_Cells_Coordinates[Top_Index];
+		Pointer_Cells_Coordinates[Top_Index] = Pointer_Cells_Coordinates[Best_Index];
+		Pointer_Cells_Coordinates[Best_Index] = Temporary_Coordinates;
+	}
+}
+
+/** Propagate the constraints with the SIMD kernel. The whole board is checked at once, so the filled cell coordinates are not needed, and all singles found by a pass are filled before looking for the singles they created. The board is computed once, then each filled single only updates its peers.
+ * @param Pointer_Grid The concerned grid.
+ * @param Propagation_Level What kind of deduction to do.
+ * @param Pointer_Forced_Cells_Stack The stack recording all deduced cells.
+ * @return 0 if the grid can't be solved anymore,
+ * @return 1 if no contradiction was found.
+ */
+static int GRID_SPECIALIZED_NAME(GridPropagateConstraintsOnBoard)(TGrid *Pointer_Grid, TGridPropagationLevel Propagation_Level, TCellsStack *Pointer_Forced_Cells_Stack)
+{
+	TCandidatesBoard Board;
+	TCandidatesBoardSingle Singles[CANDIDATES_BOARD_SINGLES_MAXIMUM_COUNT];
+	int Singles_Count, i;
+	unsigned int Row, Column, Number;
+	
+	CandidatesBoardInitialize(&Board, Pointer_Grid);
+	while (1)
+	{
+		Singles_Count = CandidatesBoardFindSingles(&Board, Pointer_Grid, Propagation_Level, Singles);
+		if (Singles_Count < 0) return 0;
+		if (Singles_Count == 0) return 1;
+		
+		for (i = 0; i < Singles_Count; i++)
+		{
+			Row = Singles[i].Row;
+			Column = Singles[i].Column;
+			Number = Singles[i].Number;
+			
+			// A previous single of the same pass took the only number of this cell, so the grid is wrong
+			if (!(GRID_SPECIALIZED_ROW_BITMASK(Pointer_Grid, Row) & GRID_SPECIALIZED_COLUMN_BITMASK(Pointer_Grid, Column) & GRID_SPECIALIZED_SQUARE_BITMASK(Pointer_Grid, GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX(Row, Column)) & GRID_BITMASK_NUMBER(Number))) return 0;
+			GRID_SPECIALIZED_NAME(GridForceCellValue)(Pointer_Grid, Row, Column, Number, Pointer_Forced_Cells_Stack);
+			CandidatesBoardFillCell(&Board, Row, Column, Number);
+		}
+	}
+}
+
+/** See GridPropagateConstraints() for description. */
+static int GRID_SPECIALIZED_NAME(GridPropagateConstraints)(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, TGridPropagationLevel Propagation_Level, TCellsStack *Pointer_Forced_Cells_Stack)
+{
+	int Forced_Cells_Index;
+	unsigned int i, Row_Start, Column_Start;
+	const TGridPeerCoordinates *Pointer_Peers;
+	
+	// Checking the whole board costs more than checking the filled cell peers, but it finds the hidden singles of all units instead of the filled cells units only, which prunes much more
+	if (GRID_SPECIALIZED_GEOMETRY.Is_Candidates_Board_Used && (Propagation_Level >= GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES)) return GRID_SPECIALIZED_NAME(GridPropagateConstraintsOnBoard)(Pointer_Grid, Propagation_Level, Pointer_Forced_Cells_Stack);
+	
+	// The forced cells stack is also used as a queue of the filled cells whose consequences must be checked
+	Forced_Cells_Index = Pointer_Forced_Cells_Stack->Stack_Index;
+	
+	while (1)
+	{
+		// Check the cells sharing the filled cell row, column or square
+		Pointer_Peers = GRID_SPECIALIZED_NAME(Grid_Peers)[Cell_Row][Cell_Column];
+		for (i = 0; i < GRID_SPECIALIZED_PEERS_COUNT; i++)
+		{
+			if (!GRID_SPECIALIZED_NAME(GridCheckPeerCell)(Pointer_Grid, Pointer_Peers[i].Row, Pointer_Peers[i].Column, Propagation_Level, Pointer_Forced_Cells_Stack)) return 0;
+		}
+		
+		// Look for the numbers that have a single place left in the units of the filled cell
+		if (Propagation_Level >= GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES)
+		{
+			Row_Start = (Cell_Row / GRID_SPECIALIZED_SQUARE_HEIGHT) * GRID_SPECIALIZED_SQUARE_HEIGHT;
+			Column_Start = (Cell_Column / GRID_SPECIALIZED_SQUARE_WIDTH) * GRID_SPECIALIZED_SQUARE_WIDTH;
+			if (!GRID_SPECIALIZED_NAME(GridFillUnitHiddenSingles)(Pointer_Grid, Cell_Row, Cell_Row + 1, 0, GRID_SPECIALIZED_SIZE, Pointer_Forced_Cells_Stack)) return 0;
+			if (!GRID_SPECIALIZED_NAME(GridFillUnitHiddenSingles)(Pointer_Grid, 0, GRID_SPECIALIZED_SIZE, Cell_Column, Cell_Column + 1, Pointer_Forced_Cells_Stack)) return 0;
+			if (!GRID_SPECIALIZED_NAME(GridFillUnitHiddenSingles)(Pointer_Grid, Row_Start, Row_Start + GRID_SPECIALIZED_SQUARE_HEIGHT, Column_Start, Column_Start + GRID_SPECIALIZED_SQUARE_WIDTH, Pointer_Forced_Cells_Stack)) return 0;
+		}
+		
+		// Check the consequences of the next forced cell
+		if (Forced_Cells_Index >= Pointer_Forced_Cells_Stack->Stack_Index) return 1;
+		Cell_Row = Pointer_Forced_Cells_Stack->Cells_Coordinates[Forced_Cells_Index].Row;
+		Cell_Column = Pointer_Forced_Cells_Stack->Cells_Coordinates[Forced_Cells_Index].Column;
+		Forced_Cells_Index++;
+	}
+}
+
+/** Compute the data of this grid size. */
+static void GRID_SPECIALIZED_NAME(GridInitializeGeometry)(void)
+{
+	TGridGeometry *Pointer_Geometry = &GRID_SPECIALIZED_GEOMETRY;
+	TGridPeerCoordinates *Pointer_Peers;
+	unsigned int Row, Column, Square_Row, Square_Column, Peers_Count, i;
+	
+	Pointer_Geometry->Square_Width = GRID_SPECIALIZED_SQUARE_WIDTH;
+	Pointer_Geometry->Square_Height = GRID_SPECIALIZED_SQUARE_HEIGHT;
+	Pointer_Geometry->Squares_Horizontal_Count = GRID_SPECIALIZED_SQUARES_HORIZONTAL_COUNT;
+	Pointer_Geometry->Display_Starting_Number = GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER;
+	Pointer_Geometry->Is_Candidates_Board_Used = CandidatesBoardIsAvailable(GRID_SPECIALIZED_SIZE);
+	
+	for (Row = 0; Row < GRID_SPECIALIZED_SIZE; Row++)
+	{
+		for (Column = 0; Column < GRID_SPECIALIZED_SIZE; Column++)
+		{
+			// Find the square containing the cell
+			Square_Row = Row / GRID_SPECIALIZED_SQUARE_HEIGHT;
+			Square_Column = Column / GRID_SPECIALIZED_SQUARE_WIDTH;
+			Pointer_Geometry->Cell_Square_Indexes[Row][Column] = Square_Row * GRID_SPECIALIZED_SQUARES_HORIZONTAL_COUNT + Square_Column;
+			
+			// List the cells of the cell row and column (in the order the constraint propagation used to check them), then the remaining cells of the cell square
+			Pointer_Peers = GRID_SPECIALIZED_NAME(Grid_Peers)[Row][Column];
+			Peers_Count = 0;
+			for (i = 0; i < GRID_SPECIALIZED_SIZE; i++)
+			{
+				if (i != Column)
+				{
+					Pointer_Peers[Peers_Count].Row = Row;
+					Pointer_Peers[Peers_Count].Column = i;
+					Peers_Count++;
+				}
+				if (i != Row)
+				{
+					Pointer_Peers[Peers_Count].Row = i;
+					Pointer_Peers[Peers_Count].Column = Column;
+					Peers_Count++;
+				}
+			}
+			for (Square_Row = Row - Row % GRID_SPECIALIZED_SQUARE_HEIGHT; Square_Row < Row - Row % GRID_SPECIALIZED_SQUARE_HEIGHT + GRID_SPECIALIZED_SQUARE_HEIGHT; Square_Row++)
+			{
+				for (Square_Column = Column - Column % GRID_SPECIALIZED_SQUARE_WIDTH; Square_Column < Column - Column % GRID_SPECIALIZED_SQUARE_WIDTH + GRID_SPECIALIZED_SQUARE_WIDTH; Square_Column++)
+				{
+					if ((Square_Row == Row) || (Square_Column == Column)) continue;
+					Pointer_Peers[Peers_Count].Row = Square_Row;
+					Pointer_Peers[Peers_Count].Column = Square_Column;
+					Peers_Count++;
+				}
+			}
+			assert(Peers_Count == GRID_SPECIALIZED_PEERS_COUNT);
+		}
+	}
+	
+	Pointer_Geometry->GenerateInitialBitmasks = GRID_SPECIALIZED_NAME(GridGenerateInitialBitmasks);
+	Pointer_Geometry->MoveMostConstrainedCellToStackTop = GRID_SPECIALIZED_NAME(GridMoveMostConstrainedCellToStackTop);
+	Pointer_Geometry->PropagateConstraints = GRID_SPECIALIZED_NAME(GridPropagateConstraints);
+	Pointer_Geometry->Size = GRID_SPECIALIZED_SIZE;
+}
+
+/** Compute the data of this grid size the first time it is needed. The data are never modified afterwards, so all grids of this size can share them without locking.
+ * @return The grid size data.
+ */
+static const TGridGeometry *GRID_SPECIALIZED_NAME(GridGetGeometry)(void)
+{
+	pthread_once(&GRID_SPECIALIZED_NAME(Grid_Geometry_Once_Control), GRID_SPECIALIZED_NAME(GridInitializeGeometry));
+	return &GRID_SPECIALIZED_GEOMETRY;
+}
+
+// Allow the file to be included again for another grid size
+#undef GRID_SPECIALIZED_CONCATENATE_EXPANDED
+#undef GRID_SPECIALIZED_CONCATENATE
+#undef GRID_SPECIALIZED_NAME
+#undef GRID_SPECIALIZED_GEOMETRY
+#undef GRID_SPECIALIZED_SQUARES_HORIZONTAL_COUNT
+#undef GRID_SPECIALIZED_PEERS_COUNT
+#undef GRID_SPECIALIZED_ALL_NUMBERS_BITMASK
+#undef GRID_SPECIALIZED_GET_CELL_SQUARE_INDEX
+#undef GRID_SPECIALIZED_ROW_BITMASK
+#undef GRID_SPECIALIZED_COLUMN_BITMASK
+#undef GRID_SPECIALIZED_SQUARE_BITMASK
+#undef GRID_SPECIALIZED_CELL
+#undef GRID_SPECIALIZED_GET_EMPTY_CELLS
+#undef GRID_SPECIALIZED_SIZE
+#undef GRID_SPECIALIZED_SQUARE_WIDTH
+#undef GRID_SPECIALIZED_SQUARE_HEIGHT
+#undef GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER
+#undef GRID_SPECIALIZED_SUFFIX
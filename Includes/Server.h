@@ -0,0 +1,26 @@
+/** @file Server.h
+ * Serve solving requests over a UNIX domain socket, keeping the solvers and their worker threads ready between requests. The protocol is the batch mode one : a client sends a grid per line and receives a result line per grid, in the same order. A client can send several grids without waiting for their results, and the grids of different clients are solved at the same time when enough solvers are available.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_SERVER_H
+#define H_SERVER_H
+
+#include <Grid.h>
+#include <Worker.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Create the solvers, then serve the clients until the program is terminated.
+ * @param String_Socket_Path The file name of the socket to listen on. An existing file with this name is removed.
+ * @param Solvers_Count How many grids can be solved at the same time.
+ * @param Workers_Count How many threads each solver uses.
+ * @param Algorithm How the solvers search for the grid solutions.
+ * @param Cell_Selection_Heuristic How the solvers choose the next cell to fill.
+ * @param Propagation_Level How much deduction the solvers do each time they fill a cell.
+ * @param Maximum_Solutions_Count When not zero, count the solutions of each grid (up to this amount plus one) instead of solving it.
+ * @return -1 if the server could not be started (an error message is printed).
+ */
+int ServerRun(char *String_Socket_Path, int Solvers_Count, int Workers_Count, TWorkerAlgorithm Algorithm, TWorkerCellSelectionHeuristic Cell_Selection_Heuristic, TGridPropagationLevel Propagation_Level, unsigned long long Maximum_Solutions_Count);
+
+#endif
@@ -0,0 +1,102 @@
+/** @file Solver.h
+ * Solve grids from another program. A solver owns its worker threads and its grid, and nothing is shared between solvers except read-only grid size data, so several solvers can solve grids of different sizes at the same time in the same process without waiting for each other. A single solver must not be used by several threads at the same time.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_SOLVER_H
+#define H_SOLVER_H
+
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The longest grid string a solver can produce, without the terminating zero. */
+#define SOLVER_STRING_MAXIMUM_LENGTH GRID_STRING_MAXIMUM_LENGTH
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A solver context. The content is private to the solver module. */
+typedef struct TSolver TSolver;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Create a solver. Its first worker thread is started, the other ones are started when a grid needs them.
+ * @param Workers_Count How many threads solve each grid, in range [1; CONFIGURATION_WORKERS_MAXIMUM_COUNT].
+ * @return NULL if the solver could not be created,
+ * @return The solver on success.
+ */
+TSolver *SolverCreate(int Workers_Count);
+
+/** Stop the solver worker threads and release all the solver resources.
+ * @param Pointer_Solver The solver to destroy.
+ */
+void SolverDestroy(TSolver *Pointer_Solver);
+
+/** Choose how the solver searches for the grid solution (the default is the backtrack algorithm).
+ * @param Pointer_Solver The solver to configure.
+ * @param Is_Enabled Set to 1 to solve the grids as an exact cover problem with the dancing links algorithm (the cell selection heuristic and the propagation level are then not used), set to 0 to use the backtrack algorithm.
+ */
+void SolverSetDancingLinks(TSolver *Pointer_Solver, int Is_Enabled);
+
+/** Choose how the solver selects the next cell to fill (the default is to fill the cells in order).
+ * @param Pointer_Solver The solver to configure.
+ * @param Is_Enabled Set to 1 to fill the cells having the fewest allowed numbers first, set to 0 to fill the cells in order.
+ */
+void SolverSetMostConstrainedCellHeuristic(TSolver *Pointer_Solver, int Is_Enabled);
+
+/** Choose how much deduction the solver does each time it fills a cell (the default is no deduction).
+ * @param Pointer_Solver The solver to configure.
+ * @param Propagation_Level The constraint propagation level.
+ */
+void SolverSetPropagationLevel(TSolver *Pointer_Solver, TGridPropagationLevel Propagation_Level);
+
+/** Choose how long an idle worker thread is kept before exiting (the default is 1 second). The threads are created again when a grid needs them, so a long-lived solver only keeps the threads it uses.
+ * @param Pointer_Solver The solver to configure.
+ * @param Milliseconds The idle time after which a thread exits, 0 to keep the threads forever.
+ */
+void SolverSetIdleTimeout(TSolver *Pointer_Solver, unsigned int Milliseconds);
+
+/** Solve a grid.
+ * @param Pointer_Solver The solver to use.
+ * @param String_Grid The grid, using the batch mode format (all rows concatenated on a single line, see GridLoadFromString()).
+ * @param String_Solution On output, contain the solved grid in the batch mode format (the grids bigger than 16x16 use the numbers format). Make sure the string has at least SOLVER_STRING_MAXIMUM_LENGTH + 1 bytes room. It is left untouched if the grid has no solution.
+ * @return -2 if an error occurred while searching the grid (like a memory allocation failure), so it is unknown whether the grid has a solution,
+ * @return -1 if the grid is bad,
+ * @return 0 if the grid has no solution,
+ * @return 1 if the grid has been solved.
+ */
+int SolverSolve(TSolver *Pointer_Solver, char *String_Grid, char *String_Solution);
+
+/** Count the solutions of a grid.
+ * @param Pointer_Solver The solver to use.
+ * @param String_Grid The grid, using the batch mode format.
+ * @param Maximum_Solutions_Count Stop counting as soon as more than this amount of solutions have been found (use 1 to check that a grid has a single solution). It must not be 0.
+ * @param Pointer_Solutions_Count On output, contain the solutions count. When it is bigger than Maximum_Solutions_Count, the grid has more solutions than this value.
+ * @return -2 if an error occurred while searching the grid, so the solutions count is incomplete,
+ * @return -1 if the grid is bad,
+ * @return 0 if the solutions have been counted.
+ */
+int SolverCountSolutions(TSolver *Pointer_Solver, char *String_Grid, unsigned long long Maximum_Solutions_Count, unsigned long long *Pointer_Solutions_Count);
+
+/** Solve a grid that has already been loaded (for instance with GridLoadFromCorpusRecord()), which avoids converting it to a string first.
+ * @param Pointer_Solver The solver to use.
+ * @param Pointer_Grid The grid, only its cell values need to be loaded. On output, contain the solved grid if a solution has been found.
+ * @return -2 if an error occurred while searching the grid, so it is unknown whether the grid has a solution,
+ * @return 0 if the grid has no solution,
+ * @return 1 if the grid has been solved.
+ */
+int SolverSolveGrid(TSolver *Pointer_Solver, TGrid *Pointer_Grid);
+
+/** Count the solutions of a grid that has already been loaded.
+ * @param Pointer_Solver The solver to use.
+ * @param Pointer_Grid The grid, only its cell values need to be loaded.
+ * @param Maximum_Solutions_Count Stop counting as soon as more than this amount of solutions have been found. It must not be 0.
+ * @param Pointer_Solutions_Count On output, contain the solutions count. When it is bigger than Maximum_Solutions_Count, the grid has more solutions than this value.
+ * @return -2 if an error occurred while searching the grid, so the solutions count is incomplete,
+ * @return 0 if the solutions have been counted.
+ */
+int SolverCountGridSolutions(TSolver *Pointer_Solver, TGrid *Pointer_Grid, unsigned long long Maximum_Solutions_Count, unsigned long long *Pointer_Solutions_Count);
+
+#endif
@@ -0,0 +1,22 @@
+/** @file Timer.h
+ * Measure short durations with a nanosecond resolution.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_TIMER_H
+#define H_TIMER_H
+
+//-------------------------------------------------------------------------------------------------
+// Constants and macros
+//-------------------------------------------------------------------------------------------------
+/** Convert a duration in nanoseconds to milliseconds, keeping the fractional part so it can be displayed. */
+#define TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Nanoseconds) ((Nanoseconds) / 1000000.0)
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Read a monotonic clock, which is not modified when the system time is changed. Subtract two values to get a duration.
+ * @return The elapsed time in nanoseconds since an unspecified starting point.
+ */
+unsigned long long TimerGetNanoseconds(void);
+
+#endif
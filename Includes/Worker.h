@@ -1,53 +1,313 @@
 /** @file Worker.h
- * Control a pool of worker threads that can solve different grids in parallel.
+ * Control pools of worker threads, the workers of a pool solving a grid together. Each pool only uses its own data, so several pools can solve different grids at the same time.
  * @author Adrien RICCIARDI
  */
 #ifndef H_WORKER_H
 #define H_WORKER_H
 
+#include <Affinity.h>
+#include <Exact_Cover.h>
 #include <Grid.h>
 #include <pthread.h>
 
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The longest string WorkerConvertStrategyToString() can produce, without the terminating zero. */
+#define WORKER_STRATEGY_STRING_MAXIMUM_LENGTH 255
+
 //-------------------------------------------------------------------------------------------------
 // Types
 //-------------------------------------------------------------------------------------------------
+/** How the backtrack algorithm chooses the next cell to fill. */
+typedef enum
+{
+	WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL, //!< Fill the cells from the grid top-left corner to the grid bottom-right corner.
+	WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL //!< Fill the cell having the fewest allowed numbers first.
+} TWorkerCellSelectionHeuristic;
+
+/** How the workers search for the grid solution. */
+typedef enum
+{
+	WORKER_ALGORITHM_BACKTRACK, //!< Fill the empty cells one after the other, see TWorkerCellSelectionHeuristic and TGridPropagationLevel.
+	WORKER_ALGORITHM_DANCING_LINKS //!< Solve the grid as an exact cover problem, see Exact_Cover.h. The cell selection heuristic and the propagation level are not used.
+} TWorkerAlgorithm;
+
+/** When a randomized search abandons its current search tree to start again from the job grid with a new random order. Restarting cuts the very long runs caused by a bad choice near the search tree root. */
+typedef enum
+{
+	WORKER_RESTART_POLICY_NONE, //!< Never restart.
+	WORKER_RESTART_POLICY_LUBY, //!< The explored nodes budget of each run is the base budget multiplied by the Luby sequence terms (1, 1, 2, 1, 1, 2, 4, 1...), which is within a constant factor of the optimal policy when the runtime distribution is unknown.
+	WORKER_RESTART_POLICY_GEOMETRIC //!< The explored nodes budget is multiplied by the growth factor after each restart.
+} TWorkerRestartPolicy;
+
+/** How a worker searches for the solution of its job. */
+typedef struct
+{
+	TWorkerAlgorithm Algorithm; //!< The search algorithm.
+	TWorkerCellSelectionHeuristic Cell_Selection_Heuristic; //!< How the backtrack algorithm chooses the next cell to fill.
+	TGridPropagationLevel Propagation_Level; //!< How much deduction the backtrack algorithm does each time it fills a cell.
+	int Is_Numbers_Order_Reversed; //!< Set to 1 to try the biggest numbers of a cell first (the dancing links algorithm tries the rows of a column from the last one).
+	unsigned long long Random_Seed; //!< When not zero, the numbers are tried in a random order and the cells having the same allowed numbers count are chosen in a random order (the dancing links algorithm tries the rows of a column in a random order). Each worker derives its own random sequence from this seed and from its index.
+	TWorkerRestartPolicy Restart_Policy; //!< When the randomized search restarts, it never restarts when the seed is zero or when solutions are counted.
+	unsigned long long Restart_Nodes_Count; //!< The base explored nodes budget of a run.
+	double Restart_Growth_Factor; //!< How much the budget grows after each restart with the geometric policy.
+} TWorkerStrategy;
+
+/** A node of the backtrack search tree. The nodes of the explored branch form the trail used to undo the tried numbers, and their unexplored branches can be given to idle workers. */
+typedef struct
+{
+	int Row; //!< The row coordinate of the cell filled by this node.
+	int Column; //!< The column coordinate of the cell filled by this node.
+	unsigned int Tested_Number; //!< The number currently tried in the cell.
+	TGridBitmask Bitmask_Untried_Numbers; //!< The numbers that have not been tried yet nor given to another worker.
+	int Forced_Cells_Stack_Index; //!< The forced cells stack index when the node was reached, all cells above this index have been deduced from this node or from deeper nodes.
+	unsigned long long State_Hash; //!< The Zobrist hash of the grid when the node was reached, only computed when the refuted states table is used.
+	unsigned long long Explored_Nodes_Count; //!< The worker explored nodes count when the node was reached, telling the node subtree size when the node is left.
+	int Is_Subtree_Refuted; //!< Cleared when a part of the node subtree has been given to another worker or contains a counted solution, so the node state can't be recorded as refuted when all its numbers have been tried.
+} TWorkerSearchNode;
+
+/** What a worker has done since it was created. Each worker only writes its own statistics, and they fill whole cache lines so writing them does not slow down the other threads. */
+typedef struct
+{
+	unsigned long long Explored_Nodes_Count; //!< How many search tree nodes have been explored.
+	unsigned long long Backtracks_Count; //!< How many times the search went back to a parent node.
+	unsigned long long Dead_Ends_Count; //!< How many tried numbers led to a cell without allowed number (found when the next node is entered or by the constraint propagation).
+	unsigned long long Received_Jobs_Count; //!< How many grids or search tree branches the worker has been given.
+	unsigned long long Restarts_Count; //!< How many times the randomized search started again from the job grid.
+	unsigned long long Refuted_States_Hits_Count; //!< How many explored nodes were found in the refuted states table, their subtree being skipped.
+	unsigned long long Refuted_States_Misses_Count; //!< How many explored nodes were looked for in the refuted states table without being found.
+	unsigned long long Scalar_Propagations_Count; //!< How many constraint propagations only checked the units of the filled cell with the scalar code.
+	unsigned long long Board_Propagations_Count; //!< How many constraint propagations checked the whole grid with the SIMD candidates board, which deduces more cells than the scalar code.
+	unsigned long long Busy_Time; //!< The time in nanoseconds spent solving jobs.
+	unsigned long long Idle_Time; //!< The time in nanoseconds spent waiting for a job, up to the end of the wait or to the last statistics retrieval when the worker is still waiting. This is only accessed with atomic operations.
+} __attribute__((aligned(CONFIGURATION_CACHE_LINE_SIZE))) TWorkerStatistics;
+
+/** What an idle worker thread is doing. */
+typedef enum
+{
+	WORKER_JOB_STATE_WAITING, //!< The thread is waiting for a job without sleeping.
+	WORKER_JOB_STATE_SLEEPING, //!< The thread is sleeping in the kernel, it must be woken up when a job is given.
+	WORKER_JOB_STATE_GIVEN, //!< A job or an exit request has been given to the thread.
+	WORKER_JOB_STATE_STOPPED //!< The worker has no thread, because it has never been given a job or because its thread exited after being idle for too long. A thread is created when a job is given to the worker.
+} TWorkerJobState;
+
 /** A worker is a thread that tries to solve the grid provided to it. */
 typedef struct
 {
+	struct TWorkerPool *Pointer_Pool; //!< The pool the worker belongs to.
 	TGrid Grid; //!< The grid the worker must solve.
 	int Is_Grid_Solved; //!< Set to 1 when a grid solution has been found.
-	int Is_Waiting_Requested; //!< This is the wait condition boolean. Set to 0 to avoid entering the wait condition.
-	pthread_cond_t Wait_Condition; //!< Idle the worker thread until a job is received.
-	pthread_mutex_t Mutex_Wait_Condition; //!< The mutex granting atomic access to the wait condition.
+	int Job_State; //!< The worker thread waits on this futex until a job is given to it, see TWorkerJobState. This is only accessed with atomic operations.
 	int Is_Exit_Requested; //!< When set to 1, tell the worker thread to exit.
+	int Next_Available_Worker_Number; //!< When the worker is in the available workers stack, the number of the worker below it, see TWorkerPool. This is only accessed with atomic operations.
 	pid_t Thread_ID; //!< Allow to uniquely identify thread.
+	pthread_t Thread; //!< The thread handle, needed to wait for the thread termination.
+	int Is_Thread_Created; //!< Set to 1 when the thread has been created and has not been waited for yet. Only the thread that gives a job to the worker accesses this variable.
+	int Processor_ID; //!< The logical processor the thread is bound to, or -1 if the thread is not bound.
+	TWorkerStrategy Strategy; //!< How the current job is searched. A shared job keeps the strategy of the worker that shared it.
+	TGrid Restart_Grid; //!< A copy of the job grid, so the search can start again from it when the strategy uses restarts.
+	int Portfolio_Strategy_Index; //!< The rank of the job strategy in the portfolio when the job races the other workers (see WorkerSolvePortfolio()), or -1 when the job is shared with the other workers.
+	TWorkerSearchNode Search_Nodes[CELLS_STACK_ELEMENTS_COUNT]; //!< The nodes of the search tree branch currently explored, indexed by depth. Together with the forced cells stack, this is the whole search state.
+	int Shallowest_Shareable_Node_Depth; //!< All nodes shallower than this depth have no untried number left, this avoids scanning them each time some work is shared.
+	TCellsStack Forced_Cells_Stack; //!< The cells filled by the constraint propagation, so they can be emptied when the backtrack algorithm goes back.
+	TExactCoverMatrix Exact_Cover_Matrix; //!< The matrix and the search state of the dancing links algorithm. The worker grid is left untouched while the matrix is searched, so the subtrees given to other workers are built from it.
+	unsigned long long Unpublished_Solutions_Count; //!< The solutions counted by this worker that have not been added to the shared total yet.
+	unsigned long long Idle_Starting_Time; //!< When the thread started waiting for a job (see TimerGetNanoseconds()), or 0 if it is not waiting. Retrieving the statistics accounts for the idle time elapsed so far and moves this time forward, so each part of a wait is accounted once. This is only accessed with atomic operations.
+	TWorkerStatistics Statistics; //!< The worker activity counters.
 } TWorker;
 
+/** All data of a pool of workers. The content is private to the worker module, it is declared here only so the pools can be allocated by their users. */
+typedef struct TWorkerPool
+{
+	TWorker *Pointer_Workers; //!< All workers data, allocated when the pool is initialized. A worker is initialized the first time it is needed, so the memory of the workers that are never used is not touched.
+	int Workers_Count; //!< The biggest amount of workers the pool can currently use, see WorkerSetWorkersCount().
+	int Maximum_Workers_Count; //!< How many workers have been allocated, the workers count can't be bigger.
+	int Created_Workers_Count; //!< How many workers have been used at least once, they are the first ones of the workers array. The other workers are not initialized and are not in the available workers stack. This is only accessed with atomic operations.
+	char Padding_Before_Stack_Top[CONFIGURATION_CACHE_LINE_SIZE]; //!< Keep the available workers stack top in its own cache line, as it is written each time a job is given.
+	unsigned long long Available_Workers_Stack_Top; //!< The lock-free stack of the workers waiting for a job, linked through the workers. The low 32 bits are the number of the worker on the stack top (the worker index plus one, 0 when the stack is empty). The high 32 bits are incremented on each change, so a thread can't mistake a stack that has been changed meanwhile for an unchanged one. This is only accessed with atomic operations.
+	char Padding_After_Stack_Top[CONFIGURATION_CACHE_LINE_SIZE]; //!< Keep the other pool fields away from the stack top.
+	int Available_Workers_Futex; //!< Incremented each time a worker becomes available, the threads waiting for a worker sleep on this futex. This is only accessed with atomic operations.
+	int Available_Workers_Waiters_Count; //!< How many threads may sleep on the available workers futex, so it is woken up only when needed. This is only accessed with atomic operations.
+	int Job_Waiting_Spins_Count; //!< How many times an idle worker checks whether a job has been given before sleeping.
+	unsigned int Idle_Timeout; //!< How many milliseconds an idle worker thread sleeps before exiting, 0 to keep the threads forever.
+	TAffinityProcessor *Pointer_Placement; //!< When not NULL, the logical processor of each worker. A worker thread moves to its processor before starting a job.
+	int Busy_Workers_Count; //!< How many workers are currently solving a job. This is only accessed with atomic operations.
+	volatile int Is_Solution_Found; //!< Set to 1 as soon as a worker found the grid solution, so no more work is shared.
+	volatile int Is_Cancellation_Requested; //!< Set to 1 to make all busy workers abandon their job. This is checked by the backtrack algorithm for each explored node, so it must be cheap to read.
+	volatile int Is_Error; //!< Set to 1 when a worker could not search its job (the dancing links matrix could not be allocated), so the grid result is unknown unless a solution is found or a racing worker explored its whole search tree.
+	volatile int Is_Search_Tree_Exhausted; //!< Set to 1 when a racing worker explored its whole search tree without being cancelled, which proves that the grid has no solution even if another racing worker failed.
+	TWorker *Pointer_Worker_Solution; //!< The worker that found the solution.
+	TWorkerAlgorithm Algorithm; //!< How the grids are solved.
+	TWorkerCellSelectionHeuristic Cell_Selection_Heuristic; //!< How the next cell to fill is chosen.
+	TGridPropagationLevel Propagation_Level; //!< How much deduction is done each time a cell is filled.
+	unsigned long long Random_Seed; //!< When not zero, the search is randomized with this seed.
+	TWorkerRestartPolicy Restart_Policy; //!< When the randomized search restarts.
+	unsigned long long Restart_Nodes_Count; //!< The base explored nodes budget of a randomized search run.
+	double Restart_Growth_Factor; //!< How much the budget grows after each restart with the geometric policy.
+	unsigned long long *Pointer_Refuted_States; //!< When not NULL, the Zobrist hashes of the grid states proven unsolvable, shared by all workers. The table is made of cache line sized buckets, a hash being stored in the bucket selected by its lowest bits (0 marks an empty entry). This is only accessed with atomic operations.
+	unsigned long long Refuted_States_Buckets_Mask; //!< The refuted states table buckets count minus one, the buckets count being a power of two.
+	unsigned long long Maximum_Solutions_Count; //!< When not zero, the workers count the grid solutions instead of stopping at the first one, and stop as soon as more than this amount of solutions have been found.
+	unsigned long long Solutions_Publishing_Period; //!< How many solutions a worker counts on its own before adding them to the shared total. Counting more solutions locally reduces the accesses to the shared total, but delays the detection of a too big total.
+	unsigned long long Solutions_Count; //!< The solutions found by all workers for the current grid. This is only accessed with atomic operations.
+	unsigned long long First_Solution_Time; //!< When the first solution of the current grid was found (see TimerGetNanoseconds()), or 0 if no solution has been found yet. This is only accessed with atomic operations.
+	pthread_mutex_t Completion_Mutex; //!< Protect the solution variables, and is taken before signaling the completion condition.
+	pthread_cond_t Completion_Condition; //!< Signaled when a solution is found or when the last busy worker terminates its job.
+} TWorkerPool;
+
 //-------------------------------------------------------------------------------------------------
 // Functions
 //-------------------------------------------------------------------------------------------------
-/** Tell the worker subsystem how many threads can be started simultaneously.
- * @param Maximum_Workers_Count How many threads can be started at the same time.
+/** Prepare a pool. Only the first worker thread is created, the other threads are created when a busy worker has work to share and no idle thread is left, up to the maximum workers count. The idle threads sleep until they are given a job, and exit when they stay idle for too long (except the first one, so a grid can always be started without creating a thread). The pool settings are reset to their default values, call the WorkerSetXxx() functions after this one to change them.
+ * @param Pointer_Pool The pool to initialize.
+ * @param Maximum_Workers_Count How many threads can run at the same time.
  * @return 0 on success,
  * @return -1 if an error occurred.
  * @note This function prints an error message if an error occurs.
  */
-int WorkerInitialize(int Maximum_Workers_Count);
+int WorkerInitialize(TWorkerPool *Pointer_Pool, int Maximum_Workers_Count);
+
+/** Change how many workers the pool can use, without creating the pool again (for instance to measure how the solving speed scales with the threads count). The workers that have already been used are kept, so the count can't be smaller than their amount. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Workers_Count How many threads can run at the same time, in range [1; Maximum_Workers_Count given to WorkerInitialize()].
+ * @return 0 on success,
+ * @return -1 if the count is out of range.
+ * @note This function prints an error message if an error occurs.
+ */
+int WorkerSetWorkersCount(TWorkerPool *Pointer_Pool, int Workers_Count);
+
+/** Choose how the workers search for the grid solutions. Both algorithms share their unexplored subtrees with the idle workers and can count the solutions. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Algorithm The search algorithm (the default is the backtrack one).
+ */
+void WorkerSetAlgorithm(TWorkerPool *Pointer_Pool, TWorkerAlgorithm Algorithm);
+
+/** Choose how the workers select the next cell to fill. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Heuristic The cell selection heuristic.
+ */
+void WorkerSetCellSelectionHeuristic(TWorkerPool *Pointer_Pool, TWorkerCellSelectionHeuristic Heuristic);
+
+/** Choose how much deduction the workers do each time they fill a cell. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Propagation_Level The constraint propagation level.
+ */
+void WorkerSetPropagationLevel(TWorkerPool *Pointer_Pool, TGridPropagationLevel Propagation_Level);
+
+/** Randomize the order in which the workers try the numbers and break the cell selection ties. A randomized search often avoids the pathological search trees of the deterministic orders, especially when it restarts (see WorkerSetRestartPolicy()). This needs the most constrained cell heuristic, as filling the cells in order leaves only the numbers order to randomize, which rarely avoids a bad early choice. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Random_Seed The seed, worker i using a random sequence derived from this seed and from i, so a run can be reproduced. Set to 0 to use the deterministic orders (this is the default).
+ */
+void WorkerSetRandomSeed(TWorkerPool *Pointer_Pool, unsigned long long Random_Seed);
+
+/** Choose when a randomized search starts again from the job grid. Restarts are disabled when counting solutions, as the solutions of the abandoned search trees would be counted again. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Restart_Policy How the explored nodes budget of each run is computed (the default is the Luby policy).
+ * @param Restart_Nodes_Count The base explored nodes budget of a run (the default is 1024 nodes).
+ * @param Restart_Growth_Factor How much the budget grows after each restart with the geometric policy, it must be greater than 1 (the default is 1.5).
+ */
+void WorkerSetRestartPolicy(TWorkerPool *Pointer_Pool, TWorkerRestartPolicy Restart_Policy, unsigned long long Restart_Nodes_Count, double Restart_Growth_Factor);
+
+/** Make the backtrack algorithm share the grid states it proves unsolvable between all workers, so a worker reaching a state already refuted by any worker (or during a previous grid of the same size, as a state is unsolvable whatever the grid it comes from) skips its subtree. The states are identified by their Zobrist hash only, a full 64-bit hash collision being unlikely enough to be ignored. The table is lock-free, an entry being a single hash written atomically, and a full bucket overwrites one of its entries. As a single search tree does not reach the same state twice, the table is only used by the randomized searches that restart and by the jobs racing in portfolio mode. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Maximum_Size The biggest table size in bytes, the size used is the biggest power of two cache lines count that fits. Set to 0 to disable the table (this is the default).
+ * @return 0 on success,
+ * @return -1 if there is not enough memory (the table is disabled).
+ * @note This function prints an error message if an error occurs.
+ */
+int WorkerSetRefutedStatesTableSize(TWorkerPool *Pointer_Pool, unsigned long long Maximum_Size);
+
+/** Make the workers count the grid solutions instead of stopping at the first one. Each worker counts the solutions of its own subtrees and adds them to the total from time to time, so the workers rarely access shared data. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Maximum_Solutions_Count Stop counting as soon as more than this amount of solutions have been found (use 1 to check that a grid has a single solution). Set to 0 to stop at the first solution and keep it (this is the default).
+ */
+void WorkerSetMaximumSolutionsCount(TWorkerPool *Pointer_Pool, unsigned long long Maximum_Solutions_Count);
+
+/** Choose how long an idle worker thread waits for a job before exiting. The thread is created again when work is available for it. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to configure.
+ * @param Milliseconds The idle time after which a thread exits, 0 to keep the threads forever (the default is 1 second).
+ */
+void WorkerSetIdleTimeout(TWorkerPool *Pointer_Pool, unsigned int Milliseconds);
+
+/** Make each worker thread run only on its own logical processor, so the scheduler can't migrate the workers nor put them on the SMT threads of a busy core. As the threads are created on demand, each thread binds itself before starting its next job. This must be called when all workers are idle.
+ * @param Pointer_Pool The pool to bind.
+ * @param Placement The processor of each worker, see AffinityComputePlacement(). The array must have as many elements as the maximum workers count given to WorkerInitialize().
+ * @return 0 on success,
+ * @return -1 if there is not enough memory to keep the placement.
+ * @note This function prints an error message if an error occurs. A thread that can't be bound prints an error message and keeps running on any processor.
+ */
+int WorkerBindToProcessors(TWorkerPool *Pointer_Pool, TAffinityProcessor Placement[]);
+
+/** Get how many solutions have been counted for the last grid. Call this function after WorkerWaitForCompletion() and before WorkerWaitForAllWorkersIdle().
+ * @param Pointer_Pool The pool that solved the grid.
+ * @return The solutions count. When it is bigger than the maximum solutions count, the grid has more solutions than the returned value.
+ */
+unsigned long long WorkerGetSolutionsCount(TWorkerPool *Pointer_Pool);
+
+/** Get when the first solution of the last grid was found. Call this function after WorkerWaitForCompletion() and before WorkerWaitForAllWorkersIdle().
+ * @param Pointer_Pool The pool that solved the grid.
+ * @return 0 if no solution has been found,
+ * @return The time returned by TimerGetNanoseconds() when a worker found the first solution.
+ */
+unsigned long long WorkerGetFirstSolutionTime(TWorkerPool *Pointer_Pool);
+
+/** Retrieve the statistics of all workers. The values are accurate only when all workers are idle, subtract two retrieved values to get the statistics of a grid. The idle time includes the current waits up to the retrieval, so it is given to the grid during which the workers waited.
+ * @param Pointer_Pool The pool owning the workers.
+ * @param Workers_Statistics On output, contain the statistics of each worker since the workers were initialized. The array must have at least as many elements as workers.
+ */
+void WorkerGetStatistics(TWorkerPool *Pointer_Pool, TWorkerStatistics Workers_Statistics[]);
 
-/** Release worker resources. */
-void WorkerUninitialize(void);
+/** Stop all running jobs, terminate all worker threads and release the pool resources. The pool can be initialized again afterwards.
+ * @param Pointer_Pool The pool to release.
+ */
+void WorkerUninitialize(TWorkerPool *Pointer_Pool);
 
-/** Tell the specified worker to start solving its grid.
+/** Tell the specified worker to start solving its grid with the pool settings. The worker thread is created if needed. If the thread can't be created, the worker is not used anymore and the grid is given to another worker.
  * @param Pointer_Worker The worker that must start its job.
  */
 void WorkerSolve(TWorker *Pointer_Worker);
 
+/** Race several strategies on the same grid : each worker searches the whole grid with its own strategy and does not share its work, the first worker finding the solution cancelling the other ones. A worker exploring its whole search tree proves that the grid has no solution, so it cancels the other workers too. A worker failing to search its tree (see WorkerWaitForCompletion()) drops out of the race without stopping the other workers. On the grids whose difficulty depends a lot on the search order, this is much faster than sharing a single search tree. The strategies are taken in order from a fixed portfolio mixing the dancing links algorithm and the backtrack algorithm with several cell selection heuristics, propagation levels and numbers orders, at most one worker being given each strategy. When there are more workers than portfolio strategies, the next workers run randomized searches seeded from the pool seed and restarting with the pool restart policy. The other pool algorithm settings are not used.
+ * @param Pointer_Pool The pool, all workers must be idle. It must not count solutions.
+ * @param Pointer_Grid The grid to solve. Call WorkerWaitForCompletion() to get the result, the winning worker telling its strategy.
+ * @return How many workers have been given the grid.
+ */
+int WorkerSolvePortfolio(TWorkerPool *Pointer_Pool, TGrid *Pointer_Grid);
+
+/** Describe a strategy in a human-readable way.
+ * @param Pointer_Strategy The strategy to describe.
+ * @param Pointer_Output_String On output, contain the description. Make sure the string has at least WORKER_STRATEGY_STRING_MAXIMUM_LENGTH + 1 bytes room.
+ */
+void WorkerConvertStrategyToString(TWorkerStrategy *Pointer_Strategy, char *Pointer_Output_String);
+
 /** Block if no more worker is available. The function immediately returns if one or more workers are available to give them a grid to solve.
+ * @param Pointer_Pool The pool to get a worker from.
  * @param Pointer_Pointer_Worker On output, contain a pointer on the worker that reported the event.
  * @return 0 if this worker grid was not solved,
  * @return 1 if this worker grid has been solved.
  */
-int WorkerWaitForAvailableWorker(TWorker **Pointer_Pointer_Worker);
+int WorkerWaitForAvailableWorker(TWorkerPool *Pointer_Pool, TWorker **Pointer_Pointer_Worker);
+
+/** Block until a solution has been found or until all workers ran out of work (when counting solutions, until all workers ran out of work or too many solutions have been found). While a grid is solved, idle workers take the unexplored branches of the busy workers search trees, so the whole search space is explored in parallel.
+ * @param Pointer_Pool The pool solving the grid.
+ * @param Pointer_Pointer_Worker On output, contain a pointer on the worker that found the solution (if any).
+ * @return -1 if a worker could not search its part of the search tree and no solution was found, so it is unknown whether the grid has a solution (when counting, the solutions count is incomplete),
+ * @return 0 if the grid has no solution,
+ * @return 1 if the grid has been solved.
+ * @note The worker that failed prints an error message.
+ */
+int WorkerWaitForCompletion(TWorkerPool *Pointer_Pool, TWorker **Pointer_Pointer_Worker);
+
+/** Ask all busy workers of a pool to abandon their job as soon as possible. WorkerWaitForCompletion() will report that no solution was found, unless a worker found it before the request.
+ * @param Pointer_Pool The pool to stop.
+ * @note Workers also cancel their jobs automatically when a solution is found.
+ */
+void WorkerCancel(TWorkerPool *Pointer_Pool);
+
+/** Block until all workers of a pool terminated their job, then forget about the previous grid result. This must be called before providing a new grid to the workers.
+ * @param Pointer_Pool The pool to wait for.
+ */
+void WorkerWaitForAllWorkersIdle(TWorkerPool *Pointer_Pool);
 
 /** Tell a worker thread to quit.
  * @param Pointer_Worker The worker that must terminate.
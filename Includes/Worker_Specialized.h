@@ -0,0 +1,277 @@
+/** @file Worker_Specialized.h
+ * The backtrack search loop, written for a single grid size. Worker.c includes this file once per supported grid size, so the grid accesses done for each search tree node use compile-time dimensions : the cells and bitmasks offsets are constants and the square of a cell is found with multiplications instead of the grid geometry table.
+ * Define the following macros before including this file (they are undefined at the end of the file) :
+ *   - WORKER_SPECIALIZED_SIZE : the grid side size in cells,
+ *   - WORKER_SPECIALIZED_SQUARE_WIDTH : the horizontal size of a square in cells,
+ *   - WORKER_SPECIALIZED_SQUARE_HEIGHT : the vertical size of a square in cells,
+ *   - WORKER_SPECIALIZED_SUFFIX : the suffix appended to all generated names (like _9x9).
+ * @note There is no include guard as this file is included several times on purpose. It must only be included by Worker.c, after the worker private functions the search uses.
+ * @author Adrien RICCIARDI
+ */
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** Append the suffix to a name (the indirection is needed to expand the suffix macro). */
+#define WORKER_SPECIALIZED_CONCATENATE_EXPANDED(Name, Suffix) Name##Suffix
+/** Append the suffix to a name. */
+#define WORKER_SPECIALIZED_CONCATENATE(Name, Suffix) WORKER_SPECIALIZED_CONCATENATE_EXPANDED(Name, Suffix)
+/** Give the name of a function generated for this grid size. */
+#define WORKER_SPECIALIZED_NAME(Name) WORKER_SPECIALIZED_CONCATENATE(Name, WORKER_SPECIALIZED_SUFFIX)
+
+/** Access a cell of the solved grid (a Pointer_Grid variable must be in the scope). */
+#define WORKER_SPECIALIZED_CELL(Row, Column) GRID_SIZED_CELL(Pointer_Grid, WORKER_SPECIALIZED_SIZE, Row, Column)
+/** Access the allowed numbers bitmask of a row of the solved grid. */
+#define WORKER_SPECIALIZED_ROW_BITMASK(Row) GRID_SIZED_ROW_BITMASK(Pointer_Grid, WORKER_SPECIALIZED_SIZE, Row)
+/** Access the allowed numbers bitmask of a column of the solved grid. */
+#define WORKER_SPECIALIZED_COLUMN_BITMASK(Column) GRID_SIZED_COLUMN_BITMASK(Pointer_Grid, WORKER_SPECIALIZED_SIZE, Column)
+/** Access the allowed numbers bitmask of the square containing a cell of the solved grid. */
+#define WORKER_SPECIALIZED_SQUARE_BITMASK(Row, Column) GRID_SIZED_SQUARE_BITMASK(Pointer_Grid, WORKER_SPECIALIZED_SIZE, GRID_SIZED_GET_CELL_SQUARE_INDEX(WORKER_SPECIALIZED_SIZE, WORKER_SPECIALIZED_SQUARE_WIDTH, WORKER_SPECIALIZED_SQUARE_HEIGHT, Row, Column))
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Empty a filled cell, allowing its number again in the cell units, and push the cell on the empty cells stack.
+ * @param Pointer_Grid The grid.
+ * @param Row The cell row coordinate.
+ * @param Column The cell column coordinate.
+ */
+static inline void WORKER_SPECIALIZED_NAME(WorkerEmptyCell)(TGrid *Pointer_Grid, unsigned int Row, unsigned int Column)
+{
+	TGridBitmask Bitmask_Number;
+	TCellsStackCellCoordinates *Pointer_Cell_Coordinates;
+	
+	Bitmask_Number = GRID_BITMASK_NUMBER(WORKER_SPECIALIZED_CELL(Row, Column));
+	WORKER_SPECIALIZED_ROW_BITMASK(Row) |= Bitmask_Number;
+	WORKER_SPECIALIZED_COLUMN_BITMASK(Column) |= Bitmask_Number;
+	WORKER_SPECIALIZED_SQUARE_BITMASK(Row, Column) |= Bitmask_Number;
+	WORKER_SPECIALIZED_CELL(Row, Column) = GRID_EMPTY_CELL_VALUE;
+	
+	Pointer_Cell_Coordinates = &GRID_SIZED_GET_EMPTY_CELLS(Pointer_Grid, WORKER_SPECIALIZED_SIZE)[Pointer_Grid->Empty_Cells_Count];
+	Pointer_Cell_Coordinates->Row = Row;
+	Pointer_Cell_Coordinates->Column = Column;
+	Pointer_Grid->Empty_Cells_Count++;
+}
+
+/** Solve a grid using the backtrack algorithm. The search is iterative : the worker search nodes are the trail of the explored branch, each one recording the filled cell and its untried numbers, so going back in the tree only needs to undo the trail top.
+ * A randomized search tries the numbers in a random order and breaks the most constrained cell ties randomly. It restarts from the job grid with a new order each time its explored nodes budget is exhausted, so an unlucky early choice does not make the search last much longer than usual.
+ * When the refuted states table is used, the grid hash is updated each time a node is entered, and a node whose numbers have all been tried without solution records its state in the table.
+ * The grid accesses of each node are inlined with the grid dimensions of this file instance, so they do not read the grid geometry.
+ * @param Pointer_Worker The worker owning the grid to solve, it must have the grid size of this file instance.
+ * @return 0 if the grid could not be solved,
+ * @return 1 if the grid was successfully solved.
+ */
+static int WORKER_SPECIALIZED_NAME(WorkerSolveGrid)(TWorker *Pointer_Worker)
+{
+	int Row, Column, Depth = 0, Is_Node_Entered = 1;
+	unsigned int Tested_Number;
+	TGridBitmask Bitmask_Tested_Number;
+	TGrid *Pointer_Grid = &Pointer_Worker->Grid;
+	TWorkerSearchNode *Pointer_Node;
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	TWorkerCellSelectionHeuristic Cell_Selection_Heuristic = Pointer_Worker->Strategy.Cell_Selection_Heuristic; // The settings can't change while a grid is solved, so keep them in local variables
+	TGridPropagationLevel Propagation_Level = Pointer_Worker->Strategy.Propagation_Level;
+	int Is_Numbers_Order_Reversed = Pointer_Worker->Strategy.Is_Numbers_Order_Reversed, Is_Work_Shared = Pointer_Worker->Portfolio_Strategy_Index < 0;
+	unsigned long long Maximum_Solutions_Count = Pointer_Pool->Maximum_Solutions_Count, Solutions_Publishing_Period = Pointer_Pool->Solutions_Publishing_Period;
+	int Is_Search_Randomized = Pointer_Worker->Strategy.Random_Seed != 0, Is_Cells_Order_Randomized = Is_Search_Randomized && (Cell_Selection_Heuristic == WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL);
+	unsigned long long Random_State = 0, Restarts_Count = 0, Run_Explored_Nodes_Count = 0, Run_Maximum_Explored_Nodes_Count = WorkerGetRestartNodesCount(Pointer_Worker, 0);
+	int Is_Refuted_States_Table_Used = (Pointer_Pool->Pointer_Refuted_States != NULL) && (!Is_Work_Shared || (Run_Maximum_Explored_Nodes_Count != ULLONG_MAX)), i; // A shared search tree that never restarts does not reach the same state twice, so the table only costs time, unless the job races other strategies exploring the same states
+	unsigned long long State_Hash = 0;
+	TCellsStackCellCoordinates *Pointer_Forced_Cells_Coordinates = Pointer_Worker->Forced_Cells_Stack.Cells_Coordinates, *Pointer_Empty_Cells_Coordinates;
+	unsigned long long *Pointer_Propagations_Count = GridIsCandidatesBoardUsed(Pointer_Grid, Propagation_Level) ? &Pointer_Worker->Statistics.Board_Propagations_Count : &Pointer_Worker->Statistics.Scalar_Propagations_Count; // Both paths deduce different cells, so the statistics tell which one ran
+	
+	assert(Pointer_Grid->Grid_Size == WORKER_SPECIALIZED_SIZE);
+	
+	// Keep the job grid to start again from it on each restart
+	if (Is_Search_Randomized)
+	{
+		Random_State = WorkerSeedRandomSequence(Pointer_Worker);
+		if (Run_Maximum_Explored_Nodes_Count != ULLONG_MAX) GridCopy(Pointer_Grid, &Pointer_Worker->Restart_Grid);
+		if (Is_Cells_Order_Randomized) WorkerShuffleEmptyCells(Pointer_Grid, &Random_State);
+	}
+	if (Is_Refuted_States_Table_Used) State_Hash = WorkerComputeStateHash(Pointer_Grid);
+	
+	while (1)
+	{
+		Pointer_Node = &Pointer_Worker->Search_Nodes[Depth];
+		
+		// Create the node when the tree is entered at this depth
+		if (Is_Node_Entered)
+		{
+			// Throw the explored tree away when the run budget is exhausted, the next run uses a new numbers order (and a new cells order if the most constrained cell is chosen) (the work given to other workers is explored again, which does not matter when the first solution is searched)
+			if (Run_Explored_Nodes_Count >= Run_Maximum_Explored_Nodes_Count)
+			{
+				GridCopy(&Pointer_Worker->Restart_Grid, Pointer_Grid);
+				CellsStackInitialize(&Pointer_Worker->Forced_Cells_Stack);
+				if (Is_Cells_Order_Randomized) WorkerShuffleEmptyCells(Pointer_Grid, &Random_State);
+				Depth = 0;
+				Pointer_Node = &Pointer_Worker->Search_Nodes[0];
+				Pointer_Worker->Shallowest_Shareable_Node_Depth = 0;
+				
+				Restarts_Count++;
+				Pointer_Worker->Statistics.Restarts_Count++;
+				Run_Maximum_Explored_Nodes_Count = WorkerGetRestartNodesCount(Pointer_Worker, Restarts_Count);
+				Run_Explored_Nodes_Count = 0;
+				if (Is_Refuted_States_Table_Used) State_Hash = WorkerComputeStateHash(Pointer_Grid);
+				LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Restarted the search, the next run can explore %llu nodes.\n", Pointer_Worker->Thread_ID, Run_Maximum_Explored_Nodes_Count);
+			}
+			Run_Explored_Nodes_Count++;
+			Pointer_Worker->Statistics.Explored_Nodes_Count++;
+			
+			// Bring the most constrained cell to the stack top if requested
+			if (Cell_Selection_Heuristic == WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL) GridMoveMostConstrainedCellToStackTop(Pointer_Grid);
+			
+			// Find the first empty cell (don't remove the stack top now as the backtrack can go back soon if no available number is found)
+			if (Pointer_Grid->Empty_Cells_Count == 0)
+			{
+				// No empty cell remain and there is no error in the grid : the solution has been found
+				if (GridIsCorrectlyFilled(Pointer_Grid))
+				{
+					// Only the first solution counted since the last publication can be the grid first one, this avoids reading the shared time for each solution
+					if (Pointer_Worker->Unpublished_Solutions_Count == 0) WorkerRecordFirstSolutionTime(Pointer_Pool);
+					if (Maximum_Solutions_Count == 0) return 1;
+					
+					// Count the solution, then keep searching for other ones (the parent nodes are not unsolvable anymore)
+					Pointer_Worker->Unpublished_Solutions_Count++;
+					if (Pointer_Worker->Unpublished_Solutions_Count >= Solutions_Publishing_Period) WorkerPublishSolutionsCount(Pointer_Worker);
+					if (Depth > 0) Pointer_Worker->Search_Nodes[Depth - 1].Is_Subtree_Refuted = 0;
+				}
+				
+				// Go back to the parent node
+				if (Depth == 0) return 0;
+				Depth--;
+				Pointer_Worker->Statistics.Backtracks_Count++;
+				Is_Node_Entered = 0;
+				continue;
+			}
+			
+			Pointer_Empty_Cells_Coordinates = &GRID_SIZED_GET_EMPTY_CELLS(Pointer_Grid, WORKER_SPECIALIZED_SIZE)[Pointer_Grid->Empty_Cells_Count - 1];
+			Row = Pointer_Empty_Cells_Coordinates->Row;
+			Column = Pointer_Empty_Cells_Coordinates->Column;
+			
+			// Get available numbers for this cell, they are stored in the node so other workers can take some of them
+			Pointer_Node->Bitmask_Untried_Numbers = WORKER_SPECIALIZED_ROW_BITMASK(Row) & WORKER_SPECIALIZED_COLUMN_BITMASK(Column) & WORKER_SPECIALIZED_SQUARE_BITMASK(Row, Column);
+			if (Pointer_Node->Bitmask_Untried_Numbers == 0) Pointer_Worker->Statistics.Dead_Ends_Count++;
+			Pointer_Node->Row = Row;
+			Pointer_Node->Column = Column;
+			Pointer_Node->Forced_Cells_Stack_Index = Pointer_Worker->Forced_Cells_Stack.Stack_Index;
+			if (Pointer_Worker->Shallowest_Shareable_Node_Depth > Depth) Pointer_Worker->Shallowest_Shareable_Node_Depth = Depth;
+			
+			// Skip the states already proven unsolvable by any worker, like a cell without available number (the table is only read when the cell has available numbers, as this is much faster to check, but all nodes are initialized as they are all checked when left)
+			if (Is_Refuted_States_Table_Used)
+			{
+				Pointer_Node->State_Hash = State_Hash;
+				Pointer_Node->Is_Subtree_Refuted = 1;
+				Pointer_Node->Explored_Nodes_Count = Pointer_Worker->Statistics.Explored_Nodes_Count;
+				if (Pointer_Node->Bitmask_Untried_Numbers != 0)
+				{
+					if (WorkerIsStateRefuted(Pointer_Pool, State_Hash))
+					{
+						Pointer_Worker->Statistics.Refuted_States_Hits_Count++;
+						Pointer_Node->Bitmask_Untried_Numbers = 0;
+					}
+					else Pointer_Worker->Statistics.Refuted_States_Misses_Count++;
+				}
+			}
+		}
+		// Otherwise the tried number led to a dead end, restore old value and the deduced ones
+		else
+		{
+			Row = Pointer_Node->Row;
+			Column = Pointer_Node->Column;
+			
+			// Restore the deduced cells in the reverse order, then the tried cell, which is available again
+			while (Pointer_Worker->Forced_Cells_Stack.Stack_Index > Pointer_Node->Forced_Cells_Stack_Index)
+			{
+				Pointer_Worker->Forced_Cells_Stack.Stack_Index--;
+				WORKER_SPECIALIZED_NAME(WorkerEmptyCell)(Pointer_Grid, Pointer_Forced_Cells_Coordinates[Pointer_Worker->Forced_Cells_Stack.Stack_Index].Row, Pointer_Forced_Cells_Coordinates[Pointer_Worker->Forced_Cells_Stack.Stack_Index].Column);
+			}
+			WORKER_SPECIALIZED_NAME(WorkerEmptyCell)(Pointer_Grid, Row, Column);
+		}
+		
+		// All numbers were tested unsuccessfully (or given to other workers meanwhile), go back into the tree (the grid is left untouched if the cell had no available number, as the top of the stack has not been altered)
+		if (Pointer_Node->Bitmask_Untried_Numbers == 0)
+		{
+			// Remember the state if this worker proved that it is unsolvable, the parent node can't be remembered when this node could not be
+			if (Is_Refuted_States_Table_Used)
+			{
+				if (!Pointer_Node->Is_Subtree_Refuted)
+				{
+					if (Depth > 0) Pointer_Worker->Search_Nodes[Depth - 1].Is_Subtree_Refuted = 0;
+				}
+				else if (!Is_Node_Entered && (Pointer_Worker->Statistics.Explored_Nodes_Count - Pointer_Node->Explored_Nodes_Count >= WORKER_REFUTED_STATES_MINIMUM_SUBTREE_SIZE)) WorkerAddRefutedState(Pointer_Pool, Pointer_Node->State_Hash); // The states without available number in the cell and the states found in the table are not added
+			}
+			
+			if (Depth == 0) return 0;
+			Depth--;
+			Pointer_Worker->Statistics.Backtracks_Count++;
+			Is_Node_Entered = 0;
+			continue;
+		}
+		
+		// Stop searching if the job is not needed anymore (the grid does not need to be restored as it will be overwritten by the next job)
+		if (Pointer_Pool->Is_Cancellation_Requested) return 0;
+		
+		// Take a random untried number if the search is randomized, otherwise the smallest one, or the biggest one if the strategy requests it
+		if (Is_Search_Randomized)
+		{
+			Tested_Number = WorkerPickRandomNumber(Pointer_Node->Bitmask_Untried_Numbers, &Random_State);
+			Pointer_Node->Bitmask_Untried_Numbers &= ~GRID_BITMASK_NUMBER(Tested_Number);
+		}
+		else if (Is_Numbers_Order_Reversed)
+		{
+			Tested_Number = GRID_BITMASK_GET_BIGGEST_NUMBER(Pointer_Node->Bitmask_Untried_Numbers);
+			Pointer_Node->Bitmask_Untried_Numbers &= ~GRID_BITMASK_NUMBER(Tested_Number);
+		}
+		else
+		{
+			Tested_Number = GRID_BITMASK_GET_SMALLEST_NUMBER(Pointer_Node->Bitmask_Untried_Numbers);
+			Pointer_Node->Bitmask_Untried_Numbers &= Pointer_Node->Bitmask_Untried_Numbers - 1;
+		}
+		Pointer_Node->Tested_Number = Tested_Number;
+		
+		// Give some work to the idle workers if there are some, or to new workers if the pool can grow (a job racing other strategies keeps its whole search tree)
+		if (Is_Work_Shared && WorkerIsWorkerAvailable(Pointer_Pool)) WorkerShareWork(Pointer_Worker, Depth);
+		
+		// Try the number
+		WORKER_SPECIALIZED_CELL(Row, Column) = Tested_Number;
+		Bitmask_Tested_Number = ~GRID_BITMASK_NUMBER(Tested_Number);
+		WORKER_SPECIALIZED_ROW_BITMASK(Row) &= Bitmask_Tested_Number;
+		WORKER_SPECIALIZED_COLUMN_BITMASK(Column) &= Bitmask_Tested_Number;
+		WORKER_SPECIALIZED_SQUARE_BITMASK(Row, Column) &= Bitmask_Tested_Number;
+		Pointer_Grid->Empty_Cells_Count--; // Really try to fill this cell, removing it for next simulation step
+		
+		// Simulate next state, unless the deductions made from the tried number show that the grid can't be solved (in this case the number is undone by the next iteration)
+		if (Propagation_Level == GRID_PROPAGATION_LEVEL_NONE) Is_Node_Entered = 1;
+		else
+		{
+			(*Pointer_Propagations_Count)++;
+			Is_Node_Entered = GridPropagateConstraints(Pointer_Grid, Row, Column, Propagation_Level, &Pointer_Worker->Forced_Cells_Stack);
+		}
+		if (Is_Node_Entered)
+		{
+			// The child state is the node state plus the tried number and the deduced cells
+			if (Is_Refuted_States_Table_Used)
+			{
+				State_Hash = Pointer_Node->State_Hash ^ WorkerGetZobristKey(Row, Column, Tested_Number);
+				for (i = Pointer_Node->Forced_Cells_Stack_Index; i < Pointer_Worker->Forced_Cells_Stack.Stack_Index; i++) State_Hash ^= WorkerGetZobristKey(Pointer_Forced_Cells_Coordinates[i].Row, Pointer_Forced_Cells_Coordinates[i].Column, WORKER_SPECIALIZED_CELL(Pointer_Forced_Cells_Coordinates[i].Row, Pointer_Forced_Cells_Coordinates[i].Column));
+				WorkerPrefetchRefutedStatesBucket(Pointer_Pool, State_Hash); // The bucket is read once the next cell is chosen, the memory access is done meanwhile
+			}
+			Depth++;
+		}
+		else Pointer_Worker->Statistics.Dead_Ends_Count++;
+	}
+}
+
+// Allow the file to be included again for another grid size
+#undef WORKER_SPECIALIZED_CONCATENATE_EXPANDED
+#undef WORKER_SPECIALIZED_CONCATENATE
+#undef WORKER_SPECIALIZED_NAME
+#undef WORKER_SPECIALIZED_CELL
+#undef WORKER_SPECIALIZED_ROW_BITMASK
+#undef WORKER_SPECIALIZED_COLUMN_BITMASK
+#undef WORKER_SPECIALIZED_SQUARE_BITMASK
+#undef WORKER_SPECIALIZED_SIZE
+#undef WORKER_SPECIALIZED_SQUARE_WIDTH
+#undef WORKER_SPECIALIZED_SQUARE_HEIGHT
+#undef WORKER_SPECIALIZED_SUFFIX
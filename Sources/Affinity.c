@@ -0,0 +1,335 @@
+/** @file Affinity.c
+ * See Affinity.h for description.
+ * @author Adrien RICCIARDI
+ */
+#define _GNU_SOURCE // Needed by the processor sets macros and by sched_getaffinity()
+#include <Affinity.h>
+#include <Log.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** The sysfs directory describing all logical processors. */
+#define AFFINITY_SYSFS_PROCESSORS_PATH "/sys/devices/system/cpu"
+
+/** The size of the buffer holding a sysfs file content. */
+#define AFFINITY_SYSFS_FILE_MAXIMUM_LENGTH 4096
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A logical processor and its rank in the topology, needed to spread the workers. */
+typedef struct
+{
+	TAffinityProcessor Processor; //!< The logical processor location.
+	int Package_Rank; //!< The rank of the package the processor belongs to.
+	int Cache_Rank; //!< The rank of the processor last level cache inside its package.
+	int Core_Rank; //!< The rank of the processor physical core inside its last level cache.
+} TAffinityTopologyEntry;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Read the first line of a logical processor sysfs file.
+ * @param Processor_ID The logical processor number.
+ * @param String_File_Name The file path relative to the processor sysfs directory.
+ * @param String_Content On output, contain the file first line.
+ * @param Content_Size The content buffer size in bytes.
+ * @return 0 on success,
+ * @return -1 if the file could not be read.
+ */
+static int AffinityReadSysfsFile(int Processor_ID, char *String_File_Name, char *String_Content, int Content_Size)
+{
+	char String_Path[256];
+	FILE *Pointer_File;
+	int Return_Value = 0;
+	
+	snprintf(String_Path, sizeof(String_Path), AFFINITY_SYSFS_PROCESSORS_PATH "/cpu%d/%s", Processor_ID, String_File_Name);
+	Pointer_File = fopen(String_Path, "r");
+	if (Pointer_File == NULL) return -1;
+	
+	if (fgets(String_Content, Content_Size, Pointer_File) == NULL) Return_Value = -1;
+	fclose(Pointer_File);
+	
+	return Return_Value;
+}
+
+/** Read a number from a logical processor sysfs file.
+ * @param Processor_ID The logical processor number.
+ * @param String_File_Name The file path relative to the processor sysfs directory.
+ * @return -1 if the file could not be read,
+ * @return The number on success.
+ */
+static int AffinityReadSysfsNumber(int Processor_ID, char *String_File_Name)
+{
+	char String_Content[64];
+	
+	if (AffinityReadSysfsFile(Processor_ID, String_File_Name, String_Content, sizeof(String_Content)) != 0) return -1;
+	return atoi(String_Content);
+}
+
+/** Convert a processors list like "0,2,4-7" to the processor numbers, keeping the list order.
+ * @param String_List The list to convert. It can be terminated by a new line character.
+ * @param Processors_IDs On output, contain the listed processor numbers.
+ * @param Maximum_Count The processor numbers array size.
+ * @return -1 if the list is bad or too long,
+ * @return The listed processors count on success.
+ */
+static int AffinityParseList(char *String_List, int Processors_IDs[], int Maximum_Count)
+{
+	char *Pointer_Character = String_List, *Pointer_End;
+	long First_ID, Last_ID, ID;
+	int Count = 0;
+	
+	while (1)
+	{
+		// Read the single processor or the range first processor
+		First_ID = strtol(Pointer_Character, &Pointer_End, 10);
+		if ((Pointer_End == Pointer_Character) || (First_ID < 0) || (First_ID >= AFFINITY_PROCESSORS_MAXIMUM_COUNT)) return -1;
+		Pointer_Character = Pointer_End;
+		
+		// Read the range last processor if any
+		if (*Pointer_Character == '-')
+		{
+			Pointer_Character++;
+			Last_ID = strtol(Pointer_Character, &Pointer_End, 10);
+			if ((Pointer_End == Pointer_Character) || (Last_ID < First_ID) || (Last_ID >= AFFINITY_PROCESSORS_MAXIMUM_COUNT)) return -1;
+			Pointer_Character = Pointer_End;
+		}
+		else Last_ID = First_ID;
+		
+		for (ID = First_ID; ID <= Last_ID; ID++)
+		{
+			if (Count >= Maximum_Count) return -1;
+			Processors_IDs[Count] = ID;
+			Count++;
+		}
+		
+		// Continue with the next element or stop at the list end
+		if (*Pointer_Character == ',') Pointer_Character++;
+		else if ((*Pointer_Character == 0) || (*Pointer_Character == '\n')) return Count;
+		else return -1;
+	}
+}
+
+/** Find the location of all logical processors the program is allowed to run on.
+ * @param Topology On output, contain the allowed processors sorted by number. The array must have AFFINITY_PROCESSORS_MAXIMUM_COUNT elements.
+ * @param Siblings_IDs A scratch array of AFFINITY_PROCESSORS_MAXIMUM_COUNT elements.
+ * @param String_Siblings_List A scratch buffer of AFFINITY_SYSFS_FILE_MAXIMUM_LENGTH bytes.
+ * @return -1 if the allowed processors could not be retrieved,
+ * @return The allowed processors count on success.
+ */
+static int AffinityReadTopology(TAffinityTopologyEntry Topology[], int Siblings_IDs[], char *String_Siblings_List)
+{
+	cpu_set_t Allowed_Processors;
+	int Processor_ID, Count = 0, Siblings_Count, i;
+	TAffinityProcessor *Pointer_Processor;
+	
+	// Honor the processors restriction set with taskset or by a cgroup
+	if (sched_getaffinity(0, sizeof(Allowed_Processors), &Allowed_Processors) != 0) return -1;
+	
+	for (Processor_ID = 0; (Processor_ID < CPU_SETSIZE) && (Processor_ID < AFFINITY_PROCESSORS_MAXIMUM_COUNT); Processor_ID++)
+	{
+		if (!CPU_ISSET(Processor_ID, &Allowed_Processors)) continue;
+		
+		// Missing topology files make each logical processor look like a single-thread core of a single package
+		Pointer_Processor = &Topology[Count].Processor;
+		Pointer_Processor->Processor_ID = Processor_ID;
+		Pointer_Processor->Package_ID = AffinityReadSysfsNumber(Processor_ID, "topology/physical_package_id");
+		if (Pointer_Processor->Package_ID < 0) Pointer_Processor->Package_ID = 0;
+		Pointer_Processor->Core_ID = AffinityReadSysfsNumber(Processor_ID, "topology/core_id");
+		if (Pointer_Processor->Core_ID < 0) Pointer_Processor->Core_ID = Processor_ID;
+		Pointer_Processor->Cache_ID = AffinityReadSysfsNumber(Processor_ID, "cache/index3/id"); // The index 3 cache is the L3 one on x86 processors
+		if (Pointer_Processor->Cache_ID < 0) Pointer_Processor->Cache_ID = Pointer_Processor->Package_ID;
+		
+		// The thread rank is the count of allowed sibling threads having a lower number, so each core having an allowed processor has a first thread
+		Pointer_Processor->Thread_Index = 0;
+		if (AffinityReadSysfsFile(Processor_ID, "topology/thread_siblings_list", String_Siblings_List, AFFINITY_SYSFS_FILE_MAXIMUM_LENGTH) == 0)
+		{
+			Siblings_Count = AffinityParseList(String_Siblings_List, Siblings_IDs, AFFINITY_PROCESSORS_MAXIMUM_COUNT);
+			for (i = 0; i < Siblings_Count; i++)
+			{
+				if ((Siblings_IDs[i] < Processor_ID) && CPU_ISSET(Siblings_IDs[i], &Allowed_Processors)) Pointer_Processor->Thread_Index++;
+			}
+		}
+		Count++;
+	}
+	
+	return Count;
+}
+
+/** Sort the processors so that the SMT threads of a core are adjacent, then the cores of a last level cache, then the caches of a package.
+ * @param Pointer_Entry_1 The first processor.
+ * @param Pointer_Entry_2 The second processor.
+ * @return A negative number if the first processor comes first, a positive number if it comes last.
+ */
+static int AffinityCompareCompact(const void *Pointer_Entry_1, const void *Pointer_Entry_2)
+{
+	const TAffinityProcessor *Pointer_Processor_1 = &((const TAffinityTopologyEntry *) Pointer_Entry_1)->Processor, *Pointer_Processor_2 = &((const TAffinityTopologyEntry *) Pointer_Entry_2)->Processor;
+	
+	if (Pointer_Processor_1->Package_ID != Pointer_Processor_2->Package_ID) return Pointer_Processor_1->Package_ID - Pointer_Processor_2->Package_ID;
+	if (Pointer_Processor_1->Cache_ID != Pointer_Processor_2->Cache_ID) return Pointer_Processor_1->Cache_ID - Pointer_Processor_2->Cache_ID;
+	if (Pointer_Processor_1->Core_ID != Pointer_Processor_2->Core_ID) return Pointer_Processor_1->Core_ID - Pointer_Processor_2->Core_ID;
+	if (Pointer_Processor_1->Thread_Index != Pointer_Processor_2->Thread_Index) return Pointer_Processor_1->Thread_Index - Pointer_Processor_2->Thread_Index;
+	return Pointer_Processor_1->Processor_ID - Pointer_Processor_2->Processor_ID;
+}
+
+/** Sort the processors so that the first threads of all cores come first, consecutive processors being taken from different packages, then from the different last level caches of each package.
+ * @param Pointer_Entry_1 The first processor.
+ * @param Pointer_Entry_2 The second processor.
+ * @return A negative number if the first processor comes first, a positive number if it comes last.
+ */
+static int AffinityCompareScatter(const void *Pointer_Entry_1, const void *Pointer_Entry_2)
+{
+	const TAffinityTopologyEntry *Pointer_Topology_Entry_1 = Pointer_Entry_1, *Pointer_Topology_Entry_2 = Pointer_Entry_2;
+	
+	if (Pointer_Topology_Entry_1->Processor.Thread_Index != Pointer_Topology_Entry_2->Processor.Thread_Index) return Pointer_Topology_Entry_1->Processor.Thread_Index - Pointer_Topology_Entry_2->Processor.Thread_Index;
+	if (Pointer_Topology_Entry_1->Core_Rank != Pointer_Topology_Entry_2->Core_Rank) return Pointer_Topology_Entry_1->Core_Rank - Pointer_Topology_Entry_2->Core_Rank;
+	if (Pointer_Topology_Entry_1->Cache_Rank != Pointer_Topology_Entry_2->Cache_Rank) return Pointer_Topology_Entry_1->Cache_Rank - Pointer_Topology_Entry_2->Cache_Rank;
+	return Pointer_Topology_Entry_1->Package_Rank - Pointer_Topology_Entry_2->Package_Rank;
+}
+
+/** Choose a processor for each worker among the allowed ones.
+ * @param Topology The allowed processors, the array content is reordered.
+ * @param Processors_Count How many processors are allowed.
+ * @param String_Policy The placement policy (see AffinityComputePlacement()).
+ * @param Workers_Count How many workers must be placed.
+ * @param Placement On output, contain the processor of each worker.
+ * @param Listed_Processors_IDs A scratch array of AFFINITY_PROCESSORS_MAXIMUM_COUNT elements.
+ * @return 0 on success,
+ * @return -1 if the policy is unknown or if the processors list is bad,
+ * @return -2 if a listed processor can't be used or if no processor can be used.
+ */
+static int AffinityPlaceWorkers(TAffinityTopologyEntry Topology[], int Processors_Count, char *String_Policy, int Workers_Count, TAffinityProcessor Placement[], int Listed_Processors_IDs[])
+{
+	TAffinityTopologyEntry *Pointer_Previous_Entry;
+	int Usable_Processors_Count, Listed_Processors_Count, i, j;
+	
+	// Rank the packages, the caches of each package and the cores of each cache in the compact order, the scatter policy taking the same rank in all packages before the next rank
+	qsort(Topology, Processors_Count, sizeof(TAffinityTopologyEntry), AffinityCompareCompact);
+	Topology[0].Package_Rank = 0;
+	Topology[0].Cache_Rank = 0;
+	Topology[0].Core_Rank = 0;
+	for (i = 1; i < Processors_Count; i++)
+	{
+		Pointer_Previous_Entry = &Topology[i - 1];
+		if (Topology[i].Processor.Package_ID != Pointer_Previous_Entry->Processor.Package_ID)
+		{
+			Topology[i].Package_Rank = Pointer_Previous_Entry->Package_Rank + 1;
+			Topology[i].Cache_Rank = 0;
+			Topology[i].Core_Rank = 0;
+		}
+		else if (Topology[i].Processor.Cache_ID != Pointer_Previous_Entry->Processor.Cache_ID)
+		{
+			Topology[i].Package_Rank = Pointer_Previous_Entry->Package_Rank;
+			Topology[i].Cache_Rank = Pointer_Previous_Entry->Cache_Rank + 1;
+			Topology[i].Core_Rank = 0;
+		}
+		else
+		{
+			Topology[i].Package_Rank = Pointer_Previous_Entry->Package_Rank;
+			Topology[i].Cache_Rank = Pointer_Previous_Entry->Cache_Rank;
+			if (Topology[i].Processor.Core_ID != Pointer_Previous_Entry->Processor.Core_ID) Topology[i].Core_Rank = Pointer_Previous_Entry->Core_Rank + 1;
+			else Topology[i].Core_Rank = Pointer_Previous_Entry->Core_Rank;
+		}
+	}
+	
+	// Order the processors the way the policy uses them
+	if (strcmp(String_Policy, "compact") == 0) Usable_Processors_Count = Processors_Count;
+	else if ((strcmp(String_Policy, "scatter") == 0) || (strcmp(String_Policy, "cores") == 0))
+	{
+		qsort(Topology, Processors_Count, sizeof(TAffinityTopologyEntry), AffinityCompareScatter);
+		Usable_Processors_Count = Processors_Count;
+		
+		// All cores first threads come first, so keep only them when the SMT threads must not be used
+		if (String_Policy[0] == 'c')
+		{
+			for (i = 0; i < Processors_Count; i++)
+			{
+				if (Topology[i].Processor.Thread_Index != 0) break;
+			}
+			Usable_Processors_Count = i;
+		}
+	}
+	else
+	{
+		Listed_Processors_Count = AffinityParseList(String_Policy, Listed_Processors_IDs, AFFINITY_PROCESSORS_MAXIMUM_COUNT);
+		if (Listed_Processors_Count <= 0)
+		{
+			LOG(1, "Error : the affinity policy must be compact, scatter, cores or a processors list like 0,2,4-7.\n");
+			return -1;
+		}
+		
+		// Give the workers the listed processors, in list order
+		for (i = 0; i < Workers_Count; i++)
+		{
+			for (j = 0; j < Processors_Count; j++)
+			{
+				if (Topology[j].Processor.Processor_ID == Listed_Processors_IDs[i % Listed_Processors_Count]) break;
+			}
+			if (j == Processors_Count)
+			{
+				LOG(1, "Error : processor %d does not exist or the program is not allowed to run on it.\n", Listed_Processors_IDs[i % Listed_Processors_Count]);
+				return -2;
+			}
+			Placement[i] = Topology[j].Processor;
+		}
+		return 0;
+	}
+	
+	if (Usable_Processors_Count == 0)
+	{
+		LOG(1, "Error : no allowed processor can be used with the %s policy.\n", String_Policy);
+		return -2;
+	}
+	
+	for (i = 0; i < Workers_Count; i++) Placement[i] = Topology[i % Usable_Processors_Count].Processor;
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int AffinityComputePlacement(char *String_Policy, int Workers_Count, TAffinityProcessor Placement[])
+{
+	TAffinityTopologyEntry *Pointer_Topology;
+	int Processors_Count, Return_Value, *Pointer_Processors_IDs;
+	char *String_Siblings_List;
+	
+	// All buffers are allocated for each call, so several placements can be computed at the same time
+	Pointer_Topology = malloc(AFFINITY_PROCESSORS_MAXIMUM_COUNT * sizeof(TAffinityTopologyEntry));
+	Pointer_Processors_IDs = malloc(AFFINITY_PROCESSORS_MAXIMUM_COUNT * sizeof(int));
+	String_Siblings_List = malloc(AFFINITY_SYSFS_FILE_MAXIMUM_LENGTH);
+	if ((Pointer_Topology == NULL) || (Pointer_Processors_IDs == NULL) || (String_Siblings_List == NULL))
+	{
+		LOG(1, "Error : not enough memory to read the processors topology.\n");
+		Return_Value = -2;
+	}
+	else
+	{
+		Processors_Count = AffinityReadTopology(Pointer_Topology, Pointer_Processors_IDs, String_Siblings_List);
+		if (Processors_Count <= 0)
+		{
+			LOG(1, "Error : can't read the processors topology.\n");
+			Return_Value = -2;
+		}
+		else Return_Value = AffinityPlaceWorkers(Pointer_Topology, Processors_Count, String_Policy, Workers_Count, Placement, Pointer_Processors_IDs);
+	}
+	
+	free(Pointer_Topology);
+	free(Pointer_Processors_IDs);
+	free(String_Siblings_List);
+	return Return_Value;
+}
+
+void AffinityShowPlacement(FILE *Pointer_File, char *String_Policy, int Workers_Count, TAffinityProcessor Placement[])
+{
+	int i;
+	
+	fprintf(Pointer_File, "Workers placement (%s) :\n", String_Policy);
+	for (i = 0; i < Workers_Count; i++) fprintf(Pointer_File, "  worker %d : processor %d (package %d, cache %d, core %d, thread %d)\n", i, Placement[i].Processor_ID, Placement[i].Package_ID, Placement[i].Cache_ID, Placement[i].Core_ID, Placement[i].Thread_Index);
+}
@@ -0,0 +1,427 @@
+/** @file Candidates_Board.c
+ * See Candidates_Board.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Candidates_Board.h>
+#include <Configuration.h>
+#include <Grid.h>
+#include <stdint.h>
+#include <string.h>
+
+// The AVX2 kernel can only be built for x86 processors, the other processors always use the scalar grid functions
+#if CONFIGURATION_IS_SIMD_ENABLED && (defined(__x86_64__) || defined(__i386__))
+	#define CANDIDATES_BOARD_IS_AVX2_BUILT 1
+	#include <immintrin.h>
+#else
+	#define CANDIDATES_BOARD_IS_AVX2_BUILT 0
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** Tell that a lane holds no cell. */
+#define CANDIDATES_BOARD_NO_COLUMN 0x80
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+#if CANDIDATES_BOARD_IS_AVX2_BUILT
+	/** The column of the cell held by each lane when looking for the singles of a 9x9 grid. A lane is left unused after each square, so all squares start on a multiple of 4 lanes like the 16x16 ones. This is also the shuffle moving the cells of a row to their lanes (the unused lanes get a zero byte). */
+	static const uint8_t Candidates_Board_Lanes_Columns_9x9[CANDIDATES_BOARD_LANES_COUNT] = {0, 1, 2, CANDIDATES_BOARD_NO_COLUMN, 3, 4, 5, CANDIDATES_BOARD_NO_COLUMN, 6, 7, 8, CANDIDATES_BOARD_NO_COLUMN, CANDIDATES_BOARD_NO_COLUMN, CANDIDATES_BOARD_NO_COLUMN, CANDIDATES_BOARD_NO_COLUMN, CANDIDATES_BOARD_NO_COLUMN};
+	/** The column of the cell held by each lane when looking for the singles of a 16x16 grid. */
+	static const uint8_t Candidates_Board_Lanes_Columns_16x16[CANDIDATES_BOARD_LANES_COUNT] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+	/** Select the lanes of each group of 4 lanes, a group holding the cells of a square row for both grid sizes. */
+	static const uint16_t Candidates_Board_Lanes_Groups_Masks[CANDIDATES_BOARD_LANES_COUNT / 4][CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32))) =
+	{
+		{0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+		{0, 0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0, 0, 0, 0, 0, 0, 0, 0},
+		{0, 0, 0, 0, 0, 0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0, 0, 0, 0},
+		{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF}
+	};
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+#if CANDIDATES_BOARD_IS_AVX2_BUILT
+	/** Add a deduced cell to the singles list, unless it is already listed.
+	 * @param Singles The singles list.
+	 * @param Pointer_Singles_Count The amount of listed singles, it is incremented if the cell is added.
+	 * @param Listed_Numbers The number each cell is listed with, or GRID_EMPTY_CELL_VALUE if the cell is not listed yet.
+	 * @param Row The cell row coordinate.
+	 * @param Column The cell column coordinate.
+	 * @param Number The cell number.
+	 * @return 0 if the cell is already listed with another number (the grid is wrong),
+	 * @return 1 if the cell is listed.
+	 */
+	static inline int CandidatesBoardAddSingle(TCandidatesBoardSingle Singles[], int *Pointer_Singles_Count, uint8_t Listed_Numbers[CANDIDATES_BOARD_LANES_COUNT][CANDIDATES_BOARD_LANES_COUNT], unsigned int Row, unsigned int Column, unsigned int Number)
+	{
+		if (Listed_Numbers[Row][Column] != GRID_EMPTY_CELL_VALUE) return Listed_Numbers[Row][Column] == Number;
+		Listed_Numbers[Row][Column] = Number;
+		
+		Singles[*Pointer_Singles_Count].Row = Row;
+		Singles[*Pointer_Singles_Count].Column = Column;
+		Singles[*Pointer_Singles_Count].Number = Number;
+		(*Pointer_Singles_Count)++;
+		return 1;
+	}
+	
+	/** Count the set bits of each 16-bit lane.
+	 * @param Vector The lanes to count bits.
+	 * @return The bits count of each lane.
+	 */
+	__attribute__((target("avx2"))) static inline __m256i CandidatesBoardPopulationCount(__m256i Vector)
+	{
+		__m256i Lookup_Table, Nibbles_Mask, Bytes_Count;
+		
+		// Count the bits of each nibble with a table lookup
+		Lookup_Table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		Nibbles_Mask = _mm256_set1_epi8(0x0F);
+		Bytes_Count = _mm256_add_epi8(_mm256_shuffle_epi8(Lookup_Table, _mm256_and_si256(Vector, Nibbles_Mask)), _mm256_shuffle_epi8(Lookup_Table, _mm256_and_si256(_mm256_srli_epi16(Vector, 4), Nibbles_Mask)));
+		
+		// Add the two bytes counts of each lane
+		return _mm256_add_epi16(_mm256_and_si256(Bytes_Count, _mm256_set1_epi16(0x00FF)), _mm256_srli_epi16(Bytes_Count, 8));
+	}
+	
+	/** See CandidatesBoardCountCandidates() for description. */
+	__attribute__((target("avx2"))) static void CandidatesBoardCountCandidatesAVX2(TGrid *Pointer_Grid, uint16_t Candidates_Counts[CANDIDATES_BOARD_LANES_COUNT][CANDIDATES_BOARD_LANES_COUNT])
+	{
+		unsigned int Grid_Size, Square_Size, Row, Column, Square_Index;
+		uint16_t Column_Lanes[CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32))) = {0}, Square_Lanes[CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32))) = {0};
+		__m256i Columns_Masks, Squares_Masks, Candidates;
+		
+		// Only square grids made of square squares are handled
+		Grid_Size = Pointer_Grid->Grid_Size;
+		Square_Size = (Grid_Size == 9) ? 3 : 4;
+		
+		// All rows share the same column masks (the grid masks may be wider than the lanes, but the numbers of these grid sizes fit in 16 bits)
+		for (Column = 0; Column < Grid_Size; Column++) Column_Lanes[Column] = GRID_COLUMN_BITMASK(Pointer_Grid, Column);
+		Columns_Masks = _mm256_load_si256((__m256i *) Column_Lanes);
+		Squares_Masks = _mm256_setzero_si256();
+		
+		for (Row = 0; Row < Grid_Size; Row++)
+		{
+			// Spread the masks of the squares crossed by this row band over the corresponding lanes
+			if (Row % Square_Size == 0)
+			{
+				Square_Index = (Row / Square_Size) * (Grid_Size / Square_Size);
+				for (Column = 0; Column < Grid_Size; Column++) Square_Lanes[Column] = GRID_SQUARE_BITMASK(Pointer_Grid, Square_Index + Column / Square_Size);
+				Squares_Masks = _mm256_load_si256((__m256i *) Square_Lanes);
+			}
+			
+			// Eliminate the numbers present in the row, the column and the square of each cell, then count the remaining ones
+			Candidates = _mm256_and_si256(_mm256_and_si256(_mm256_set1_epi16((uint16_t) GRID_ROW_BITMASK(Pointer_Grid, Row)), Columns_Masks), Squares_Masks);
+			_mm256_storeu_si256((__m256i *) Candidates_Counts[Row], CandidatesBoardPopulationCount(Candidates));
+		}
+	}
+	
+	/** Merge the numbers seen by each lane with the numbers seen by another lane, keeping track of the numbers seen at least twice. Both lanes must have seen different cells.
+	 * @param Pointer_Seen_Once The numbers seen at least once by each lane, on output the merged ones.
+	 * @param Pointer_Seen_Twice The numbers seen at least twice by each lane, on output the merged ones.
+	 * @param Other_Seen_Once The numbers seen at least once by the other lane of each lane.
+	 * @param Other_Seen_Twice The numbers seen at least twice by the other lane of each lane.
+	 */
+	__attribute__((target("avx2"))) static inline void CandidatesBoardMergeLanes(__m256i *Pointer_Seen_Once, __m256i *Pointer_Seen_Twice, __m256i Other_Seen_Once, __m256i Other_Seen_Twice)
+	{
+		*Pointer_Seen_Twice = _mm256_or_si256(_mm256_or_si256(*Pointer_Seen_Twice, Other_Seen_Twice), _mm256_and_si256(*Pointer_Seen_Once, Other_Seen_Once));
+		*Pointer_Seen_Once = _mm256_or_si256(*Pointer_Seen_Once, Other_Seen_Once);
+	}
+	
+	/** Merge the numbers seen by each group of 4 consecutive lanes (starting from a multiple of 4), so all lanes of a group see the numbers of the whole group.
+	 * @param Pointer_Seen_Once The numbers seen at least once by each lane, on output the numbers seen by the lane group.
+	 * @param Pointer_Seen_Twice The numbers seen at least twice by each lane, on output the numbers seen by the lane group.
+	 */
+	__attribute__((target("avx2"))) static inline void CandidatesBoardMergeLanesGroups(__m256i *Pointer_Seen_Once, __m256i *Pointer_Seen_Twice)
+	{
+		// Exchange the neighbor lanes, then the neighbor lane pairs
+		CandidatesBoardMergeLanes(Pointer_Seen_Once, Pointer_Seen_Twice, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(*Pointer_Seen_Once, 0xB1), 0xB1), _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(*Pointer_Seen_Twice, 0xB1), 0xB1));
+		CandidatesBoardMergeLanes(Pointer_Seen_Once, Pointer_Seen_Twice, _mm256_shuffle_epi32(*Pointer_Seen_Once, 0xB1), _mm256_shuffle_epi32(*Pointer_Seen_Twice, 0xB1));
+	}
+	
+	/** See CandidatesBoardInitialize() for description. */
+	__attribute__((target("avx2"))) static void CandidatesBoardInitializeAVX2(TCandidatesBoard *Pointer_Board, TGrid *Pointer_Grid)
+	{
+		unsigned int Grid_Size, Square_Size, Row, Column, Lane;
+		uint16_t Column_Lanes[CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32))) = {0}, Square_Lanes[CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32)));
+		const uint8_t *Pointer_Lanes_Columns;
+		__m128i Cells_Shuffle;
+		__m256i Columns_Masks, Squares_Masks = _mm256_setzero_si256(), Empty_Cells;
+		
+		// Only square grids made of square squares are handled
+		Grid_Size = Pointer_Grid->Grid_Size;
+		if (Grid_Size == 9)
+		{
+			Square_Size = 3;
+			Pointer_Lanes_Columns = Candidates_Board_Lanes_Columns_9x9;
+		}
+		else
+		{
+			Square_Size = 4;
+			Pointer_Lanes_Columns = Candidates_Board_Lanes_Columns_16x16;
+		}
+		Pointer_Board->Grid_Size = Grid_Size;
+		Pointer_Board->Square_Size = Square_Size;
+		Pointer_Board->Pointer_Lanes_Columns = Pointer_Lanes_Columns;
+		
+		// All rows share the same column masks, the lanes holding no cell have no allowed number
+		for (Lane = 0; Lane < CANDIDATES_BOARD_LANES_COUNT; Lane++)
+		{
+			Column = Pointer_Lanes_Columns[Lane];
+			if (Column == CANDIDATES_BOARD_NO_COLUMN) continue;
+			Column_Lanes[Lane] = GRID_COLUMN_BITMASK(Pointer_Grid, Column);
+			Pointer_Board->Columns_Lanes[Column] = Lane;
+		}
+		Columns_Masks = _mm256_load_si256((__m256i *) Column_Lanes);
+		Cells_Shuffle = _mm_loadu_si128((__m128i *) Pointer_Lanes_Columns);
+		
+		for (Row = 0; Row < Grid_Size; Row++)
+		{
+			// Spread the masks of the squares crossed by this row band over the corresponding lanes
+			if (Row % Square_Size == 0)
+			{
+				for (Lane = 0; Lane < CANDIDATES_BOARD_LANES_COUNT; Lane++)
+				{
+					Column = Pointer_Lanes_Columns[Lane];
+					if (Column == CANDIDATES_BOARD_NO_COLUMN) Square_Lanes[Lane] = 0;
+					else Square_Lanes[Lane] = GRID_SQUARE_BITMASK(Pointer_Grid, (Row / Square_Size) * (Grid_Size / Square_Size) + Column / Square_Size);
+				}
+				Squares_Masks = _mm256_load_si256((__m256i *) Square_Lanes);
+			}
+			
+			// Only the empty cells have allowed numbers (the lanes holding no cell get a zero byte, which is not the empty cell value)
+			Empty_Cells = _mm256_cvtepi8_epi16(_mm_cmpeq_epi8(_mm_shuffle_epi8(_mm_loadu_si128((__m128i *) &GRID_CELL(Pointer_Grid, Row, 0)), Cells_Shuffle), _mm_set1_epi8((char) GRID_EMPTY_CELL_VALUE)));
+			_mm256_store_si256((__m256i *) Pointer_Board->Candidates[Row], _mm256_and_si256(_mm256_and_si256(_mm256_and_si256(_mm256_set1_epi16((uint16_t) GRID_ROW_BITMASK(Pointer_Grid, Row)), Columns_Masks), Squares_Masks), Empty_Cells));
+		}
+	}
+	
+	/** See CandidatesBoardFillCell() for description. */
+	__attribute__((target("avx2"))) static void CandidatesBoardFillCellAVX2(TCandidatesBoard *Pointer_Board, unsigned int Row, unsigned int Column, unsigned int Number)
+	{
+		unsigned int Lane, Band_Row, Band_Last_Row, Grid_Size = Pointer_Board->Grid_Size;
+		uint16_t Bitmask_Kept_Numbers;
+		__m256i Number_Mask, Square_Number_Mask;
+		
+		// Remove the number from the row cells
+		Number_Mask = _mm256_set1_epi16(1 << Number);
+		_mm256_store_si256((__m256i *) Pointer_Board->Candidates[Row], _mm256_andnot_si256(Number_Mask, _mm256_load_si256((__m256i *) Pointer_Board->Candidates[Row])));
+		
+		// Remove the number from the square cells, the square lanes being the lane group of the cell
+		Lane = Pointer_Board->Columns_Lanes[Column];
+		Square_Number_Mask = _mm256_and_si256(Number_Mask, _mm256_load_si256((__m256i *) Candidates_Board_Lanes_Groups_Masks[Lane / 4]));
+		Band_Row = Row - Row % Pointer_Board->Square_Size;
+		Band_Last_Row = Band_Row + Pointer_Board->Square_Size;
+		for (; Band_Row < Band_Last_Row; Band_Row++) _mm256_store_si256((__m256i *) Pointer_Board->Candidates[Band_Row], _mm256_andnot_si256(Square_Number_Mask, _mm256_load_si256((__m256i *) Pointer_Board->Candidates[Band_Row])));
+		
+		// Remove the number from the column cells
+		Bitmask_Kept_Numbers = ~(1 << Number);
+		for (Band_Row = 0; Band_Row < Grid_Size; Band_Row++) Pointer_Board->Candidates[Band_Row][Lane] &= Bitmask_Kept_Numbers;
+		
+		// The filled cell has no allowed number anymore
+		Pointer_Board->Candidates[Row][Lane] = 0;
+	}
+	
+	/** See CandidatesBoardFindSingles() for description. */
+	__attribute__((target("avx2"))) static int CandidatesBoardFindSinglesAVX2(TCandidatesBoard *Pointer_Board, TGrid *Pointer_Grid, TGridPropagationLevel Propagation_Level, TCandidatesBoardSingle Singles[CANDIDATES_BOARD_SINGLES_MAXIMUM_COUNT])
+	{
+		unsigned int Grid_Size, Square_Size, Row, Column, Lane, Band_Row, Group_Lane, Square_Index = 0, Number;
+		int Singles_Count = 0;
+		uint32_t Lanes_Bitmask;
+		uint16_t Seen_Once_Lanes[CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32))), Seen_Twice_Lanes[CANDIDATES_BOARD_LANES_COUNT] __attribute__((aligned(32)));
+		uint16_t Bitmask_Seen_Once, Bitmask_Hidden_Singles, Bitmask_Unit;
+		uint8_t Listed_Numbers[CANDIDATES_BOARD_LANES_COUNT][CANDIDATES_BOARD_LANES_COUNT];
+		const uint8_t *Pointer_Lanes_Columns;
+		__m128i Cells_Shuffle;
+		__m256i Zero, Empty_Cells, Candidates, Number_Mask, Row_Seen_Once, Row_Seen_Twice, Columns_Seen_Once, Columns_Seen_Twice, Squares_Seen_Once = _mm256_setzero_si256(), Squares_Seen_Twice = _mm256_setzero_si256();
+		
+		Grid_Size = Pointer_Board->Grid_Size;
+		Square_Size = Pointer_Board->Square_Size;
+		Pointer_Lanes_Columns = Pointer_Board->Pointer_Lanes_Columns;
+		Cells_Shuffle = _mm_loadu_si128((__m128i *) Pointer_Lanes_Columns);
+		Zero = _mm256_setzero_si256();
+		Columns_Seen_Once = Zero;
+		Columns_Seen_Twice = Zero;
+		memset(Listed_Numbers, GRID_EMPTY_CELL_VALUE, sizeof(Listed_Numbers));
+		
+		for (Row = 0; Row < Grid_Size; Row++)
+		{
+			// Start the squares of a new row band
+			if (Row % Square_Size == 0)
+			{
+				Square_Index = (Row / Square_Size) * (Grid_Size / Square_Size);
+				Squares_Seen_Once = Zero;
+				Squares_Seen_Twice = Zero;
+			}
+			
+			// The board has no allowed number for the filled cells, so the empty cells are found in the grid to detect the empty cells without allowed number (the lanes holding no cell get a zero byte, which is not the empty cell value)
+			Empty_Cells = _mm256_cvtepi8_epi16(_mm_cmpeq_epi8(_mm_shuffle_epi8(_mm_loadu_si128((__m128i *) &GRID_CELL(Pointer_Grid, Row, 0)), Cells_Shuffle), _mm_set1_epi8((char) GRID_EMPTY_CELL_VALUE)));
+			Candidates = _mm256_load_si256((__m256i *) Pointer_Board->Candidates[Row]);
+			
+			// An empty cell with no allowed number can't be filled
+			if (!_mm256_testz_si256(_mm256_cmpeq_epi16(Candidates, Zero), Empty_Cells)) return -1;
+			if (Propagation_Level < GRID_PROPAGATION_LEVEL_NAKED_SINGLES) continue;
+			
+			// Clearing the lowest bit of a naked single leaves no bit
+			Lanes_Bitmask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi16(_mm256_and_si256(Candidates, _mm256_sub_epi16(Candidates, _mm256_set1_epi16(1))), Zero), Empty_Cells));
+			while (Lanes_Bitmask != 0)
+			{
+				Lane = __builtin_ctz(Lanes_Bitmask) / 2; // Each lane sets two bits
+				Lanes_Bitmask &= Lanes_Bitmask - 1;
+				Lanes_Bitmask &= Lanes_Bitmask - 1;
+				if (!CandidatesBoardAddSingle(Singles, &Singles_Count, Listed_Numbers, Row, Pointer_Lanes_Columns[Lane], __builtin_ctz(Pointer_Board->Candidates[Row][Lane]))) return -1;
+			}
+			if (Propagation_Level < GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES) continue;
+			
+			// Accumulate the numbers allowed by the cells of each column and of each square of the band
+			CandidatesBoardMergeLanes(&Columns_Seen_Once, &Columns_Seen_Twice, Candidates, Zero);
+			CandidatesBoardMergeLanes(&Squares_Seen_Once, &Squares_Seen_Twice, Candidates, Zero);
+			
+			// Merge all lanes of the row, each step exchanging twice more lanes than the previous one
+			Row_Seen_Once = Candidates;
+			Row_Seen_Twice = Zero;
+			CandidatesBoardMergeLanesGroups(&Row_Seen_Once, &Row_Seen_Twice);
+			CandidatesBoardMergeLanes(&Row_Seen_Once, &Row_Seen_Twice, _mm256_shuffle_epi32(Row_Seen_Once, 0x4E), _mm256_shuffle_epi32(Row_Seen_Twice, 0x4E));
+			CandidatesBoardMergeLanes(&Row_Seen_Once, &Row_Seen_Twice, _mm256_permute4x64_epi64(Row_Seen_Once, 0x4E), _mm256_permute4x64_epi64(Row_Seen_Twice, 0x4E));
+			
+			// A number missing from the row must be allowed somewhere, and it must be put in its only allowed cell
+			Bitmask_Unit = GRID_ROW_BITMASK(Pointer_Grid, Row);
+			Bitmask_Seen_Once = _mm256_extract_epi16(Row_Seen_Once, 0);
+			if (Bitmask_Unit & ~Bitmask_Seen_Once) return -1;
+			Bitmask_Hidden_Singles = Bitmask_Seen_Once & ~_mm256_extract_epi16(Row_Seen_Twice, 0);
+			while (Bitmask_Hidden_Singles != 0)
+			{
+				Number = __builtin_ctz(Bitmask_Hidden_Singles);
+				Bitmask_Hidden_Singles &= Bitmask_Hidden_Singles - 1;
+				
+				Number_Mask = _mm256_set1_epi16(1 << Number);
+				Lane = __builtin_ctz(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(Candidates, Number_Mask), Number_Mask))) / 2;
+				if (!CandidatesBoardAddSingle(Singles, &Singles_Count, Listed_Numbers, Row, Pointer_Lanes_Columns[Lane], Number)) return -1;
+			}
+			
+			// The squares of the band are complete after their last row
+			if (Row % Square_Size != Square_Size - 1) continue;
+			CandidatesBoardMergeLanesGroups(&Squares_Seen_Once, &Squares_Seen_Twice);
+			_mm256_store_si256((__m256i *) Seen_Once_Lanes, Squares_Seen_Once);
+			_mm256_store_si256((__m256i *) Seen_Twice_Lanes, Squares_Seen_Twice);
+			for (Group_Lane = 0; Group_Lane < CANDIDATES_BOARD_LANES_COUNT; Group_Lane += 4)
+			{
+				Column = Pointer_Lanes_Columns[Group_Lane];
+				if (Column == CANDIDATES_BOARD_NO_COLUMN) break;
+				
+				Bitmask_Unit = GRID_SQUARE_BITMASK(Pointer_Grid, Square_Index + Column / Square_Size);
+				if (Bitmask_Unit & ~Seen_Once_Lanes[Group_Lane]) return -1;
+				Bitmask_Hidden_Singles = Seen_Once_Lanes[Group_Lane] & ~Seen_Twice_Lanes[Group_Lane];
+				while (Bitmask_Hidden_Singles != 0)
+				{
+					Number = __builtin_ctz(Bitmask_Hidden_Singles);
+					Bitmask_Hidden_Singles &= Bitmask_Hidden_Singles - 1;
+					
+					// Find the square cell allowing the number
+					for (Band_Row = Row + 1 - Square_Size; Band_Row <= Row; Band_Row++)
+					{
+						for (Lane = Group_Lane; Lane < Group_Lane + 4; Lane++)
+						{
+							if (!(Pointer_Board->Candidates[Band_Row][Lane] & (1 << Number))) continue;
+							if (!CandidatesBoardAddSingle(Singles, &Singles_Count, Listed_Numbers, Band_Row, Pointer_Lanes_Columns[Lane], Number)) return -1;
+						}
+					}
+				}
+			}
+		}
+		if (Propagation_Level < GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES) return Singles_Count;
+		
+		// Check the columns now that all rows have been seen
+		_mm256_store_si256((__m256i *) Seen_Once_Lanes, Columns_Seen_Once);
+		_mm256_store_si256((__m256i *) Seen_Twice_Lanes, Columns_Seen_Twice);
+		for (Lane = 0; Lane < CANDIDATES_BOARD_LANES_COUNT; Lane++)
+		{
+			Column = Pointer_Lanes_Columns[Lane];
+			if (Column == CANDIDATES_BOARD_NO_COLUMN) continue;
+			
+			Bitmask_Unit = GRID_COLUMN_BITMASK(Pointer_Grid, Column);
+			if (Bitmask_Unit & ~Seen_Once_Lanes[Lane]) return -1;
+			Bitmask_Hidden_Singles = Seen_Once_Lanes[Lane] & ~Seen_Twice_Lanes[Lane];
+			while (Bitmask_Hidden_Singles != 0)
+			{
+				Number = __builtin_ctz(Bitmask_Hidden_Singles);
+				Bitmask_Hidden_Singles &= Bitmask_Hidden_Singles - 1;
+				
+				// Find the column cell allowing the number
+				for (Row = 0; Row < Grid_Size; Row++)
+				{
+					if (!(Pointer_Board->Candidates[Row][Lane] & (1 << Number))) continue;
+					if (!CandidatesBoardAddSingle(Singles, &Singles_Count, Listed_Numbers, Row, Column, Number)) return -1;
+					break;
+				}
+			}
+		}
+		
+		return Singles_Count;
+	}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int CandidatesBoardIsAvailable(unsigned int Grid_Size)
+{
+	#if CANDIDATES_BOARD_IS_AVX2_BUILT
+		// A whole row must fit in a vector register, and each square must be square
+		if ((Grid_Size != 9) && (Grid_Size != 16)) return 0;
+		
+		// Check the processor capabilities
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) return 1;
+	#else
+		(void) Grid_Size; // Avoid an unused parameter warning
+	#endif
+	return 0;
+}
+
+void CandidatesBoardCountCandidates(TGrid *Pointer_Grid, uint16_t Candidates_Counts[CANDIDATES_BOARD_LANES_COUNT][CANDIDATES_BOARD_LANES_COUNT])
+{
+	#if CANDIDATES_BOARD_IS_AVX2_BUILT
+		CandidatesBoardCountCandidatesAVX2(Pointer_Grid, Candidates_Counts);
+	#else
+		// This function can't be called on processors without SIMD kernel, the counts are cleared to avoid an uninitialized variable warning
+		(void) Pointer_Grid;
+		memset(Candidates_Counts, 0, sizeof(uint16_t) * CANDIDATES_BOARD_LANES_COUNT * CANDIDATES_BOARD_LANES_COUNT);
+	#endif
+}
+
+void CandidatesBoardInitialize(TCandidatesBoard *Pointer_Board, TGrid *Pointer_Grid)
+{
+	#if CANDIDATES_BOARD_IS_AVX2_BUILT
+		CandidatesBoardInitializeAVX2(Pointer_Board, Pointer_Grid);
+	#else
+		// This function can't be called on processors without SIMD kernel
+		(void) Pointer_Grid;
+		memset(Pointer_Board, 0, sizeof(TCandidatesBoard));
+	#endif
+}
+
+void CandidatesBoardFillCell(TCandidatesBoard *Pointer_Board, unsigned int Row, unsigned int Column, unsigned int Number)
+{
+	#if CANDIDATES_BOARD_IS_AVX2_BUILT
+		CandidatesBoardFillCellAVX2(Pointer_Board, Row, Column, Number);
+	#else
+		// This function can't be called on processors without SIMD kernel
+		(void) Pointer_Board;
+		(void) Row;
+		(void) Column;
+		(void) Number;
+	#endif
+}
+
+int CandidatesBoardFindSingles(TCandidatesBoard *Pointer_Board, TGrid *Pointer_Grid, TGridPropagationLevel Propagation_Level, TCandidatesBoardSingle Singles[CANDIDATES_BOARD_SINGLES_MAXIMUM_COUNT])
+{
+	#if CANDIDATES_BOARD_IS_AVX2_BUILT
+		return CandidatesBoardFindSinglesAVX2(Pointer_Board, Pointer_Grid, Propagation_Level, Singles);
+	#else
+		// This function can't be called on processors without SIMD kernel
+		(void) Pointer_Board;
+		(void) Pointer_Grid;
+		(void) Propagation_Level;
+		(void) Singles;
+		return 0;
+	#endif
+}
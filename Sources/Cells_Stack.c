@@ -78,3 +78,29 @@ void CellsStackRemoveTop(TCellsStack *Pointer_Stack)
 	// Make sure stack is not empty to avoid underflowing it
 	if (Pointer_Stack->Stack_Index > 0) Pointer_Stack->Stack_Index--;
 }
+
+int CellsStackRemoveCell(TCellsStack *Pointer_Stack, int Cell_Row, int Cell_Column)
+{
+	int i;
+	TCellsStackCellCoordinates *Pointer_Cells_Coordinates;
+	
+	Pointer_Cells_Coordinates = Pointer_Stack->Cells_Coordinates;
+	
+	// Start searching from the top as recently pushed cells are more likely to be removed
+	for (i = Pointer_Stack->Stack_Index - 1; i >= 0; i--)
+	{
+		if ((Pointer_Cells_Coordinates[i].Row == Cell_Row) && (Pointer_Cells_Coordinates[i].Column == Cell_Column))
+		{
+			// Move the stack top to the freed location
+			Pointer_Stack->Stack_Index--;
+			Pointer_Cells_Coordinates[i] = Pointer_Cells_Coordinates[Pointer_Stack->Stack_Index];
+			
+			#if CELLS_STACK_IS_DEBUG_ENABLED
+				CellsStackShow(Pointer_Stack);
+			#endif
+			return 1;
+		}
+	}
+	
+	return 0;
+}
@@ -0,0 +1,233 @@
+/** @file Corpus.c
+ * See Corpus.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Corpus.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <Log.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** Enable or disable this module debug messages. */
+#define CORPUS_IS_DEBUG_ENABLED 0
+
+/** The smallest part of the file a counting thread is given, the files smaller than twice this size are counted by the calling thread. */
+#define CORPUS_MINIMUM_CHUNK_SIZE (4 * 1024 * 1024)
+
+/** Tell whether a character ends a line.
+ * @param Character The character to check.
+ */
+#define CORPUS_IS_NEW_LINE_CHARACTER(Character) (((Character) == '\n') || ((Character) == '\r'))
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A thread counting the records of a chunk. */
+typedef struct
+{
+	TCorpus *Pointer_Corpus; //!< The corpus the chunk belongs to.
+	TCorpusChunk *Pointer_Chunk; //!< The chunk, whose offsets delimit the file part given to the thread until it is counted.
+	pthread_t Thread; //!< The thread counting the chunk records.
+} TCorpusCountingThread;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Count the records starting in a file part. A record starts after a new line character (or at the file beginning), unless the line is empty, so the parts boundaries do not need to be aligned on the lines. The chunk is then moved to the first line starting in the part, so the chunks are made of whole records. A part containing no new line character gets an empty chunk, as its line belongs to the previous chunk.
+ * @param Pointer_Argument The counting thread.
+ * @return Unused value.
+ */
+static void *CorpusCountChunkRecords(void *Pointer_Argument)
+{
+	TCorpusCountingThread *Pointer_Counting_Thread = Pointer_Argument;
+	TCorpusChunk *Pointer_Chunk = Pointer_Counting_Thread->Pointer_Chunk;
+	const char *Pointer_Data = Pointer_Counting_Thread->Pointer_Corpus->Pointer_Data, *Pointer_Character, *Pointer_Chunk_End;
+	size_t File_Size = Pointer_Counting_Thread->Pointer_Corpus->Size;
+	unsigned long long Records_Count = 0;
+	
+	// memchr() is much faster than testing each character
+	Pointer_Character = &Pointer_Data[Pointer_Chunk->Starting_Offset];
+	Pointer_Chunk_End = &Pointer_Data[Pointer_Chunk->Ending_Offset];
+	
+	// The first record has no new line character before it, the other chunks start after the first new line character of their part (it may be found in a following part)
+	if (Pointer_Chunk->Starting_Offset == 0)
+	{
+		if (!CORPUS_IS_NEW_LINE_CHARACTER(Pointer_Data[0])) Records_Count++;
+	}
+	else
+	{
+		Pointer_Character = memchr(Pointer_Character, '\n', File_Size - Pointer_Chunk->Starting_Offset);
+		if (Pointer_Character == NULL) Pointer_Chunk->Starting_Offset = File_Size;
+		else Pointer_Chunk->Starting_Offset = Pointer_Character + 1 - Pointer_Data;
+		if ((Pointer_Character == NULL) || (Pointer_Character >= Pointer_Chunk_End)) Pointer_Character = Pointer_Chunk_End;
+	}
+	
+	while ((Pointer_Character = memchr(Pointer_Character, '\n', Pointer_Chunk_End - Pointer_Character)) != NULL)
+	{
+		Pointer_Character++;
+		if ((Pointer_Character < &Pointer_Data[File_Size]) && !CORPUS_IS_NEW_LINE_CHARACTER(*Pointer_Character)) Records_Count++;
+	}
+	
+	Pointer_Chunk->Records_Count = Records_Count;
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int CorpusOpen(TCorpus *Pointer_Corpus, char *String_File_Name, int Threads_Count)
+{
+	int File_Descriptor, Chunks_Count, Created_Threads_Count, i, Return_Value = 0;
+	struct stat File_Status;
+	void *Pointer_Mapping;
+	TCorpusChunk *Pointer_Chunks;
+	TCorpusCountingThread *Pointer_Counting_Threads;
+	
+	memset(Pointer_Corpus, 0, sizeof(TCorpus));
+	
+	// Map the whole file, the mapping stays valid after the file is closed
+	File_Descriptor = open(String_File_Name, O_RDONLY);
+	if (File_Descriptor == -1)
+	{
+		LOG(1, "Error : can't open the corpus file %s.\n", String_File_Name);
+		return -1;
+	}
+	if (fstat(File_Descriptor, &File_Status) != 0)
+	{
+		LOG(1, "Error : can't get the corpus file %s size.\n", String_File_Name);
+		close(File_Descriptor);
+		return -1;
+	}
+	if (File_Status.st_size == 0) // An empty file can't be mapped
+	{
+		close(File_Descriptor);
+		return 0;
+	}
+	Pointer_Mapping = mmap(NULL, File_Status.st_size, PROT_READ, MAP_PRIVATE, File_Descriptor, 0);
+	close(File_Descriptor);
+	if (Pointer_Mapping == MAP_FAILED)
+	{
+		LOG(1, "Error : can't map the corpus file %s.\n", String_File_Name);
+		return -1;
+	}
+	madvise(Pointer_Mapping, File_Status.st_size, MADV_SEQUENTIAL); // This is only a hint, so a failure does not matter
+	Pointer_Corpus->Pointer_Data = Pointer_Mapping;
+	Pointer_Corpus->Size = File_Status.st_size;
+	
+	// Split the file in chunks big enough for a thread to be worth creating
+	Chunks_Count = Pointer_Corpus->Size / CORPUS_MINIMUM_CHUNK_SIZE;
+	if (Chunks_Count > Threads_Count) Chunks_Count = Threads_Count;
+	if (Chunks_Count < 1) Chunks_Count = 1;
+	Pointer_Chunks = malloc(Chunks_Count * sizeof(TCorpusChunk));
+	Pointer_Counting_Threads = malloc(Chunks_Count * sizeof(TCorpusCountingThread));
+	if ((Pointer_Chunks == NULL) || (Pointer_Counting_Threads == NULL))
+	{
+		LOG(1, "Error : not enough memory to split the corpus file %s.\n", String_File_Name);
+		free(Pointer_Chunks);
+		free(Pointer_Counting_Threads);
+		CorpusClose(Pointer_Corpus);
+		return -1;
+	}
+	Pointer_Corpus->Pointer_Chunks = Pointer_Chunks;
+	Pointer_Corpus->Chunks_Count = Chunks_Count;
+	for (i = 0; i < Chunks_Count; i++)
+	{
+		Pointer_Chunks[i].Starting_Offset = Pointer_Corpus->Size / Chunks_Count * i;
+		if (i == Chunks_Count - 1) Pointer_Chunks[i].Ending_Offset = Pointer_Corpus->Size;
+		else Pointer_Chunks[i].Ending_Offset = Pointer_Corpus->Size / Chunks_Count * (i + 1);
+		Pointer_Counting_Threads[i].Pointer_Corpus = Pointer_Corpus;
+		Pointer_Counting_Threads[i].Pointer_Chunk = &Pointer_Chunks[i];
+	}
+	
+	// Count the last chunk records while the other threads count the other chunks
+	for (Created_Threads_Count = 0; Created_Threads_Count < Chunks_Count - 1; Created_Threads_Count++)
+	{
+		if (pthread_create(&Pointer_Counting_Threads[Created_Threads_Count].Thread, NULL, CorpusCountChunkRecords, &Pointer_Counting_Threads[Created_Threads_Count]) != 0)
+		{
+			LOG(1, "Error : failed to create the corpus records counting thread %d.\n", Created_Threads_Count);
+			Return_Value = -2;
+			break;
+		}
+	}
+	if (Return_Value == 0) CorpusCountChunkRecords(&Pointer_Counting_Threads[Chunks_Count - 1]);
+	
+	// Gather the counts, each chunk ending where the next one starts
+	for (i = 0; i < Created_Threads_Count; i++) pthread_join(Pointer_Counting_Threads[i].Thread, NULL);
+	if (Return_Value == 0)
+	{
+		for (i = 0; i < Chunks_Count; i++)
+		{
+			if (i < Chunks_Count - 1) Pointer_Chunks[i].Ending_Offset = Pointer_Chunks[i + 1].Starting_Offset;
+			Pointer_Chunks[i].Read_Offset = Pointer_Chunks[i].Starting_Offset;
+			Pointer_Corpus->Records_Count += Pointer_Chunks[i].Records_Count;
+		}
+		LOG(CORPUS_IS_DEBUG_ENABLED, "Counted %llu records in %d chunks.\n", Pointer_Corpus->Records_Count, Chunks_Count);
+	}
+	else CorpusClose(Pointer_Corpus);
+	
+	free(Pointer_Counting_Threads);
+	return Return_Value;
+}
+
+int CorpusReadGrid(TCorpus *Pointer_Corpus, TGrid *Pointer_Grid)
+{
+	int Result;
+	
+	// Read the chunks one after the other
+	while (Pointer_Corpus->Read_Chunk_Index < Pointer_Corpus->Chunks_Count)
+	{
+		Result = CorpusReadChunkGrid(Pointer_Corpus, Pointer_Corpus->Read_Chunk_Index, Pointer_Grid);
+		if (Result != 0) return Result;
+		Pointer_Corpus->Read_Chunk_Index++;
+	}
+	
+	return 0;
+}
+
+int CorpusReadChunkGrid(TCorpus *Pointer_Corpus, int Chunk_Index, TGrid *Pointer_Grid)
+{
+	TCorpusChunk *Pointer_Chunk = &Pointer_Corpus->Pointer_Chunks[Chunk_Index];
+	const char *Pointer_Record, *Pointer_Record_End;
+	size_t Length;
+	int Result;
+	
+	while (Pointer_Chunk->Read_Offset < Pointer_Chunk->Ending_Offset)
+	{
+		// Find the record end, the chunk last record ends with the new line character preceding the next chunk
+		Pointer_Record = &Pointer_Corpus->Pointer_Data[Pointer_Chunk->Read_Offset];
+		Pointer_Record_End = memchr(Pointer_Record, '\n', Pointer_Chunk->Ending_Offset - Pointer_Chunk->Read_Offset);
+		if (Pointer_Record_End == NULL) Length = Pointer_Chunk->Ending_Offset - Pointer_Chunk->Read_Offset; // The last line may have no new line character
+		else Length = Pointer_Record_End - Pointer_Record;
+		Pointer_Chunk->Read_Offset += Length + 1;
+		
+		// Silently ignore empty lines, like the records counting
+		if ((Length == 0) || CORPUS_IS_NEW_LINE_CHARACTER(Pointer_Record[0])) continue;
+		while (Pointer_Record[Length - 1] == '\r') Length--;
+		
+		// A too long record can't match a grid size anyway
+		if (Length > UINT_MAX) Length = UINT_MAX;
+		Result = GridLoadFromCorpusRecord(Pointer_Grid, Pointer_Record, Length);
+		if (Result != 0) return Result;
+		return 1;
+	}
+	
+	return 0;
+}
+
+void CorpusClose(TCorpus *Pointer_Corpus)
+{
+	if (Pointer_Corpus->Pointer_Data != NULL) munmap((void *) Pointer_Corpus->Pointer_Data, Pointer_Corpus->Size);
+	Pointer_Corpus->Pointer_Data = NULL;
+	Pointer_Corpus->Size = 0;
+	free(Pointer_Corpus->Pointer_Chunks);
+	Pointer_Corpus->Pointer_Chunks = NULL;
+	Pointer_Corpus->Chunks_Count = 0;
+}
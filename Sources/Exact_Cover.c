@@ -0,0 +1,291 @@
+/** @file Exact_Cover.c
+ * See Exact_Cover.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Exact_Cover.h>
+#include <Grid.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** How many nodes a matrix row has (a candidate satisfies a cell, a row, a column and a square constraint). */
+#define EXACT_COVER_ROW_NODES_COUNT 4
+
+/** Get the first node of the row containing a node.
+ * @param Node The node index.
+ * @return The first node index.
+ */
+#define EXACT_COVER_GET_ROW_FIRST_NODE(Node) ((Node) & ~(EXACT_COVER_ROW_NODES_COUNT - 1))
+
+/** Get the next node of a row, wrapping to the first row node.
+ * @param Node The node index.
+ * @param Offset How many nodes to skip, in range [1; EXACT_COVER_ROW_NODES_COUNT - 1].
+ * @return The row node index.
+ */
+#define EXACT_COVER_GET_ROW_NEXT_NODE(Node, Offset) (EXACT_COVER_GET_ROW_FIRST_NODE(Node) + (((Node) + (Offset)) & (EXACT_COVER_ROW_NODES_COUNT - 1)))
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Make sure an array can hold the requested elements count, keeping its content.
+ * @param Pointer_Pointer_Array The array, it is reallocated if it is too small.
+ * @param Pointer_Capacity The array capacity in elements, it is updated if the array is reallocated.
+ * @param Elements_Count How many elements the array must hold.
+ * @param Element_Size The size of an element in bytes.
+ * @return 0 on success,
+ * @return -1 if there is not enough memory (the array is left untouched).
+ */
+static int ExactCoverReserve(void **Pointer_Pointer_Array, int *Pointer_Capacity, int Elements_Count, size_t Element_Size)
+{
+	void *Pointer_Array;
+	
+	if (Elements_Count <= *Pointer_Capacity) return 0;
+	
+	Pointer_Array = realloc(*Pointer_Pointer_Array, Elements_Count * Element_Size);
+	if (Pointer_Array == NULL) return -1;
+	*Pointer_Pointer_Array = Pointer_Array;
+	*Pointer_Capacity = Elements_Count;
+	return 0;
+}
+
+/** Add a column to the end of the uncovered columns list.
+ * @param Pointer_Matrix The matrix.
+ * @param Column The column to add.
+ */
+static inline void ExactCoverAppendColumn(TExactCoverMatrix *Pointer_Matrix, int Column)
+{
+	TExactCoverColumn *Pointer_Columns = Pointer_Matrix->Pointer_Columns;
+	int Root = Pointer_Matrix->Columns_Count, Last_Column;
+	
+	Last_Column = Pointer_Columns[Root].Left;
+	Pointer_Columns[Last_Column].Right = Column;
+	Pointer_Columns[Column].Left = Last_Column;
+	Pointer_Columns[Column].Right = Root;
+	Pointer_Columns[Root].Left = Column;
+}
+
+/** Add a node to the bottom of a column.
+ * @param Pointer_Matrix The matrix.
+ * @param Node The node to add.
+ * @param Column The column.
+ */
+static inline void ExactCoverAppendNode(TExactCoverMatrix *Pointer_Matrix, int Node, int Column)
+{
+	TExactCoverNode *Pointer_Nodes = Pointer_Matrix->Pointer_Nodes;
+	
+	Pointer_Nodes[Node].Column = Column;
+	Pointer_Nodes[Node].Up = Pointer_Nodes[Column].Up;
+	Pointer_Nodes[Node].Down = Column;
+	Pointer_Nodes[Pointer_Nodes[Column].Up].Down = Node;
+	Pointer_Nodes[Column].Up = Node;
+	Pointer_Matrix->Pointer_Columns[Column].Size++;
+}
+
+/** Remove a column from the uncovered columns list, and remove its rows from the other columns.
+ * @param Pointer_Matrix The matrix.
+ * @param Column The column to cover.
+ */
+static inline void ExactCoverCoverColumn(TExactCoverMatrix *Pointer_Matrix, int Column)
+{
+	TExactCoverNode *Pointer_Nodes = Pointer_Matrix->Pointer_Nodes;
+	TExactCoverColumn *Pointer_Columns = Pointer_Matrix->Pointer_Columns;
+	int Row_Node, Node, i;
+	
+	Pointer_Columns[Pointer_Columns[Column].Left].Right = Pointer_Columns[Column].Right;
+	Pointer_Columns[Pointer_Columns[Column].Right].Left = Pointer_Columns[Column].Left;
+	
+	for (Row_Node = Pointer_Nodes[Column].Down; Row_Node != Column; Row_Node = Pointer_Nodes[Row_Node].Down)
+	{
+		for (i = 1; i < EXACT_COVER_ROW_NODES_COUNT; i++)
+		{
+			Node = EXACT_COVER_GET_ROW_NEXT_NODE(Row_Node, i);
+			Pointer_Nodes[Pointer_Nodes[Node].Up].Down = Pointer_Nodes[Node].Down;
+			Pointer_Nodes[Pointer_Nodes[Node].Down].Up = Pointer_Nodes[Node].Up;
+			Pointer_Columns[Pointer_Nodes[Node].Column].Size--;
+		}
+	}
+}
+
+/** Undo ExactCoverCoverColumn(), restoring the nodes in the reverse order they were removed.
+ * @param Pointer_Matrix The matrix.
+ * @param Column The column to uncover.
+ */
+static inline void ExactCoverUncoverColumn(TExactCoverMatrix *Pointer_Matrix, int Column)
+{
+	TExactCoverNode *Pointer_Nodes = Pointer_Matrix->Pointer_Nodes;
+	TExactCoverColumn *Pointer_Columns = Pointer_Matrix->Pointer_Columns;
+	int Row_Node, Node, i;
+	
+	for (Row_Node = Pointer_Nodes[Column].Up; Row_Node != Column; Row_Node = Pointer_Nodes[Row_Node].Up)
+	{
+		for (i = EXACT_COVER_ROW_NODES_COUNT - 1; i >= 1; i--)
+		{
+			Node = EXACT_COVER_GET_ROW_NEXT_NODE(Row_Node, i);
+			Pointer_Columns[Pointer_Nodes[Node].Column].Size++;
+			Pointer_Nodes[Pointer_Nodes[Node].Up].Down = Node;
+			Pointer_Nodes[Pointer_Nodes[Node].Down].Up = Node;
+		}
+	}
+	
+	Pointer_Columns[Pointer_Columns[Column].Left].Right = Column;
+	Pointer_Columns[Pointer_Columns[Column].Right].Left = Column;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ExactCoverBuildMatrix(TExactCoverMatrix *Pointer_Matrix, TGrid *Pointer_Grid)
+{
+	int Size = Pointer_Grid->Grid_Size, Cells_Count = Size * Size, Empty_Cells_Count = Pointer_Grid->Empty_Cells_Count, Rows_Count = 0, Columns_Count, Row, Column, Square, Number, i, Node;
+	TGridBitmask Bitmask_Missing_Numbers;
+	TCellsStackCellCoordinates *Pointer_Cell_Coordinates;
+	TExactCoverCandidate *Pointer_Candidate;
+	
+	// Each empty cell allowed number is a row
+	for (i = 0; i < Empty_Cells_Count; i++)
+	{
+		Pointer_Cell_Coordinates = &GRID_GET_EMPTY_CELLS(Pointer_Grid)[i];
+		Rows_Count += GRID_BITMASK_COUNT_NUMBERS(GridGetCellMissingNumbers(Pointer_Grid, Pointer_Cell_Coordinates->Row, Pointer_Cell_Coordinates->Column));
+	}
+	
+	// The columns are the cells, then the numbers of each row, column and square (the column headers count is a multiple of 4, so the row nodes are aligned)
+	Columns_Count = 4 * Cells_Count;
+	if ((ExactCoverReserve((void **) &Pointer_Matrix->Pointer_Nodes, &Pointer_Matrix->Nodes_Capacity, Columns_Count + Rows_Count * EXACT_COVER_ROW_NODES_COUNT, sizeof(TExactCoverNode)) != 0)
+		|| (ExactCoverReserve((void **) &Pointer_Matrix->Pointer_Columns, &Pointer_Matrix->Columns_Capacity, Columns_Count + 1, sizeof(TExactCoverColumn)) != 0)
+		|| (ExactCoverReserve((void **) &Pointer_Matrix->Pointer_Candidates, &Pointer_Matrix->Candidates_Capacity, Rows_Count, sizeof(TExactCoverCandidate)) != 0)
+		|| (ExactCoverReserve((void **) &Pointer_Matrix->Pointer_Search_Nodes, &Pointer_Matrix->Search_Nodes_Capacity, Empty_Cells_Count + 1, sizeof(TExactCoverSearchNode)) != 0) // A search node fills a cell, plus the node finding the solution
+		|| (ExactCoverReserve((void **) &Pointer_Matrix->Pointer_Search_Rows, &Pointer_Matrix->Search_Rows_Capacity, Empty_Cells_Count * Size, sizeof(int32_t)) != 0)) return -1; // A column has at most a row per number
+	Pointer_Matrix->Columns_Count = Columns_Count;
+	Pointer_Matrix->First_Row_Node = Columns_Count;
+	Pointer_Matrix->Grid_Size = Size;
+	
+	// Start with empty columns
+	for (i = 0; i < Columns_Count; i++)
+	{
+		Pointer_Matrix->Pointer_Nodes[i].Up = i;
+		Pointer_Matrix->Pointer_Nodes[i].Down = i;
+		Pointer_Matrix->Pointer_Nodes[i].Column = i;
+		Pointer_Matrix->Pointer_Columns[i].Size = 0;
+	}
+	Pointer_Matrix->Pointer_Columns[Columns_Count].Left = Columns_Count;
+	Pointer_Matrix->Pointer_Columns[Columns_Count].Right = Columns_Count;
+	
+	// Only the constraints that are not already satisfied by the filled cells must be covered
+	for (i = 0; i < Empty_Cells_Count; i++)
+	{
+		Pointer_Cell_Coordinates = &GRID_GET_EMPTY_CELLS(Pointer_Grid)[i];
+		ExactCoverAppendColumn(Pointer_Matrix, Pointer_Cell_Coordinates->Row * Size + Pointer_Cell_Coordinates->Column);
+	}
+	for (i = 0; i < Size; i++)
+	{
+		for (Number = 0; Number < Size; Number++)
+		{
+			if (GRID_ROW_BITMASK(Pointer_Grid, i) & GRID_BITMASK_NUMBER(Number)) ExactCoverAppendColumn(Pointer_Matrix, Cells_Count + i * Size + Number);
+			if (GRID_COLUMN_BITMASK(Pointer_Grid, i) & GRID_BITMASK_NUMBER(Number)) ExactCoverAppendColumn(Pointer_Matrix, 2 * Cells_Count + i * Size + Number);
+			if (GRID_SQUARE_BITMASK(Pointer_Grid, i) & GRID_BITMASK_NUMBER(Number)) ExactCoverAppendColumn(Pointer_Matrix, 3 * Cells_Count + i * Size + Number);
+		}
+	}
+	
+	// Create the rows, their nodes being consecutive
+	Node = Pointer_Matrix->First_Row_Node;
+	Pointer_Candidate = Pointer_Matrix->Pointer_Candidates;
+	for (i = 0; i < Empty_Cells_Count; i++)
+	{
+		Row = GRID_GET_EMPTY_CELLS(Pointer_Grid)[i].Row;
+		Column = GRID_GET_EMPTY_CELLS(Pointer_Grid)[i].Column;
+		Square = GridGetCellSquareIndex(Pointer_Grid, Row, Column);
+		
+		Bitmask_Missing_Numbers = GridGetCellMissingNumbers(Pointer_Grid, Row, Column);
+		while (Bitmask_Missing_Numbers != 0)
+		{
+			Number = GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask_Missing_Numbers);
+			Bitmask_Missing_Numbers &= Bitmask_Missing_Numbers - 1;
+			
+			ExactCoverAppendNode(Pointer_Matrix, Node, Row * Size + Column);
+			ExactCoverAppendNode(Pointer_Matrix, Node + 1, Cells_Count + Row * Size + Number);
+			ExactCoverAppendNode(Pointer_Matrix, Node + 2, 2 * Cells_Count + Column * Size + Number);
+			ExactCoverAppendNode(Pointer_Matrix, Node + 3, 3 * Cells_Count + Square * Size + Number);
+			Node += EXACT_COVER_ROW_NODES_COUNT;
+			
+			Pointer_Candidate->Row = Row;
+			Pointer_Candidate->Column = Column;
+			Pointer_Candidate->Number = Number;
+			Pointer_Candidate++;
+		}
+	}
+	
+	return 0;
+}
+
+void ExactCoverReleaseMatrix(TExactCoverMatrix *Pointer_Matrix)
+{
+	free(Pointer_Matrix->Pointer_Nodes);
+	free(Pointer_Matrix->Pointer_Columns);
+	free(Pointer_Matrix->Pointer_Candidates);
+	free(Pointer_Matrix->Pointer_Search_Nodes);
+	free(Pointer_Matrix->Pointer_Search_Rows);
+	memset(Pointer_Matrix, 0, sizeof(TExactCoverMatrix));
+}
+
+int ExactCoverEnterNode(TExactCoverMatrix *Pointer_Matrix, int Depth)
+{
+	TExactCoverNode *Pointer_Nodes = Pointer_Matrix->Pointer_Nodes;
+	TExactCoverColumn *Pointer_Columns = Pointer_Matrix->Pointer_Columns;
+	TExactCoverSearchNode *Pointer_Search_Node;
+	int Root = Pointer_Matrix->Columns_Count, Column, Chosen_Column, Rows_Count, Node;
+	
+	// All constraints are satisfied
+	if (Pointer_Columns[Root].Right == Root) return 0;
+	
+	// Choose the column having the fewest rows, a column with a single row or without row can't be beaten
+	Chosen_Column = Pointer_Columns[Root].Right;
+	for (Column = Pointer_Columns[Chosen_Column].Right; (Column != Root) && (Pointer_Columns[Chosen_Column].Size > 1); Column = Pointer_Columns[Column].Right)
+	{
+		if (Pointer_Columns[Column].Size < Pointer_Columns[Chosen_Column].Size) Chosen_Column = Column;
+	}
+	
+	// Keep the column rows, so the untried ones can be given to other workers
+	Pointer_Search_Node = &Pointer_Matrix->Pointer_Search_Nodes[Depth];
+	Pointer_Search_Node->Column = Chosen_Column;
+	Pointer_Search_Node->Pointer_Rows = &Pointer_Matrix->Pointer_Search_Rows[Depth * Pointer_Matrix->Grid_Size];
+	Rows_Count = 0;
+	for (Node = Pointer_Nodes[Chosen_Column].Down; Node != Chosen_Column; Node = Pointer_Nodes[Node].Down)
+	{
+		Pointer_Search_Node->Pointer_Rows[Rows_Count] = Node;
+		Rows_Count++;
+	}
+	Pointer_Search_Node->Rows_Count = Rows_Count;
+	Pointer_Search_Node->Tried_Rows_Count = 0;
+	
+	ExactCoverCoverColumn(Pointer_Matrix, Chosen_Column);
+	return 1;
+}
+
+void ExactCoverLeaveNode(TExactCoverMatrix *Pointer_Matrix, int Depth)
+{
+	ExactCoverUncoverColumn(Pointer_Matrix, Pointer_Matrix->Pointer_Search_Nodes[Depth].Column);
+}
+
+void ExactCoverSelectRow(TExactCoverMatrix *Pointer_Matrix, int Row_Node)
+{
+	int i;
+	
+	for (i = 1; i < EXACT_COVER_ROW_NODES_COUNT; i++) ExactCoverCoverColumn(Pointer_Matrix, Pointer_Matrix->Pointer_Nodes[EXACT_COVER_GET_ROW_NEXT_NODE(Row_Node, i)].Column);
+}
+
+void ExactCoverDeselectRow(TExactCoverMatrix *Pointer_Matrix, int Row_Node)
+{
+	int i;
+	
+	for (i = EXACT_COVER_ROW_NODES_COUNT - 1; i >= 1; i--) ExactCoverUncoverColumn(Pointer_Matrix, Pointer_Matrix->Pointer_Nodes[EXACT_COVER_GET_ROW_NEXT_NODE(Row_Node, i)].Column);
+}
+
+void ExactCoverSetCellValue(TExactCoverMatrix *Pointer_Matrix, int Row_Node, TGrid *Pointer_Grid)
+{
+	TExactCoverCandidate *Pointer_Candidate;
+	
+	Pointer_Candidate = &Pointer_Matrix->Pointer_Candidates[(Row_Node - Pointer_Matrix->First_Row_Node) / EXACT_COVER_ROW_NODES_COUNT];
+	GridSetCellValue(Pointer_Grid, Pointer_Candidate->Row, Pointer_Candidate->Column, Pointer_Candidate->Number);
+}
@@ -3,10 +3,12 @@
  * @author Adrien RICCIARDI
  */
 #include <assert.h>
+#include <Candidates_Board.h>
 #include <Cells_Stack.h>
 #include <Configuration.h>
 #include <Grid.h>
 #include <Log.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -16,37 +18,123 @@
 /** Enable or disable this module debug messages. */
 #define GRID_IS_DEBUG_ENABLED 1
 
-/** Get the square index (in the Bitmask_Squares array) in which the cell is located. The formula is Square_Row * Squares_Horizontal_Count + Square_Column.
+/** Get the square index (in the Bitmask_Squares array) in which the cell is located.
+ * @param Pointer_Grid The grid the cell belongs to.
  * @param Row Cell row coordinate.
  * @param Column Cell column coordinate.
  * @return The square index in the Bitmask_Squares array.
  */
-#define GRID_GET_CELL_SQUARE_INDEX(Row, Column) ((Row / Grid_Square_Height) * Grid_Squares_Horizontal_Count + (Column / Grid_Square_Width))
+#define GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Row, Column) ((Pointer_Grid)->Pointer_Geometry->Cell_Square_Indexes[Row][Column])
+
+/** The longest grid file line that can be read (this is enough for the numbers format with 2-digit numbers and some extra blanks). */
+#define GRID_FILE_LINE_MAXIMUM_LENGTH (CONFIGURATION_GRID_MAXIMUM_SIZE * 4)
+
+/** Tell whether a character separates two numbers in the numbers format.
+ * @param Character The character to check.
+ * @return 0 if the character is not a blank,
+ * @return 1 if the character is a blank.
+ */
+#define GRID_IS_BLANK_CHARACTER(Character) (((Character) == ' ') || ((Character) == '\t') || ((Character) == '\r') || ((Character) == '\n'))
 
 //-------------------------------------------------------------------------------------------------
-// Private variables
+// Private types
 //-------------------------------------------------------------------------------------------------
-/** Cache current grid side size in cells (it won't change during program execution). */
-static unsigned int Grid_Size;
+/** A cell sharing a unit with another cell. */
+typedef struct
+{
+	unsigned char Row; //!< The cell row coordinate.
+	unsigned char Column; //!< The cell column coordinate.
+} TGridPeerCoordinates;
 
-/** The grid starting number (usually 0 or 1) added to all cell values when the grid is displayed. */
-static int Grid_Display_Starting_Number;
+/** All data depending on the grid size. Each supported size has its own instance, created by Grid_Specialized.h. */
+struct TGridGeometry
+{
+	unsigned int Size; //!< Grid side size in cells.
+	unsigned int Square_Width; //!< Horizontal dimension of a square in cells.
+	unsigned int Square_Height; //!< Vertical dimension of a square in cells.
+	unsigned int Squares_Horizontal_Count; //!< The amount of squares in a row of squares.
+	int Display_Starting_Number; //!< The grid starting number (usually 0 or 1) added to all cell values when the grid is displayed.
+	int Is_Candidates_Board_Used; //!< Tell whether the SIMD kernel can be used for this grid size.
+	unsigned char Cell_Square_Indexes[CONFIGURATION_GRID_MAXIMUM_SIZE][CONFIGURATION_GRID_MAXIMUM_SIZE]; //!< The index of the square containing each cell. The table keeps the biggest grid row stride so the generic functions index it without a multiplication (the cell peers tables, which are much bigger, are sized for each grid size by the specialized functions).
+	void (*GenerateInitialBitmasks)(TGrid *Pointer_Grid); //!< Create the initial bitmasks for all rows, columns and squares.
+	void (*MoveMostConstrainedCellToStackTop)(TGrid *Pointer_Grid); //!< Specialized version of GridMoveMostConstrainedCellToStackTop().
+	int (*PropagateConstraints)(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, TGridPropagationLevel Propagation_Level, TCellsStack *Pointer_Forced_Cells_Stack); //!< Specialized version of GridPropagateConstraints().
+};
 
-/** Cache horizontal dimension of a square in cells (it won't change during program execution). */
-static unsigned int Grid_Square_Width;
-/** Cache vertical dimension of a square in cells (it won't change during program execution). */
-static unsigned int Grid_Square_Height;
-/** Cache the amount of squares in a row (value won't change during program execution). */
-static unsigned int Grid_Squares_Horizontal_Count;
-/** Cache the amount of squares in a column (value won't change during program execution). */
-static unsigned int Grid_Squares_Vertical_Count;
+//-------------------------------------------------------------------------------------------------
+// Specialized functions
+//-------------------------------------------------------------------------------------------------
+#define GRID_SPECIALIZED_SIZE 6
+#define GRID_SPECIALIZED_SQUARE_WIDTH 3
+#define GRID_SPECIALIZED_SQUARE_HEIGHT 2
+#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 1
+#define GRID_SPECIALIZED_SUFFIX _6x6
+#include <Grid_Specialized.h>
+
+#define GRID_SPECIALIZED_SIZE 9
+#define GRID_SPECIALIZED_SQUARE_WIDTH 3
+#define GRID_SPECIALIZED_SQUARE_HEIGHT 3
+#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 1
+#define GRID_SPECIALIZED_SUFFIX _9x9
+#include <Grid_Specialized.h>
+
+#define GRID_SPECIALIZED_SIZE 12
+#define GRID_SPECIALIZED_SQUARE_WIDTH 4
+#define GRID_SPECIALIZED_SQUARE_HEIGHT 3
+#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 1
+#define GRID_SPECIALIZED_SUFFIX _12x12
+#include <Grid_Specialized.h>
+
+#define GRID_SPECIALIZED_SIZE 16
+#define GRID_SPECIALIZED_SQUARE_WIDTH 4
+#define GRID_SPECIALIZED_SQUARE_HEIGHT 4
+#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 0
+#define GRID_SPECIALIZED_SUFFIX _16x16
+#include <Grid_Specialized.h>
+
+// The big grids need wider bitmasks, so they are available only if the configuration allows them
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 25
+	#define GRID_SPECIALIZED_SIZE 25
+	#define GRID_SPECIALIZED_SQUARE_WIDTH 5
+	#define GRID_SPECIALIZED_SQUARE_HEIGHT 5
+	#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 1
+	#define GRID_SPECIALIZED_SUFFIX _25x25
+	#include <Grid_Specialized.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 36
+	#define GRID_SPECIALIZED_SIZE 36
+	#define GRID_SPECIALIZED_SQUARE_WIDTH 6
+	#define GRID_SPECIALIZED_SQUARE_HEIGHT 6
+	#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 1
+	#define GRID_SPECIALIZED_SUFFIX _36x36
+	#include <Grid_Specialized.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 49
+	#define GRID_SPECIALIZED_SIZE 49
+	#define GRID_SPECIALIZED_SQUARE_WIDTH 7
+	#define GRID_SPECIALIZED_SQUARE_HEIGHT 7
+	#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 1
+	#define GRID_SPECIALIZED_SUFFIX _49x49
+	#include <Grid_Specialized.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 64
+	#define GRID_SPECIALIZED_SIZE 64
+	#define GRID_SPECIALIZED_SQUARE_WIDTH 8
+	#define GRID_SPECIALIZED_SQUARE_HEIGHT 8
+	#define GRID_SPECIALIZED_DISPLAY_STARTING_NUMBER 1
+	#define GRID_SPECIALIZED_SUFFIX _64x64
+	#include <Grid_Specialized.h>
+#endif
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
 /** Read the next line from a grid file.
  * @param Pointer_File The file to read from.
- * @param String_Destination Where to store the read data. The buffer must be at least CONFIGURATION_GRID_MAXIMUM_SIZE + 2 bytes long (+1 to allow to load a 17-characters string and to determinate that the line is too long, and +1 for terminating zero).
+ * @param String_Destination Where to store the read data. The buffer must be at least GRID_FILE_LINE_MAXIMUM_LENGTH + 2 bytes long (+1 to allow to load a longer string and to determinate that the line is too long, and +1 for terminating zero).
  * @return The size in characters of the read line (without terminating '\n').
  */
 static int GridReadNextFileLine(FILE *Pointer_File, char *String_Destination)
@@ -54,7 +142,7 @@ static int GridReadNextFileLine(FILE *Pointer_File, char *String_Destination)
 	int Length, New_Line_Character_Index;
 
 	// Try to read the next line.
-	if (fgets(String_Destination, CONFIGURATION_GRID_MAXIMUM_SIZE + 2, Pointer_File) == NULL) return 0;
+	if (fgets(String_Destination, GRID_FILE_LINE_MAXIMUM_LENGTH + 2, Pointer_File) == NULL) return 0;
 	
 	// Remove any trailing '\n' or '\r'
 	Length = strlen(String_Destination);
@@ -89,93 +177,254 @@ static int GridConvertCharacterToValue(char Character)
 	return -1;
 }
 
-/** Create the initial bitmasks for all rows, columns and squares.
- * @param Pointer_Grid The concerned grid.
+/** Convert a program operable cell value into the character used by grid text files.
+ * @param Value The cell value.
+ * @return The corresponding character ('.' for an empty cell).
  */
-static inline void GridGenerateInitialBitmasks(TGrid *Pointer_Grid)
+static char GridConvertValueToCharacter(int Value)
 {
-	unsigned int Row, Column, Number, Column_Start, Row_End, Column_End, Square_Row, Square_Column, i;
-	int Is_Number_Found[CONFIGURATION_GRID_MAXIMUM_SIZE];
+	if (Value == GRID_EMPTY_CELL_VALUE) return '.';
+	if (Value < 10) return '0' + Value;
+	return 'A' + Value - 10; // Minus 10 as the 'A' letter represents 10
+}
+
+/** Convert a corpus record character into a program operable value.
+ * @param Character The record character.
+ * @return GRID_EMPTY_CELL_VALUE if the cell is empty,
+ * @return The corresponding numerical value if the value was recognized ('1' being 0),
+ * @return -1 if the character is not a digit, a letter or a dot.
+ */
+static int GridConvertCorpusCharacterToValue(char Character)
+{
+	// Is the character an empty cell ?
+	if ((Character == '0') || (Character == '.')) return GRID_EMPTY_CELL_VALUE;
 	
-	// Parse all rows
-	for (Row = 0; Row < Grid_Size; Row++)
+	// Is the character a number ?
+	if ((Character >= '1') && (Character <= '9')) return Character - '1';
+	if ((Character >= 'A') && (Character <= 'Z')) return Character - 'A' + 9; // Plus 9 as the 'A' letter represents the tenth number
+	if ((Character >= 'a') && (Character <= 'z')) return Character - 'a' + 9;
+	
+	// Bad character
+	return -1;
+}
+
+/** Tell whether a grid string uses the numbers format (the numbers are separated by blanks) or the characters format.
+ * @param String The grid file line or the batch mode line.
+ * @return 0 if the string uses the characters format,
+ * @return 1 if the string uses the numbers format.
+ */
+static int GridIsNumbersFormat(char *String)
+{
+	// New line characters may end a characters format string, so only the blanks that can't be found in this format are checked
+	return strpbrk(String, " \t") != NULL;
+}
+
+/** Count the numbers of a numbers format string.
+ * @param String The string to parse.
+ * @return The amount of blank-separated words.
+ */
+static unsigned int GridCountNumbers(char *String)
+{
+	unsigned int Count = 0;
+	int Is_Previous_Character_Blank = 1;
+	
+	for ( ; *String != 0; String++)
 	{
-		// Initialize values
-		Pointer_Grid->Allowed_Numbers_Bitmask_Rows[Row] = 0;
-		memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-		
-		// Find available numbers
-		for (Column = 0; Column < Grid_Size; Column++)
+		// A word starts after a blank
+		if (GRID_IS_BLANK_CHARACTER(*String)) Is_Previous_Character_Blank = 1;
+		else
 		{
-			Number = Pointer_Grid->Cells[Row][Column];
-			if (Number != GRID_EMPTY_CELL_VALUE) Is_Number_Found[Number] = 1;
+			if (Is_Previous_Character_Blank) Count++;
+			Is_Previous_Character_Blank = 0;
 		}
+	}
+	
+	return Count;
+}
+
+/** Convert the next number of a numbers format string into a program operable value.
+ * @param Pointer_Pointer_String The string to read from. On output, point to the character following the read number.
+ * @return GRID_EMPTY_CELL_VALUE if the cell is empty,
+ * @return The corresponding numerical value if the number was recognized,
+ * @return -1 if there is no number left or if the number is not a decimal number or a dot.
+ */
+static int GridReadNextNumber(char **Pointer_Pointer_String)
+{
+	char *Pointer_String = *Pointer_Pointer_String;
+	int Value;
+	
+	// Skip the separating blanks
+	while (GRID_IS_BLANK_CHARACTER(*Pointer_String)) Pointer_String++;
+	
+	// Is the cell empty ?
+	if (*Pointer_String == '.')
+	{
+		Value = GRID_EMPTY_CELL_VALUE;
+		Pointer_String++;
+	}
+	else
+	{
+		if ((*Pointer_String < '0') || (*Pointer_String > '9')) return -1;
 		
-		// Set corresponding bits into bitmask
-		for (Number = 0; Number < Grid_Size; Number++)
+		// Convert the decimal digits
+		Value = 0;
+		while ((*Pointer_String >= '0') && (*Pointer_String <= '9'))
 		{
-			if (!Is_Number_Found[Number]) Pointer_Grid->Allowed_Numbers_Bitmask_Rows[Row] |= 1 << Number;
+			Value = Value * 10 + *Pointer_String - '0';
+			if (Value >= GRID_EMPTY_CELL_VALUE) return -1; // The number can't be part of a grid, stop here to avoid overflowing
+			Pointer_String++;
 		}
 	}
 	
-	// Parse all columns
-	for (Column = 0; Column < Grid_Size; Column++)
+	// The number must be followed by a blank or by the string end
+	if ((*Pointer_String != 0) && !GRID_IS_BLANK_CHARACTER(*Pointer_String)) return -1;
+	
+	*Pointer_Pointer_String = Pointer_String;
+	return Value;
+}
+
+/** Choose the data and functions matching the grid size.
+ * @param Pointer_Grid The grid being loaded.
+ * @param Size The grid side size in cells.
+ * @return 0 if the grid size is supported,
+ * @return -2 if the grid size is not supported.
+ */
+static int GridSetSize(TGrid *Pointer_Grid, unsigned int Size)
+{
+	// Check if the grid size can be handled by the solver
+	switch (Size)
 	{
-		// Initialize values
-		Pointer_Grid->Allowed_Numbers_Bitmask_Columns[Column] = 0;
-		memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-		
-		// Find available numbers
-		for (Row = 0; Row < Grid_Size; Row++)
+		case 6:
+			Pointer_Grid->Pointer_Geometry = GridGetGeometry_6x6();
+			break;
+
+		case 9:
+			Pointer_Grid->Pointer_Geometry = GridGetGeometry_9x9();
+			break;
+
+		case 12:
+			Pointer_Grid->Pointer_Geometry = GridGetGeometry_12x12();
+			break;
+
+		case 16:
+			Pointer_Grid->Pointer_Geometry = GridGetGeometry_16x16();
+			break;
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 25
+			case 25:
+				Pointer_Grid->Pointer_Geometry = GridGetGeometry_25x25();
+				break;
+		#endif
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 36
+			case 36:
+				Pointer_Grid->Pointer_Geometry = GridGetGeometry_36x36();
+				break;
+		#endif
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 49
+			case 49:
+				Pointer_Grid->Pointer_Geometry = GridGetGeometry_49x49();
+				break;
+		#endif
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 64
+			case 64:
+				Pointer_Grid->Pointer_Geometry = GridGetGeometry_64x64();
+				break;
+		#endif
+
+		default:
+			LOG(GRID_IS_DEBUG_ENABLED, "Unrecognized grid size.\n");
+			return -2;
+	}
+	Pointer_Grid->Grid_Size = Size;
+	
+	return 0;
+}
+
+/** Convert a line of grid characters into cell values.
+ * @param Pointer_Grid The grid to fill.
+ * @param Row The row to fill.
+ * @param String_Line The characters describing the row. The string must be at least grid size characters long.
+ * @return 0 if the row was correctly loaded,
+ * @return -3 if a character is bad.
+ */
+static int GridLoadRow(TGrid *Pointer_Grid, unsigned int Row, char *String_Line)
+{
+	unsigned int Column, Temp;
+	
+	// Get each cell value
+	for (Column = 0; Column < Pointer_Grid->Grid_Size; Column++)
+	{
+		// Get the numerical value of each cell
+		Temp = GridConvertCharacterToValue(String_Line[Column]);
+		if ((Temp != GRID_EMPTY_CELL_VALUE) && (Temp >= Pointer_Grid->Grid_Size))
 		{
-			Number = Pointer_Grid->Cells[Row][Column];
-			if (Number != GRID_EMPTY_CELL_VALUE) Is_Number_Found[Number] = 1;
+			LOG(GRID_IS_DEBUG_ENABLED, "The read character value (%d) is too big for the grid size.\n", Temp);
+			return -3;
 		}
-		
-		// Set corresponding bits into bitmask
-		for (Number = 0; Number < Grid_Size; Number++)
+		if (Temp == (unsigned int) -1)
 		{
-			if (!Is_Number_Found[Number]) Pointer_Grid->Allowed_Numbers_Bitmask_Columns[Column] |= 1 << Number;
+			LOG(GRID_IS_DEBUG_ENABLED, "A bad character was read.\n");
+			return -3;
 		}
+
+		GRID_CELL(Pointer_Grid, Row, Column) = Temp;
 	}
 	
-	// Parse all squares
-	i = 0; // Index in the square bitmasks array
+	return 0;
+}
+
+/** Convert a row of numbers format string into cell values.
+ * @param Pointer_Grid The grid to fill.
+ * @param Row The row to fill.
+ * @param Pointer_Pointer_String The numbers describing the row. On output, point to the character following the row last number, so the next row can be read from a single line string.
+ * @return 0 if the row was correctly loaded,
+ * @return -3 if a number is bad or missing.
+ */
+static int GridLoadNumbersRow(TGrid *Pointer_Grid, unsigned int Row, char **Pointer_Pointer_String)
+{
+	unsigned int Column;
+	int Value;
 	
-	for (Square_Row = 0; Square_Row < Grid_Squares_Vertical_Count; Square_Row++)
+	// Get each cell value
+	for (Column = 0; Column < Pointer_Grid->Grid_Size; Column++)
 	{
-		for (Square_Column = 0; Square_Column < Grid_Squares_Horizontal_Count; Square_Column++)
+		Value = GridReadNextNumber(Pointer_Pointer_String);
+		if (Value == -1)
 		{
-			// Initialize values
-			Pointer_Grid->Allowed_Numbers_Bitmask_Squares[i] = 0;
-			memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-			
-			// Determine coordinates of the square to parse
-			Row = Square_Row * Grid_Square_Height;
-			Column_Start = Square_Column * Grid_Square_Width;
-			Row_End = Row + Grid_Square_Height;
-			Column_End = Column_Start + Grid_Square_Width;
-			
-			// Find numbers present into the square
-			for ( ; Row < Row_End; Row++)
-			{
-				for (Column = Column_Start; Column < Column_End; Column++)
-				{
-					Number = Pointer_Grid->Cells[Row][Column];
-					if (Number != GRID_EMPTY_CELL_VALUE) Is_Number_Found[Number] = 1;
-				}
-			}
-			
-			// Set corresponding bits into bitmask
-			for (Number = 0; Number < Grid_Size; Number++)
-			{
-				if (!Is_Number_Found[Number]) Pointer_Grid->Allowed_Numbers_Bitmask_Squares[i] |= 1 << Number;
-			}
-			
-			// Next square bitmask
-			i++;
+			LOG(GRID_IS_DEBUG_ENABLED, "A bad number was read.\n");
+			return -3;
 		}
+		if ((Value != GRID_EMPTY_CELL_VALUE) && ((unsigned int) Value >= Pointer_Grid->Grid_Size))
+		{
+			LOG(GRID_IS_DEBUG_ENABLED, "The read number (%d) is too big for the grid size.\n", Value);
+			return -3;
+		}
+
+		GRID_CELL(Pointer_Grid, Row, Column) = Value;
 	}
+	
+	return 0;
+}
+
+/** Put an emptied cell back to the empty cells stack, it becomes the next empty cell.
+ * @param Pointer_Grid The concerned grid.
+ * @param Cell_Row Row coordinate of the cell.
+ * @param Cell_Column Column coordinate of the cell.
+ */
+static void GridAddEmptyCell(TGrid *Pointer_Grid, int Cell_Row, int Cell_Column)
+{
+	TCellsStackCellCoordinates *Pointer_Cell_Coordinates;
+	
+	// Make sure the stack is not overflowing
+	assert((unsigned int) Pointer_Grid->Empty_Cells_Count < Pointer_Grid->Grid_Size * Pointer_Grid->Grid_Size);
+	
+	Pointer_Cell_Coordinates = &GRID_GET_EMPTY_CELLS(Pointer_Grid)[Pointer_Grid->Empty_Cells_Count];
+	Pointer_Cell_Coordinates->Row = Cell_Row;
+	Pointer_Cell_Coordinates->Column = Cell_Column;
+	Pointer_Grid->Empty_Cells_Count++;
 }
 
 /** Fill the empty stack cells of the specified grid..
@@ -184,19 +433,15 @@ static inline void GridGenerateInitialBitmasks(TGrid *Pointer_Grid)
 static void GridFillStackWithEmptyCells(TGrid *Pointer_Grid)
 {
 	int Row, Column;
-	TCellsStack *Pointer_Stack;
 	
-	// Cache stack access
-	Pointer_Stack = &Pointer_Grid->Empty_Cells_Stack;
-	
-	CellsStackInitialize(Pointer_Stack);
+	Pointer_Grid->Empty_Cells_Count = 0;
 	
 	// Reverse parsing to create a stack with empty coordinates beginning on the top-left part of the grid (this allows to make speed comparisons with the older way to find empty cells)
-	for (Row = Grid_Size - 1; Row >= 0; Row--)
+	for (Row = Pointer_Grid->Grid_Size - 1; Row >= 0; Row--)
 	{
-		for (Column = Grid_Size - 1; Column >= 0; Column--)
+		for (Column = Pointer_Grid->Grid_Size - 1; Column >= 0; Column--)
 		{
-			if (Pointer_Grid->Cells[Row][Column] == GRID_EMPTY_CELL_VALUE) CellsStackPush(Pointer_Stack, Row, Column);
+			if (GRID_CELL(Pointer_Grid, Row, Column) == GRID_EMPTY_CELL_VALUE) GridAddEmptyCell(Pointer_Grid, Row, Column);
 		}
 	}
 }
@@ -207,87 +452,53 @@ static void GridFillStackWithEmptyCells(TGrid *Pointer_Grid)
 int GridLoadFromFile(TGrid *Pointer_Grid, char *String_File_Name)
 {
 	FILE *Pointer_File;
-	unsigned int Row, Column, Temp;
-	char String_Line[CONFIGURATION_GRID_MAXIMUM_SIZE + 2];
+	unsigned int Row, Temp;
+	int Is_Numbers_Format, Result;
+	char String_Line[GRID_FILE_LINE_MAXIMUM_LENGTH + 2], *Pointer_String;
 	
 	// Try to open the file
 	Pointer_File = fopen(String_File_Name, "rb");
 	if (Pointer_File == NULL) return -1;
 	
-	// Retrieve the grid size according to the length of the first line
-	Grid_Size = GridReadNextFileLine(Pointer_File, String_Line);
-	if (Grid_Size > CONFIGURATION_GRID_MAXIMUM_SIZE)
+	// Retrieve the grid size according to the amount of cells of the first line
+	Temp = GridReadNextFileLine(Pointer_File, String_Line);
+	Is_Numbers_Format = GridIsNumbersFormat(String_Line);
+	if (Is_Numbers_Format) Temp = GridCountNumbers(String_Line);
+	if (Temp > CONFIGURATION_GRID_MAXIMUM_SIZE)
 	{
 		fclose(Pointer_File);
-		LOG(GRID_IS_DEBUG_ENABLED, "First line length is too long.\n");
+		LOG(GRID_IS_DEBUG_ENABLED, "First line has too many cells.\n");
 		return -2;
 	}
-	Pointer_Grid->Grid_Size = Grid_Size;
-
-	// Check if the grid size can be handled by the solver
-	switch (Grid_Size)
+	if (GridSetSize(Pointer_Grid, Temp) != 0)
 	{
-		case 6:
-			Grid_Square_Width = 3;
-			Grid_Square_Height = 2;
-			Grid_Display_Starting_Number = 1;
-			break;
-
-		case 9:
-			Grid_Square_Width = 3;
-			Grid_Square_Height = 3;
-			Grid_Display_Starting_Number = 1;
-			break;
-
-		case 12:
-			Grid_Square_Width = 4;
-			Grid_Square_Height = 3;
-			Grid_Display_Starting_Number = 1;
-			break;
-
-		case 16:
-			Grid_Square_Width = 4;
-			Grid_Square_Height = 4;
-			Grid_Display_Starting_Number = 0;
-			break;
-
-		default:
-			LOG(GRID_IS_DEBUG_ENABLED, "Unrecognized grid size.\n");
-			return -2;
+		fclose(Pointer_File);
+		return -2;
 	}
 	
-	// Compute number of squares on grid width and height
-	Grid_Squares_Horizontal_Count = Grid_Size / Grid_Square_Width;
-	Grid_Squares_Vertical_Count = Grid_Size / Grid_Square_Height;
-	
 	// Load grid
-	for (Row = 0; Row < Grid_Size; Row++)
+	for (Row = 0; Row < Pointer_Grid->Grid_Size; Row++)
 	{
-		// Get each cell value
-		for (Column = 0; Column < Grid_Size; Column++)
+		if (Is_Numbers_Format)
 		{
-			// Get the numerical value of each cell
-			Temp = GridConvertCharacterToValue(String_Line[Column]);
-			if ((Temp != GRID_EMPTY_CELL_VALUE) && (Temp >= Grid_Size))
-			{
-				LOG(GRID_IS_DEBUG_ENABLED, "The read character value (%d) is too big for the grid size.\n", Temp);
-				return -3;
-			}
-			if (Temp == (unsigned int) -1)
-			{
-				LOG(GRID_IS_DEBUG_ENABLED, "A bad character was read.\n");
-				return -3;
-			}
-
-			Pointer_Grid->Cells[Row][Column] = Temp;
+			Pointer_String = String_Line;
+			Result = GridLoadNumbersRow(Pointer_Grid, Row, &Pointer_String);
+		}
+		else Result = GridLoadRow(Pointer_Grid, Row, String_Line);
+		if (Result != 0)
+		{
+			fclose(Pointer_File);
+			return -3;
 		}
 
 		// Load the next line
-		if (Row < Grid_Size - 1) // -1 because the first line was read before entering the loop
+		if (Row < Pointer_Grid->Grid_Size - 1) // -1 because the first line was read before entering the loop
 		{
 			Temp = GridReadNextFileLine(Pointer_File, String_Line);
-			if (Temp != Grid_Size)
+			if (Is_Numbers_Format) Temp = GridCountNumbers(String_Line);
+			if (Temp != Pointer_Grid->Grid_Size)
 			{
+				fclose(Pointer_File);
 				LOG(GRID_IS_DEBUG_ENABLED, "The line %d has not the same length than the previous ones (%d).\n", Row + 2, Temp); // +1 because the text editor starts displaying lines from 1, and +1 because the first line was already read (to get the grid size)
 				return -2;
 			}
@@ -296,23 +507,83 @@ int GridLoadFromFile(TGrid *Pointer_Grid, char *String_File_Name)
 
 	// The grid was successfully loaded
 	fclose(Pointer_File);
+	return 0;
+}
 
-	// Create first bitmasks
-	GridGenerateInitialBitmasks(Pointer_Grid);
+int GridLoadFromString(TGrid *Pointer_Grid, char *String_Grid)
+{
+	unsigned int Length, Size, Row;
+	int Is_Numbers_Format;
+	
+	// Count the cells, ignoring any trailing new line characters
+	Is_Numbers_Format = GridIsNumbersFormat(String_Grid);
+	if (Is_Numbers_Format) Length = GridCountNumbers(String_Grid); // The new line characters are blanks, so they are not counted
+	else
+	{
+		Length = strlen(String_Grid);
+		while ((Length > 0) && ((String_Grid[Length - 1] == '\n') || (String_Grid[Length - 1] == '\r'))) Length--;
+	}
+	
+	// The string must contain all grid rows, so its cells count must be a perfect square
+	for (Size = 1; Size * Size < Length; Size++);
+	if ((Size * Size != Length) || (Size > CONFIGURATION_GRID_MAXIMUM_SIZE))
+	{
+		LOG(GRID_IS_DEBUG_ENABLED, "The string cells count (%u) does not match a square grid.\n", Length);
+		return -2;
+	}
+	if (GridSetSize(Pointer_Grid, Size) != 0) return -2;
+	
+	// Load grid
+	for (Row = 0; Row < Size; Row++)
+	{
+		if (Is_Numbers_Format)
+		{
+			if (GridLoadNumbersRow(Pointer_Grid, Row, &String_Grid) != 0) return -3;
+		}
+		else if (GridLoadRow(Pointer_Grid, Row, &String_Grid[Row * Size]) != 0) return -3;
+	}
 	
-	// Put the empty cells coordinates into the dedicated stack
-	GridFillStackWithEmptyCells(Pointer_Grid);
 	return 0;
 }
 
-void GridCopy(TGrid *Pointer_Grid_Source, TGrid *Pointer_Grid_Destination)
+int GridLoadFromCorpusRecord(TGrid *Pointer_Grid, const char *Pointer_Record, unsigned int Length)
 {
-	// TODO copy only data that won't be modified ?
-	memcpy(Pointer_Grid_Destination, Pointer_Grid_Source, sizeof(TGrid));
+	unsigned int Size, Row, Column;
+	int Value;
+	
+	// The record must contain all grid rows, and a character per cell can only describe 35 numbers
+	if (Length > 35 * 35) Size = 36;
+	else for (Size = 1; Size * Size < Length; Size++);
+	if ((Size * Size != Length) || (Size > 35))
+	{
+		LOG(GRID_IS_DEBUG_ENABLED, "The record cells count (%u) does not match a supported square grid.\n", Length);
+		return -2;
+	}
+	if (GridSetSize(Pointer_Grid, Size) != 0) return -2;
+	
+	// Load grid
+	for (Row = 0; Row < Size; Row++)
+	{
+		for (Column = 0; Column < Size; Column++)
+		{
+			Value = GridConvertCorpusCharacterToValue(*Pointer_Record);
+			if ((Value == -1) || ((Value != GRID_EMPTY_CELL_VALUE) && ((unsigned int) Value >= Size)))
+			{
+				LOG(GRID_IS_DEBUG_ENABLED, "Bad record character '%c'.\n", *Pointer_Record);
+				return -3;
+			}
+			GRID_CELL(Pointer_Grid, Row, Column) = Value;
+			Pointer_Record++;
+		}
+	}
 	
-	// Recreate internal structures as the provided grid has been modified by the main thread
-	GridGenerateInitialBitmasks(Pointer_Grid_Destination);
-	GridFillStackWithEmptyCells(Pointer_Grid_Destination);
+	return 0;
+}
+
+void GridCopy(TGrid *Pointer_Grid_Source, TGrid *Pointer_Grid_Destination)
+{
+	// The used part of the grid ends with the top of the empty cells stack, so a single copy is needed
+	memcpy(Pointer_Grid_Destination, Pointer_Grid_Source, (uint8_t *) &GRID_GET_EMPTY_CELLS(Pointer_Grid_Source)[Pointer_Grid_Source->Empty_Cells_Count] - (uint8_t *) Pointer_Grid_Source);
 }
 
 void GridShow(TGrid *Pointer_Grid)
@@ -320,51 +591,124 @@ void GridShow(TGrid *Pointer_Grid)
 	unsigned int Row, Column;
 	int Value;
 	
-	for (Row = 0; Row < Grid_Size; Row++)
+	for (Row = 0; Row < Pointer_Grid->Grid_Size; Row++)
 	{
-		for (Column = 0; Column < Grid_Size; Column++)
+		for (Column = 0; Column < Pointer_Grid->Grid_Size; Column++)
 		{
-			Value = Pointer_Grid->Cells[Row][Column];
+			Value = GRID_CELL(Pointer_Grid, Row, Column);
 			if (Value == GRID_EMPTY_CELL_VALUE) printf(" . ");
-			else printf("%2d ", Value + Grid_Display_Starting_Number);
+			else printf("%2d ", Value + Pointer_Grid->Pointer_Geometry->Display_Starting_Number);
 		}
 		putchar('\n');
 	}
 }
 
-unsigned int GridGetCellMissingNumbers(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column)
+void GridConvertToString(TGrid *Pointer_Grid, char *Pointer_Output_String)
+{
+	unsigned int Row, Column;
+	int Value;
+	
+	// A character per cell is enough for the small grids
+	if (Pointer_Grid->Grid_Size <= 16)
+	{
+		for (Row = 0; Row < Pointer_Grid->Grid_Size; Row++)
+		{
+			for (Column = 0; Column < Pointer_Grid->Grid_Size; Column++)
+			{
+				*Pointer_Output_String = GridConvertValueToCharacter(GRID_CELL(Pointer_Grid, Row, Column));
+				Pointer_Output_String++;
+			}
+		}
+		*Pointer_Output_String = 0; // Terminate string
+		return;
+	}
+	
+	// Use the numbers format for the bigger grids
+	for (Row = 0; Row < Pointer_Grid->Grid_Size; Row++)
+	{
+		for (Column = 0; Column < Pointer_Grid->Grid_Size; Column++)
+		{
+			// Separate the number from the previous one
+			if ((Row != 0) || (Column != 0))
+			{
+				*Pointer_Output_String = ' ';
+				Pointer_Output_String++;
+			}
+			
+			Value = GRID_CELL(Pointer_Grid, Row, Column);
+			if (Value == GRID_EMPTY_CELL_VALUE)
+			{
+				*Pointer_Output_String = '.';
+				Pointer_Output_String++;
+			}
+			else Pointer_Output_String += sprintf(Pointer_Output_String, "%d", Value);
+		}
+	}
+	*Pointer_Output_String = 0; // Terminate string
+}
+
+void GridConvertToCorpusString(TGrid *Pointer_Grid, char *Pointer_Output_String)
 {
-	unsigned int Bitmask_Missing_Numbers, Square_Index;
+	unsigned int Row, Column;
+	int Value;
+	
+	for (Row = 0; Row < Pointer_Grid->Grid_Size; Row++)
+	{
+		for (Column = 0; Column < Pointer_Grid->Grid_Size; Column++)
+		{
+			Value = GRID_CELL(Pointer_Grid, Row, Column);
+			if (Value == GRID_EMPTY_CELL_VALUE) *Pointer_Output_String = '.';
+			else if (Value < 9) *Pointer_Output_String = '1' + Value;
+			else *Pointer_Output_String = 'A' + Value - 9; // Minus 9 as the 'A' letter represents the tenth number
+			Pointer_Output_String++;
+		}
+	}
+	*Pointer_Output_String = 0; // Terminate string
+}
+
+TGridBitmask GridGetCellMissingNumbers(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column)
+{
+	unsigned int Square_Index;
+	TGridBitmask Bitmask_Missing_Numbers;
 	
 	// Check coordinates in debug mode
-	assert(Cell_Row < Grid_Size);
-	assert(Cell_Column < Grid_Size);
+	assert(Cell_Row < Pointer_Grid->Grid_Size);
+	assert(Cell_Column < Pointer_Grid->Grid_Size);
 	
 	// Nothing to do if the cell has a value yet
-	if (Pointer_Grid->Cells[Cell_Row][Cell_Column] != GRID_EMPTY_CELL_VALUE) return 0;
+	if (GRID_CELL(Pointer_Grid, Cell_Row, Cell_Column) != GRID_EMPTY_CELL_VALUE) return 0;
 	
 	// Determinate the index of the square where the cell is located
-	Square_Index = GRID_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column);
+	Square_Index = GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Cell_Row, Cell_Column);
 	
 	// Find missing numbers simultaneously on the row, the column and the square of the cell
-	Bitmask_Missing_Numbers = Pointer_Grid->Allowed_Numbers_Bitmask_Rows[Cell_Row] & Pointer_Grid->Allowed_Numbers_Bitmask_Columns[Cell_Column] & Pointer_Grid->Allowed_Numbers_Bitmask_Squares[Square_Index];
+	Bitmask_Missing_Numbers = GRID_ROW_BITMASK(Pointer_Grid, Cell_Row) & GRID_COLUMN_BITMASK(Pointer_Grid, Cell_Column) & GRID_SQUARE_BITMASK(Pointer_Grid, Square_Index);
 	return Bitmask_Missing_Numbers;
 }
 
-void GridShowMissingNumbers(unsigned int Bitmask_Missing_Numbers)
+unsigned int GridGetCellSquareIndex(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column)
+{
+	// Check coordinates in debug mode
+	assert(Cell_Row < Pointer_Grid->Grid_Size);
+	assert(Cell_Column < Pointer_Grid->Grid_Size);
+	
+	return GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Cell_Row, Cell_Column);
+}
+
+void GridShowMissingNumbers(TGrid *Pointer_Grid, TGridBitmask Bitmask_Missing_Numbers)
 {
 	unsigned int i;
 	char Temporary_String[4], String[CONFIGURATION_GRID_MAXIMUM_SIZE * 4] = {0}; // Create a complete string and display it once to avoid cutting it by other printings made by other threads, the string size should be enough with 4 characters per number (2 for the digits, one for the comma and one for the separating space), because 10 numbers will only be 1-digit long
 
-	for (i = 0; i < Grid_Size; i++)
+	for (i = 0; i < Pointer_Grid->Grid_Size; i++)
 	{
-		if (Bitmask_Missing_Numbers & (1 << i))
+		if (Bitmask_Missing_Numbers & GRID_BITMASK_NUMBER(i))
 		{
 			// Separate the previous number (if any) with a comma, there is a previous number if the string is not empty
 			if (String[0] != 0) strcat(String, ", ");
 
 			// Append the number to the string
-			sprintf(Temporary_String, "%u", i + Grid_Display_Starting_Number);
+			sprintf(Temporary_String, "%u", i + Pointer_Grid->Pointer_Geometry->Display_Starting_Number);
 			strcat(String, Temporary_String);
 		}
 	}
@@ -375,41 +719,85 @@ void GridShowMissingNumbers(unsigned int Bitmask_Missing_Numbers)
 void GridSetCellValue(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Cell_Value)
 {
 	// Check coordinates in debug mode
-	assert(Cell_Row < Grid_Size);
-	assert(Cell_Column < Grid_Size);
+	assert(Cell_Row < Pointer_Grid->Grid_Size);
+	assert(Cell_Column < Pointer_Grid->Grid_Size);
 
-	Pointer_Grid->Cells[Cell_Row][Cell_Column] = Cell_Value;
+	GRID_CELL(Pointer_Grid, Cell_Row, Cell_Column) = Cell_Value;
 }
 
 void GridRemoveCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number)
 {
-	unsigned int New_Bitmask;
+	TGridBitmask New_Bitmask;
 	
-	New_Bitmask = ~(1 << Number);
+	New_Bitmask = ~GRID_BITMASK_NUMBER(Number);
 	
 	// Disable the Number bit in all relevant bitmasks
-	Pointer_Grid->Allowed_Numbers_Bitmask_Rows[Cell_Row] &= New_Bitmask;
-	Pointer_Grid->Allowed_Numbers_Bitmask_Columns[Cell_Column] &= New_Bitmask;
-	Pointer_Grid->Allowed_Numbers_Bitmask_Squares[GRID_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column)] &= New_Bitmask;
+	GRID_ROW_BITMASK(Pointer_Grid, Cell_Row) &= New_Bitmask;
+	GRID_COLUMN_BITMASK(Pointer_Grid, Cell_Column) &= New_Bitmask;
+	GRID_SQUARE_BITMASK(Pointer_Grid, GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Cell_Row, Cell_Column)) &= New_Bitmask;
 }
 
 void GridRestoreCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number)
 {
-	unsigned int New_Bitmask;
+	TGridBitmask New_Bitmask;
 	
-	New_Bitmask = 1 << Number;
+	New_Bitmask = GRID_BITMASK_NUMBER(Number);
 	
 	// Disable the Number bit in all relevant bitmasks
-	Pointer_Grid->Allowed_Numbers_Bitmask_Rows[Cell_Row] |= New_Bitmask;
-	Pointer_Grid->Allowed_Numbers_Bitmask_Columns[Cell_Column] |= New_Bitmask;
-	Pointer_Grid->Allowed_Numbers_Bitmask_Squares[GRID_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column)] |= New_Bitmask;
+	GRID_ROW_BITMASK(Pointer_Grid, Cell_Row) |= New_Bitmask;
+	GRID_COLUMN_BITMASK(Pointer_Grid, Cell_Column) |= New_Bitmask;
+	GRID_SQUARE_BITMASK(Pointer_Grid, GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Cell_Row, Cell_Column)) |= New_Bitmask;
+}
+
+void GridMoveMostConstrainedCellToStackTop(TGrid *Pointer_Grid)
+{
+	Pointer_Grid->Pointer_Geometry->MoveMostConstrainedCellToStackTop(Pointer_Grid);
+}
+
+int GridPropagateConstraints(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, TGridPropagationLevel Propagation_Level, TCellsStack *Pointer_Forced_Cells_Stack)
+{
+	return Pointer_Grid->Pointer_Geometry->PropagateConstraints(Pointer_Grid, Cell_Row, Cell_Column, Propagation_Level, Pointer_Forced_Cells_Stack);
+}
+
+int GridIsCandidatesBoardUsed(TGrid *Pointer_Grid, TGridPropagationLevel Propagation_Level)
+{
+	// Keep this condition in sync with the specialized GridPropagateConstraints()
+	return Pointer_Grid->Pointer_Geometry->Is_Candidates_Board_Used && (Propagation_Level >= GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES);
+}
+
+void GridRestoreForcedCells(TGrid *Pointer_Grid, TCellsStack *Pointer_Forced_Cells_Stack, int Stack_Index)
+{
+	int Row, Column;
+	
+	// Restore the cells in the reverse order
+	while (Pointer_Forced_Cells_Stack->Stack_Index > Stack_Index)
+	{
+		Pointer_Forced_Cells_Stack->Stack_Index--;
+		Row = Pointer_Forced_Cells_Stack->Cells_Coordinates[Pointer_Forced_Cells_Stack->Stack_Index].Row;
+		Column = Pointer_Forced_Cells_Stack->Cells_Coordinates[Pointer_Forced_Cells_Stack->Stack_Index].Column;
+		
+		GridRestoreCellMissingNumber(Pointer_Grid, Row, Column, GRID_CELL(Pointer_Grid, Row, Column));
+		GRID_CELL(Pointer_Grid, Row, Column) = GRID_EMPTY_CELL_VALUE;
+		GridAddEmptyCell(Pointer_Grid, Row, Column);
+	}
+}
+
+void GridUpdateFromCellValues(TGrid *Pointer_Grid)
+{
+	Pointer_Grid->Pointer_Geometry->GenerateInitialBitmasks(Pointer_Grid);
+	GridFillStackWithEmptyCells(Pointer_Grid);
 }
 
 int GridIsCorrectlyFilled(TGrid *Pointer_Grid)
 {
-	unsigned int Row, Column, Cell_Row, Cell_Column, Column_Start, Row_End, Column_End;
+	unsigned int Row, Column, Cell_Row, Cell_Column, Column_Start, Row_End, Column_End, Grid_Size, Square_Width, Square_Height;
 	int Number, Is_Number_Found[CONFIGURATION_GRID_MAXIMUM_SIZE];
 	
+	// Cache the grid dimensions
+	Grid_Size = Pointer_Grid->Grid_Size;
+	Square_Width = Pointer_Grid->Pointer_Geometry->Square_Width;
+	Square_Height = Pointer_Grid->Pointer_Geometry->Square_Height;
+	
 	// Check each row correctness
 	for (Row = 0; Row < Grid_Size; Row++)
 	{
@@ -419,7 +807,7 @@ int GridIsCorrectlyFilled(TGrid *Pointer_Grid)
 		// Find all filled numbers
 		for (Column = 0; Column < Grid_Size; Column++)
 		{
-			Number = Pointer_Grid->Cells[Row][Column];
+			Number = GRID_CELL(Pointer_Grid, Row, Column);
 			if (Number == GRID_EMPTY_CELL_VALUE) return 0; // Grid is not fully solved
 			if (Is_Number_Found[Number]) return 0; // The number is present more than one time
 			Is_Number_Found[Number] = 1;
@@ -435,7 +823,7 @@ int GridIsCorrectlyFilled(TGrid *Pointer_Grid)
 		// Find all filled numbers
 		for (Row = 0; Row < Grid_Size; Row++)
 		{
-			Number = Pointer_Grid->Cells[Row][Column];
+			Number = GRID_CELL(Pointer_Grid, Row, Column);
 			if (Number == GRID_EMPTY_CELL_VALUE) return 0; // Grid is not fully solved
 			if (Is_Number_Found[Number]) return 0; // The number is present more than one time
 			Is_Number_Found[Number] = 1;
@@ -451,17 +839,17 @@ int GridIsCorrectlyFilled(TGrid *Pointer_Grid)
 			memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
 			
 			// Determine coordinates of the square where the cell is located
-			Row = (Cell_Row / Grid_Square_Height) * Grid_Square_Height;
-			Column_Start = (Cell_Column / Grid_Square_Width) * Grid_Square_Width;
-			Row_End = Row + Grid_Square_Height;
-			Column_End = Column_Start + Grid_Square_Width;
+			Row = (Cell_Row / Square_Height) * Square_Height;
+			Column_Start = (Cell_Column / Square_Width) * Square_Width;
+			Row_End = Row + Square_Height;
+			Column_End = Column_Start + Square_Width;
 			
 			// Find numbers present into the square
 			for ( ; Row < Row_End; Row++)
 			{
 				for (Column = Column_Start; Column < Column_End; Column++)
 				{
-					Number = Pointer_Grid->Cells[Row][Column];
+					Number = GRID_CELL(Pointer_Grid, Row, Column);
 					if (Number == GRID_EMPTY_CELL_VALUE) return 0; // Grid is not fully solved
 					if (Is_Number_Found[Number]) return 0; // The number is present more than one time
 					Is_Number_Found[Number] = 1;
@@ -472,15 +860,15 @@ int GridIsCorrectlyFilled(TGrid *Pointer_Grid)
 	return 1;
 }
 
-void GridConvertBitmaskToString(unsigned int Bitmask, char *Pointer_Output_String)
+void GridConvertBitmaskToString(TGrid *Pointer_Grid, TGridBitmask Bitmask, char *Pointer_Output_String)
 {
 	int i, j = 0;
 	
 	// Parse each bitmask bit and convert it to a character
-	for (i = Grid_Size - 1; i >= 0; i--)
+	for (i = Pointer_Grid->Grid_Size - 1; i >= 0; i--)
 	{
 		// Show '1' or '0' according to bit value
-		if (Bitmask & (1 << i)) *Pointer_Output_String = '1';
+		if (Bitmask & GRID_BITMASK_NUMBER(i)) *Pointer_Output_String = '1';
 		else *Pointer_Output_String = '0';
 		Pointer_Output_String++;
 		
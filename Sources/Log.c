@@ -23,7 +23,7 @@ void LogPrintMessage(const char *Pointer_String_Format, ...)
 	
 	// Display log message
 	va_start(Arguments_List, Pointer_String_Format);
-	vprintf(Pointer_String_Format, Arguments_List);
+	vfprintf(stderr, Pointer_String_Format, Arguments_List);
 	va_end(Arguments_List);
 	
 	pthread_mutex_unlock(&Logs_Mutex);
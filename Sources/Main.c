@@ -2,96 +2,717 @@
  * Load the grid and divide the solving work between the available threads.
  * @author Adrien RICCIARDI
  */
+#include <Affinity.h>
 #include <Configuration.h>
+#include <Corpus.h>
 #include <Grid.h>
+#include <pthread.h>
+#include <Server.h>
+#include <Solver.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <Timer.h>
+#include <unistd.h>
 #include <Worker.h>
 
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** How many numerical fields are printed for each grid by the machine-readable output formats. */
+#define MAIN_RESULT_FIELDS_COUNT 22
+
+/** How many nanoseconds separate two corpus progress messages. */
+#define MAIN_CORPUS_PROGRESS_PERIOD 1000000000ULL
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** How the results are printed. */
+typedef enum
+{
+	MAIN_OUTPUT_FORMAT_TEXT, //!< Human-readable messages.
+	MAIN_OUTPUT_FORMAT_JSON, //!< A JSON object per grid, each one on its own line.
+	MAIN_OUTPUT_FORMAT_CSV //!< A header line, then a line per grid.
+} TMainOutputFormat;
+
+/** The duration in nanoseconds of each step of a grid solving. */
+typedef struct
+{
+	unsigned long long Loading_Duration; //!< Read the grid cell values.
+	unsigned long long Bitmasks_Generation_Duration; //!< Create the grid bitmasks and empty cells stack.
+	unsigned long long Dispatch_Duration; //!< Wait for an available worker, give it the grid and wake it up.
+	unsigned long long First_Solution_Duration; //!< From the dispatch beginning to the first solution found by a worker, or 0 if no solution was found.
+	unsigned long long Search_Duration; //!< From the dispatch end to the solution or to the search space exhaustion.
+	unsigned long long Teardown_Duration; //!< Retrieve the result, then wait for all workers to abandon their remaining jobs.
+} TMainPhasesDurations;
+
+/** A corpus chunk solved by its own thread and solver. */
+typedef struct
+{
+	TCorpus *Pointer_Corpus; //!< The corpus the chunk belongs to.
+	int Chunk_Index; //!< The chunk to solve.
+	TSolver *Pointer_Solver; //!< The solver of the chunk grids.
+	TGrid Grid; //!< The grid being solved.
+	FILE *Pointer_Output_File; //!< Where the result lines are written : the standard output for the first chunk, a temporary file for the next chunks, as their results can only be printed after the previous chunks ones.
+	unsigned int Grids_Count; //!< How many grids have been read from the chunk.
+	unsigned int Solved_Grids_Count; //!< How many grids of the chunk have been solved.
+	int Return_Value; //!< Set to -2 if at least one grid of the chunk could not be loaded or solved.
+	pthread_t Thread; //!< The thread solving the chunk (the first chunk is solved by the main thread).
+} TMainCorpusChunkSolver;
+
 //-------------------------------------------------------------------------------------------------
 // Private variables
 //-------------------------------------------------------------------------------------------------
 /** How many threads to use to solve the sudoku. */
 static int Main_Total_Allowed_Workers_Count;
+/** The workers solving the grids. */
+static TWorkerPool Main_Worker_Pool;
 
 /** Hold the grid to solve at the beginning of the program, hold the solved grid at the end. */
 static TGrid Main_Grid;
 
+/** When not zero, count the grid solutions (up to this amount plus one) instead of solving the grid. */
+static unsigned long long Main_Maximum_Solutions_Count = 0;
+/** How many solutions have been counted for the last grid. */
+static unsigned long long Main_Solutions_Count;
+/** The statistics of each worker for the last grid. */
+static TWorkerStatistics Main_Workers_Statistics[CONFIGURATION_WORKERS_MAXIMUM_COUNT];
+/** The sum of all workers statistics for the last grid. */
+static TWorkerStatistics Main_Total_Statistics;
+/** The shortest time a worker has been busy for the last grid. */
+static unsigned long long Main_Minimum_Busy_Time;
+/** The longest time a worker has been busy for the last grid. */
+static unsigned long long Main_Maximum_Busy_Time;
+
+/** Set to 1 to race several strategies on each grid instead of sharing a single search tree between the workers. */
+static int Main_Is_Portfolio_Mode_Enabled = 0;
+/** The strategy of the worker that found the last grid solution in portfolio mode. */
+static TWorkerStrategy Main_Winning_Strategy;
+/** The rank of the winning strategy in the portfolio, or -1 if there is no winning strategy. */
+static int Main_Winning_Strategy_Index;
+
+/** The seed of the randomized search, or 0 if the search is deterministic. */
+static unsigned long long Main_Random_Seed = 0;
+
+/** The refuted states table size in megabytes, or 0 if the table is not used. */
+static unsigned long long Main_Refuted_States_Table_Size = 0;
+
+/** Set to 1 when the batch file is a corpus, so the solutions are printed in the corpus format too. */
+static int Main_Is_Corpus_Format_Enabled = 0;
+/** How many grids have been read by all corpus chunk solvers, so the progress can be shown. This is only accessed with atomic operations. */
+static unsigned int Main_Corpus_Read_Grids_Count = 0;
+
+/** How the results are printed. */
+static TMainOutputFormat Main_Output_Format = MAIN_OUTPUT_FORMAT_TEXT;
+/** The last grid phases durations. */
+static TMainPhasesDurations Main_Phases_Durations;
+
+/** The names of the numerical fields printed by the machine-readable output formats, in printing order. */
+static const char *Main_Result_Field_Names[MAIN_RESULT_FIELDS_COUNT] = {"solutions_count", "explored_nodes", "loading_ns", "bitmasks_generation_ns", "dispatch_ns", "first_solution_ns", "search_ns", "teardown_ns", "total_ns", "backtracks", "dead_ends", "received_jobs", "busy_ns", "idle_ns", "worker_minimum_busy_ns", "worker_maximum_busy_ns", "restarts", "random_seed", "refuted_states_hits", "refuted_states_misses", "scalar_propagations", "board_propagations"};
+
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
 /** Called when the program exits. */
 static void MainExit(void)
 {
-	WorkerUninitialize();
+	WorkerUninitialize(&Main_Worker_Pool);
+}
+
+/** Compute the statistics of the last grid from the workers statistics retrieved before and after the grid was solved.
+ * @param Workers_Statistics_Before The workers statistics before the grid was given to the workers.
+ */
+static void MainComputeStatistics(TWorkerStatistics Workers_Statistics_Before[])
+{
+	int i;
+	TWorkerStatistics *Pointer_Statistics;
+	
+	WorkerGetStatistics(&Main_Worker_Pool, Main_Workers_Statistics);
+	memset(&Main_Total_Statistics, 0, sizeof(Main_Total_Statistics));
+	Main_Minimum_Busy_Time = (unsigned long long) -1;
+	Main_Maximum_Busy_Time = 0;
+	
+	for (i = 0; i < Main_Total_Allowed_Workers_Count; i++)
+	{
+		// Keep only what has been done for this grid
+		Pointer_Statistics = &Main_Workers_Statistics[i];
+		Pointer_Statistics->Explored_Nodes_Count -= Workers_Statistics_Before[i].Explored_Nodes_Count;
+		Pointer_Statistics->Backtracks_Count -= Workers_Statistics_Before[i].Backtracks_Count;
+		Pointer_Statistics->Dead_Ends_Count -= Workers_Statistics_Before[i].Dead_Ends_Count;
+		Pointer_Statistics->Received_Jobs_Count -= Workers_Statistics_Before[i].Received_Jobs_Count;
+		Pointer_Statistics->Restarts_Count -= Workers_Statistics_Before[i].Restarts_Count;
+		Pointer_Statistics->Refuted_States_Hits_Count -= Workers_Statistics_Before[i].Refuted_States_Hits_Count;
+		Pointer_Statistics->Refuted_States_Misses_Count -= Workers_Statistics_Before[i].Refuted_States_Misses_Count;
+		Pointer_Statistics->Scalar_Propagations_Count -= Workers_Statistics_Before[i].Scalar_Propagations_Count;
+		Pointer_Statistics->Board_Propagations_Count -= Workers_Statistics_Before[i].Board_Propagations_Count;
+		Pointer_Statistics->Busy_Time -= Workers_Statistics_Before[i].Busy_Time;
+		Pointer_Statistics->Idle_Time -= Workers_Statistics_Before[i].Idle_Time;
+		
+		// Sum all workers statistics
+		Main_Total_Statistics.Explored_Nodes_Count += Pointer_Statistics->Explored_Nodes_Count;
+		Main_Total_Statistics.Backtracks_Count += Pointer_Statistics->Backtracks_Count;
+		Main_Total_Statistics.Dead_Ends_Count += Pointer_Statistics->Dead_Ends_Count;
+		Main_Total_Statistics.Received_Jobs_Count += Pointer_Statistics->Received_Jobs_Count;
+		Main_Total_Statistics.Restarts_Count += Pointer_Statistics->Restarts_Count;
+		Main_Total_Statistics.Refuted_States_Hits_Count += Pointer_Statistics->Refuted_States_Hits_Count;
+		Main_Total_Statistics.Refuted_States_Misses_Count += Pointer_Statistics->Refuted_States_Misses_Count;
+		Main_Total_Statistics.Scalar_Propagations_Count += Pointer_Statistics->Scalar_Propagations_Count;
+		Main_Total_Statistics.Board_Propagations_Count += Pointer_Statistics->Board_Propagations_Count;
+		Main_Total_Statistics.Busy_Time += Pointer_Statistics->Busy_Time;
+		Main_Total_Statistics.Idle_Time += Pointer_Statistics->Idle_Time;
+		
+		// The busy time spread tells whether the work was well balanced
+		if (Pointer_Statistics->Busy_Time < Main_Minimum_Busy_Time) Main_Minimum_Busy_Time = Pointer_Statistics->Busy_Time;
+		if (Pointer_Statistics->Busy_Time > Main_Maximum_Busy_Time) Main_Maximum_Busy_Time = Pointer_Statistics->Busy_Time;
+	}
 }
 
-/** Start solving a grid using the backtrack algorithm. Fill a number and transfer the grid to a worker.
- * @return 0 if the grid could not be solved,
+/** Start solving a grid. Provide the grid to a worker, the other workers will take the unexplored parts of its search tree when they are idle. In portfolio mode, all workers are given the grid and race with different strategies.
+ * @return -1 if a worker failed, so it is unknown whether the grid has a solution (an error message has been printed),
+ * @return 0 if the grid could not be solved (this is always the case when counting solutions, see Main_Solutions_Count),
  * @return 1 if the grid was successfully solved.
  */
 static int MainManageWorkers(void)
 {
-	unsigned int Row, Column, Bitmask_Missing_Numbers, Grid_Size, Tested_Number;
-	int i;
+	int Is_Grid_Solved;
 	TWorker *Pointer_Worker;
+	unsigned long long Dispatch_Starting_Time, Search_Starting_Time, Teardown_Starting_Time, First_Solution_Time;
+	static TWorkerStatistics Workers_Statistics_Before[CONFIGURATION_WORKERS_MAXIMUM_COUNT]; // Static to avoid using too much stack
+	
+	// All workers are idle, so their statistics are accurate
+	WorkerGetStatistics(&Main_Worker_Pool, Workers_Statistics_Before);
+	
+	// Provide the whole grid to the first ready worker
+	Dispatch_Starting_Time = TimerGetNanoseconds();
+	if (Main_Is_Portfolio_Mode_Enabled) WorkerSolvePortfolio(&Main_Worker_Pool, &Main_Grid);
+	else
+	{
+		WorkerWaitForAvailableWorker(&Main_Worker_Pool, &Pointer_Worker);
+		GridCopy(&Main_Grid, &Pointer_Worker->Grid);
+		WorkerSolve(Pointer_Worker);
+	}
 	
-	// Cache grid size
-	Grid_Size = Main_Grid.Grid_Size;
+	// Wait for a result
+	Search_Starting_Time = TimerGetNanoseconds();
+	Is_Grid_Solved = WorkerWaitForCompletion(&Main_Worker_Pool, &Pointer_Worker);
+	Teardown_Starting_Time = TimerGetNanoseconds();
 	
-	// Walk across all cells to set the first empty one value, then provide it to a worker
-	for (Row = 0; Row < Grid_Size; Row++)
+	// Keep the solved grid to avoid searching for it another time when the function terminates
+	if (Is_Grid_Solved > 0) GridCopy(&Pointer_Worker->Grid, &Main_Grid);
+	if ((Is_Grid_Solved > 0) && Main_Is_Portfolio_Mode_Enabled)
 	{
-		for (Column = 0; Column < Grid_Size; Column++)
+		Main_Winning_Strategy = Pointer_Worker->Strategy;
+		Main_Winning_Strategy_Index = Pointer_Worker->Portfolio_Strategy_Index;
+	}
+	else Main_Winning_Strategy_Index = -1;
+	Main_Solutions_Count = WorkerGetSolutionsCount(&Main_Worker_Pool);
+	First_Solution_Time = WorkerGetFirstSolutionTime(&Main_Worker_Pool);
+	
+	// Make the workers available for the next grid (this is fast as the remaining jobs have been cancelled)
+	WorkerWaitForAllWorkersIdle(&Main_Worker_Pool);
+	
+	// Keep the statistics of this grid
+	Main_Phases_Durations.Dispatch_Duration = Search_Starting_Time - Dispatch_Starting_Time;
+	Main_Phases_Durations.Search_Duration = Teardown_Starting_Time - Search_Starting_Time;
+	Main_Phases_Durations.Teardown_Duration = TimerGetNanoseconds() - Teardown_Starting_Time;
+	if (First_Solution_Time == 0) Main_Phases_Durations.First_Solution_Duration = 0;
+	else Main_Phases_Durations.First_Solution_Duration = First_Solution_Time - Dispatch_Starting_Time;
+	MainComputeStatistics(Workers_Statistics_Before);
+	
+	return Is_Grid_Solved;
+}
+
+/** Convert the solved grid to a string, using the format the grids were read with.
+ * @param String_Solution On output, contain the solution. Make sure string has at least GRID_STRING_MAXIMUM_LENGTH + 1 bytes room.
+ */
+static void MainConvertSolutionToString(char *String_Solution)
+{
+	if (Main_Is_Corpus_Format_Enabled) GridConvertToCorpusString(&Main_Grid, String_Solution);
+	else GridConvertToString(&Main_Grid, String_Solution);
+}
+
+/** Print a string using the quoting rules of the machine-readable output format.
+ * @param String The string to print.
+ */
+static void MainPrintQuotedString(const char *String)
+{
+	if (Main_Output_Format == MAIN_OUTPUT_FORMAT_JSON)
+	{
+		// Escape the quotes, the backslashes and the control characters
+		putchar('"');
+		for ( ; *String != 0; String++)
+		{
+			if ((*String == '"') || (*String == '\\')) printf("\\%c", *String);
+			else if ((unsigned char) *String < 0x20) printf("\\u%04X", *String);
+			else putchar(*String);
+		}
+		putchar('"');
+	}
+	else
+	{
+		// Only the fields containing a separator, a quote or a new line need to be quoted, the quotes being doubled
+		if (strpbrk(String, ",\"\r\n") == NULL)
 		{
-			// Is this cell empty ?
-			Bitmask_Missing_Numbers = GridGetCellMissingNumbers(&Main_Grid, Row, Column);
-			if (Bitmask_Missing_Numbers == 0) continue; // The cell is not empty
+			printf("%s", String);
+			return;
+		}
+		putchar('"');
+		for ( ; *String != 0; String++)
+		{
+			if (*String == '"') putchar('"');
+			putchar(*String);
+		}
+		putchar('"');
+	}
+}
+
+/** Print the names of the fields of the machine-readable output formats (only the CSV format has a header). */
+static void MainPrintResultHeader(void)
+{
+	int i;
+	
+	if (Main_Output_Format != MAIN_OUTPUT_FORMAT_CSV) return;
+	
+	printf("grid,result");
+	for (i = 0; i < MAIN_RESULT_FIELDS_COUNT; i++) printf(",%s", Main_Result_Field_Names[i]);
+	printf(",winning_strategy,solution\n");
+}
+
+/** Print the result and the statistics of the last grid with a machine-readable output format.
+ * @param String_Grid_Name The grid file name, or the grid line number in batch mode.
+ * @param String_Result A keyword telling how the grid solving terminated ("solved", "no_solution", "counted", "too_many_solutions", "bad_grid" or "error").
+ * @param Is_Grid_Loaded Set to 0 if the grid could not be loaded, so the statistics are meaningless and are not printed.
+ * @param Is_Grid_Solved Set to 1 to print the solution (and the winning strategy in portfolio mode).
+ */
+static void MainPrintResult(char *String_Grid_Name, char *String_Result, int Is_Grid_Loaded, int Is_Grid_Solved)
+{
+	unsigned long long Values[MAIN_RESULT_FIELDS_COUNT];
+	int Is_Value_Available[MAIN_RESULT_FIELDS_COUNT], i;
+	static char String_Solution[GRID_STRING_MAXIMUM_LENGTH + 1]; // Static to avoid using too much stack
+	char String_Strategy[WORKER_STRATEGY_STRING_MAXIMUM_LENGTH + 1];
+	
+	// Gather the numerical fields, in the same order than their names
+	Values[0] = Main_Solutions_Count > Main_Maximum_Solutions_Count ? Main_Maximum_Solutions_Count : Main_Solutions_Count;
+	Values[1] = Main_Total_Statistics.Explored_Nodes_Count;
+	Values[2] = Main_Phases_Durations.Loading_Duration;
+	Values[3] = Main_Phases_Durations.Bitmasks_Generation_Duration;
+	Values[4] = Main_Phases_Durations.Dispatch_Duration;
+	Values[5] = Main_Phases_Durations.First_Solution_Duration;
+	Values[6] = Main_Phases_Durations.Search_Duration;
+	Values[7] = Main_Phases_Durations.Teardown_Duration;
+	Values[8] = Main_Phases_Durations.Loading_Duration + Main_Phases_Durations.Bitmasks_Generation_Duration + Main_Phases_Durations.Dispatch_Duration + Main_Phases_Durations.Search_Duration + Main_Phases_Durations.Teardown_Duration;
+	Values[9] = Main_Total_Statistics.Backtracks_Count;
+	Values[10] = Main_Total_Statistics.Dead_Ends_Count;
+	Values[11] = Main_Total_Statistics.Received_Jobs_Count;
+	Values[12] = Main_Total_Statistics.Busy_Time;
+	Values[13] = Main_Total_Statistics.Idle_Time;
+	Values[14] = Main_Minimum_Busy_Time;
+	Values[15] = Main_Maximum_Busy_Time;
+	Values[16] = Main_Total_Statistics.Restarts_Count;
+	Values[17] = Main_Random_Seed;
+	Values[18] = Main_Total_Statistics.Refuted_States_Hits_Count;
+	Values[19] = Main_Total_Statistics.Refuted_States_Misses_Count;
+	Values[20] = Main_Total_Statistics.Scalar_Propagations_Count;
+	Values[21] = Main_Total_Statistics.Board_Propagations_Count;
+	for (i = 0; i < MAIN_RESULT_FIELDS_COUNT; i++) Is_Value_Available[i] = Is_Grid_Loaded;
+	Is_Value_Available[0] = Is_Grid_Loaded && (Main_Maximum_Solutions_Count > 0);
+	Is_Value_Available[5] = Is_Grid_Loaded && (Main_Phases_Durations.First_Solution_Duration > 0);
+	Is_Value_Available[17] = Is_Grid_Loaded && (Main_Random_Seed != 0);
+	Is_Value_Available[18] = Is_Value_Available[19] = Is_Grid_Loaded && (Main_Refuted_States_Table_Size > 0);
+	
+	if (Main_Output_Format == MAIN_OUTPUT_FORMAT_JSON)
+	{
+		printf("{\"grid\":");
+		MainPrintQuotedString(String_Grid_Name);
+		printf(",\"result\":\"%s\"", String_Result);
+		for (i = 0; i < MAIN_RESULT_FIELDS_COUNT; i++)
+		{
+			if (Is_Value_Available[i]) printf(",\"%s\":%llu", Main_Result_Field_Names[i], Values[i]);
+			else printf(",\"%s\":null", Main_Result_Field_Names[i]);
+		}
+		
+		// Detail each worker statistics to show the load balancing
+		printf(",\"workers\":");
+		if (Is_Grid_Loaded)
+		{
+			for (i = 0; i < Main_Total_Allowed_Workers_Count; i++)
+			{
+				if (i == 0) putchar('[');
+				else putchar(',');
+				printf("{\"explored_nodes\":%llu,\"backtracks\":%llu,\"dead_ends\":%llu,\"received_jobs\":%llu,\"restarts\":%llu,\"busy_ns\":%llu,\"idle_ns\":%llu}", Main_Workers_Statistics[i].Explored_Nodes_Count, Main_Workers_Statistics[i].Backtracks_Count,
+					Main_Workers_Statistics[i].Dead_Ends_Count, Main_Workers_Statistics[i].Received_Jobs_Count, Main_Workers_Statistics[i].Restarts_Count, Main_Workers_Statistics[i].Busy_Time, Main_Workers_Statistics[i].Idle_Time);
+			}
+			putchar(']');
+		}
+		else printf("null");
+		
+		printf(",\"winning_strategy\":");
+		if (Is_Grid_Solved && (Main_Winning_Strategy_Index >= 0))
+		{
+			WorkerConvertStrategyToString(&Main_Winning_Strategy, String_Strategy);
+			MainPrintQuotedString(String_Strategy);
+		}
+		else printf("null");
+		
+		printf(",\"solution\":");
+		if (Is_Grid_Solved)
+		{
+			MainConvertSolutionToString(String_Solution);
+			MainPrintQuotedString(String_Solution);
+		}
+		else printf("null");
+		printf("}\n");
+	}
+	else
+	{
+		MainPrintQuotedString(String_Grid_Name);
+		printf(",%s", String_Result);
+		for (i = 0; i < MAIN_RESULT_FIELDS_COUNT; i++)
+		{
+			if (Is_Value_Available[i]) printf(",%llu", Values[i]);
+			else putchar(',');
+		}
+		putchar(',');
+		if (Is_Grid_Solved && (Main_Winning_Strategy_Index >= 0))
+		{
+			WorkerConvertStrategyToString(&Main_Winning_Strategy, String_Strategy);
+			MainPrintQuotedString(String_Strategy);
+		}
+		putchar(',');
+		if (Is_Grid_Solved)
+		{
+			MainConvertSolutionToString(String_Solution);
+			MainPrintQuotedString(String_Solution);
+		}
+		putchar('\n');
+	}
+}
+
+/** Give the keyword telling how the last grid solving terminated.
+ * @param Is_Grid_Solved The value returned by MainManageWorkers().
+ * @return The keyword to provide to MainPrintResult().
+ */
+static char *MainGetResultKeyword(int Is_Grid_Solved)
+{
+	if (Is_Grid_Solved < 0) return "error";
+	if (Main_Maximum_Solutions_Count > 0)
+	{
+		if (Main_Solutions_Count == 0) return "no_solution";
+		if (Main_Solutions_Count > Main_Maximum_Solutions_Count) return "too_many_solutions";
+		return "counted";
+	}
+	
+	if (Is_Grid_Solved) return "solved";
+	return "no_solution";
+}
+
+/** Print how many grids of a batch file have been solved and the solving speed to the error output.
+ * @param Solved_Grids_Count How many grids have been solved.
+ * @param Grids_Count How many grids have been read.
+ * @param Starting_Time When the batch file was opened (see TimerGetNanoseconds()).
+ */
+static void MainPrintBatchSpeed(unsigned int Solved_Grids_Count, unsigned int Grids_Count, unsigned long long Starting_Time)
+{
+	double Elapsed_Seconds;
+	
+	Elapsed_Seconds = (TimerGetNanoseconds() - Starting_Time) / 1000000000.0;
+	fprintf(stderr, "Solved %u grid(s) out of %u in %.3f second(s)", Solved_Grids_Count, Grids_Count, Elapsed_Seconds);
+	if (Elapsed_Seconds > 0) fprintf(stderr, " (%.1f grids/second)", Grids_Count / Elapsed_Seconds);
+	fprintf(stderr, ".\n");
+}
+
+/** Solve all grids of a batch file (one grid per line, all rows of a grid being concatenated), keeping the same workers from a grid to another. Print a solution per line and the solving speed. When the corpus format is enabled, the file is memory-mapped and its records are parsed straight into the grid (see Corpus.h), this function being used for the corpus only when MainSolveCorpus() can't be.
+ * @param String_Batch_File_Name The file containing the grids, or "-" to read the grids from the standard input (except for a corpus).
+ * @return 0 if all grids were successfully solved,
+ * @return -1 if the file could not be opened,
+ * @return -2 if at least one grid could not be loaded or solved, or if the corpus could not be mapped (an error message has been printed).
+ */
+static int MainSolveBatch(char *String_Batch_File_Name)
+{
+	FILE *Pointer_File = NULL;
+	TCorpus Corpus;
+	char String_Line[GRID_STRING_MAXIMUM_LENGTH + 3]; // +2 for the new line characters and +1 for terminating zero, this also allows to convert the solved grid in place
+	char String_Grid_Name[32];
+	int Return_Value = 0, Character, Is_Grid_Solved, Result, Is_Progress_Shown = 0;
+	unsigned int Grids_Count = 0, Solved_Grids_Count = 0;
+	unsigned long long Starting_Time, Phase_Starting_Time, Progress_Time;
+	
+	Starting_Time = TimerGetNanoseconds();
+	
+	// Try to open the file (the corpus records are counted by all allowed threads, which also loads the file in memory)
+	if (Main_Is_Corpus_Format_Enabled)
+	{
+		if (CorpusOpen(&Corpus, String_Batch_File_Name, Main_Total_Allowed_Workers_Count) != 0) return -2;
+		Is_Progress_Shown = isatty(STDERR_FILENO); // The progress message is overwritten each time, which only makes sense on a terminal
+	}
+	else if (strcmp(String_Batch_File_Name, "-") == 0) Pointer_File = stdin;
+	else
+	{
+		Pointer_File = fopen(String_Batch_File_Name, "rb");
+		if (Pointer_File == NULL) return -1;
+	}
+	
+	MainPrintResultHeader();
+	Progress_Time = Starting_Time;
+	
+	// Solve each grid
+	while (1)
+	{
+		// Tell how much of a big corpus remains, the records having been counted when the corpus was opened
+		if (Is_Progress_Shown && (TimerGetNanoseconds() - Progress_Time >= MAIN_CORPUS_PROGRESS_PERIOD))
+		{
+			fprintf(stderr, "Processed %u grid(s) out of %llu...\r", Grids_Count, Corpus.Records_Count);
+			Progress_Time = TimerGetNanoseconds();
+		}
+		
+		if (Main_Is_Corpus_Format_Enabled)
+		{
+			// The empty lines are skipped by the corpus reader
+			Phase_Starting_Time = TimerGetNanoseconds();
+			Result = CorpusReadGrid(&Corpus, &Main_Grid);
+			Main_Phases_Durations.Loading_Duration = TimerGetNanoseconds() - Phase_Starting_Time;
+			if (Result == 0) break;
+			if (Result == 1) Result = 0;
+			Grids_Count++;
+		}
+		else
+		{
+			if (fgets(String_Line, sizeof(String_Line), Pointer_File) == NULL) break;
+			
+			// Silently ignore empty lines
+			if ((String_Line[0] == '\n') || (String_Line[0] == '\r')) continue;
+			Grids_Count++;
 			
-			// Fill all available numbers
-			for (Tested_Number = 0; Tested_Number < Grid_Size; Tested_Number++)
+			// Discard the end of a too long line
+			if (strchr(String_Line, '\n') == NULL)
 			{
-				// Loop until an available number is found
-				if (!(Bitmask_Missing_Numbers & (1 << Tested_Number))) continue;
-				
-				// Provide this grid to a worker
-				GridSetCellValue(&Main_Grid, Row, Column, Tested_Number);
-				
-				// Find the first ready worker and assign it the grid
-				if (WorkerWaitForAvailableWorker(&Pointer_Worker) == 1)
-				{
-					// Keep the solved grid to avoid searching for it another time when the function terminates
-					GridCopy(&Pointer_Worker->Grid, &Main_Grid);
-					return 1;
-				}
-				else
+				do
 				{
-					// Provide the worker with the new grid to solve
-					GridCopy(&Main_Grid, &Pointer_Worker->Grid);
-					WorkerSolve(Pointer_Worker);
-				}
+					Character = fgetc(Pointer_File);
+				} while ((Character != '\n') && (Character != EOF));
+				if (strlen(String_Line) == sizeof(String_Line) - 1) String_Line[0] = 0; // Make sure the grid can't be loaded
 			}
 			
-			// Restore empty cell, each worker must receive a grid with only one value altered
-			GridSetCellValue(&Main_Grid, Row, Column, GRID_EMPTY_CELL_VALUE);
+			Phase_Starting_Time = TimerGetNanoseconds();
+			Result = GridLoadFromString(&Main_Grid, String_Line);
+			Main_Phases_Durations.Loading_Duration = TimerGetNanoseconds() - Phase_Starting_Time;
+		}
+		
+		// Always print a line per grid so results can be matched with the input file lines
+		sprintf(String_Grid_Name, "%u", Grids_Count);
+		if (Result != 0)
+		{
+			if (Main_Output_Format == MAIN_OUTPUT_FORMAT_TEXT) printf("Bad grid\n");
+			else MainPrintResult(String_Grid_Name, "bad_grid", 0, 0);
+			Return_Value = -2;
+			continue;
 		}
+		
+		Phase_Starting_Time = TimerGetNanoseconds();
+		GridUpdateFromCellValues(&Main_Grid);
+		Main_Phases_Durations.Bitmasks_Generation_Duration = TimerGetNanoseconds() - Phase_Starting_Time;
+		
+		Is_Grid_Solved = MainManageWorkers();
+		if ((Main_Maximum_Solutions_Count > 0) && (Is_Grid_Solved >= 0)) Is_Grid_Solved = Main_Solutions_Count > 0; // A grid is considered solved when it has at least one solution
+		if (Is_Grid_Solved > 0) Solved_Grids_Count++;
+		else Return_Value = -2;
+		
+		if (Main_Output_Format != MAIN_OUTPUT_FORMAT_TEXT)
+		{
+			MainPrintResult(String_Grid_Name, MainGetResultKeyword(Is_Grid_Solved), 1, (Is_Grid_Solved > 0) && (Main_Maximum_Solutions_Count == 0));
+			continue;
+		}
+		
+		// Print the solutions count instead of the solution when counting (a ">" prefix tells that the limit was exceeded)
+		if (Is_Grid_Solved < 0) printf("Error\n");
+		else if (Main_Maximum_Solutions_Count > 0)
+		{
+			if (Main_Solutions_Count > Main_Maximum_Solutions_Count) printf(">%llu\n", Main_Maximum_Solutions_Count);
+			else printf("%llu\n", Main_Solutions_Count);
+		}
+		else if (Is_Grid_Solved > 0)
+		{
+			MainConvertSolutionToString(String_Line);
+			printf("%s\n", String_Line);
+		}
+		else printf("No solution\n");
 	}
 	
-	// There is no more job to provide to workers, wait for a result
-	for (i = 0; i < Main_Total_Allowed_Workers_Count; i++)
+	MainPrintBatchSpeed(Solved_Grids_Count, Grids_Count, Starting_Time);
+	if (Main_Is_Corpus_Format_Enabled) CorpusClose(&Corpus);
+	else if (Pointer_File != stdin) fclose(Pointer_File);
+	return Return_Value;
+}
+
+/** Solve all grids of a corpus chunk with the chunk solver, and write a result line per grid like the batch mode text output. The first chunk also shows the progress of all chunks.
+ * @param Pointer_Argument The chunk solver.
+ * @return Unused value.
+ */
+static void *MainSolveCorpusChunk(void *Pointer_Argument)
+{
+	TMainCorpusChunkSolver *Pointer_Chunk_Solver = Pointer_Argument;
+	int Result, Is_Progress_Shown;
+	unsigned long long Solutions_Count, Progress_Time;
+	char String_Solution[GRID_STRING_MAXIMUM_LENGTH + 1];
+	
+	// The progress message is overwritten each time, which only makes sense on a terminal
+	Is_Progress_Shown = (Pointer_Chunk_Solver->Chunk_Index == 0) && isatty(STDERR_FILENO);
+	Progress_Time = TimerGetNanoseconds();
+	
+	while (1)
+	{
+		if (Is_Progress_Shown && (TimerGetNanoseconds() - Progress_Time >= MAIN_CORPUS_PROGRESS_PERIOD))
+		{
+			fprintf(stderr, "Processed %u grid(s) out of %llu...\r", __atomic_load_n(&Main_Corpus_Read_Grids_Count, __ATOMIC_RELAXED), Pointer_Chunk_Solver->Pointer_Corpus->Records_Count);
+			Progress_Time = TimerGetNanoseconds();
+		}
+		
+		// The empty lines are skipped by the corpus reader
+		Result = CorpusReadChunkGrid(Pointer_Chunk_Solver->Pointer_Corpus, Pointer_Chunk_Solver->Chunk_Index, &Pointer_Chunk_Solver->Grid);
+		if (Result == 0) break;
+		Pointer_Chunk_Solver->Grids_Count++;
+		__atomic_add_fetch(&Main_Corpus_Read_Grids_Count, 1, __ATOMIC_RELAXED);
+		if (Result < 0)
+		{
+			fprintf(Pointer_Chunk_Solver->Pointer_Output_File, "Bad grid\n");
+			Pointer_Chunk_Solver->Return_Value = -2;
+			continue;
+		}
+		
+		// Print the solutions count instead of the solution when counting (a ">" prefix tells that the limit was exceeded), a grid being considered solved when it has at least one solution
+		if (Main_Maximum_Solutions_Count > 0)
+		{
+			Result = SolverCountGridSolutions(Pointer_Chunk_Solver->Pointer_Solver, &Pointer_Chunk_Solver->Grid, Main_Maximum_Solutions_Count, &Solutions_Count);
+			if (Result < 0) fprintf(Pointer_Chunk_Solver->Pointer_Output_File, "Error\n");
+			else if (Solutions_Count > Main_Maximum_Solutions_Count) fprintf(Pointer_Chunk_Solver->Pointer_Output_File, ">%llu\n", Main_Maximum_Solutions_Count);
+			else fprintf(Pointer_Chunk_Solver->Pointer_Output_File, "%llu\n", Solutions_Count);
+			Result = (Result == 0) && (Solutions_Count > 0);
+		}
+		else
+		{
+			Result = SolverSolveGrid(Pointer_Chunk_Solver->Pointer_Solver, &Pointer_Chunk_Solver->Grid);
+			if (Result < 0) fprintf(Pointer_Chunk_Solver->Pointer_Output_File, "Error\n");
+			else if (Result == 0) fprintf(Pointer_Chunk_Solver->Pointer_Output_File, "No solution\n");
+			else
+			{
+				GridConvertToCorpusString(&Pointer_Chunk_Solver->Grid, String_Solution);
+				fprintf(Pointer_Chunk_Solver->Pointer_Output_File, "%s\n", String_Solution);
+			}
+		}
+		if (Result > 0) Pointer_Chunk_Solver->Solved_Grids_Count++;
+		else Pointer_Chunk_Solver->Return_Value = -2;
+	}
+	
+	return NULL;
+}
+
+/** Solve all grids of a corpus with the text output format, each corpus chunk being solved by its own thread with its own solver, the allowed threads being shared between the solvers. The chunks results are printed in the corpus order.
+ * @param String_Corpus_File_Name The corpus file.
+ * @param Algorithm The solvers search algorithm.
+ * @param Cell_Selection_Heuristic How the solvers select the next cell to fill.
+ * @param Propagation_Level How much deduction the solvers do each time they fill a cell.
+ * @return 0 if all grids were successfully solved,
+ * @return -2 if at least one grid could not be loaded or solved, or if the corpus could not be mapped or the solvers could not be created (an error message has been printed).
+ */
+static int MainSolveCorpus(char *String_Corpus_File_Name, TWorkerAlgorithm Algorithm, TWorkerCellSelectionHeuristic Cell_Selection_Heuristic, TGridPropagationLevel Propagation_Level)
+{
+	TCorpus Corpus;
+	TMainCorpusChunkSolver *Pointer_Chunk_Solvers, *Pointer_Chunk_Solver;
+	int Return_Value = 0, Workers_Count, Created_Threads_Count = 0, Is_Corpus_Solved, i;
+	unsigned int Grids_Count = 0, Solved_Grids_Count = 0;
+	unsigned long long Starting_Time;
+	char Buffer[4096];
+	size_t Read_Bytes_Count;
+	
+	Starting_Time = TimerGetNanoseconds();
+	
+	// The corpus records are counted by all allowed threads, which also splits the corpus in at most a chunk per thread
+	if (CorpusOpen(&Corpus, String_Corpus_File_Name, Main_Total_Allowed_Workers_Count) != 0) return -2;
+	Pointer_Chunk_Solvers = calloc(Corpus.Chunks_Count + 1, sizeof(TMainCorpusChunkSolver)); // An empty corpus has no chunk
+	if (Pointer_Chunk_Solvers == NULL)
+	{
+		fprintf(stderr, "Error : not enough memory to solve the corpus chunks.\n");
+		CorpusClose(&Corpus);
+		return -2;
+	}
+	
+	// Share the threads between the chunks
+	Workers_Count = Main_Total_Allowed_Workers_Count / (Corpus.Chunks_Count > 0 ? Corpus.Chunks_Count : 1);
+	for (i = 0; i < Corpus.Chunks_Count; i++)
+	{
+		Pointer_Chunk_Solver = &Pointer_Chunk_Solvers[i];
+		Pointer_Chunk_Solver->Pointer_Corpus = &Corpus;
+		Pointer_Chunk_Solver->Chunk_Index = i;
+		Pointer_Chunk_Solver->Pointer_Solver = SolverCreate(Workers_Count);
+		if (Pointer_Chunk_Solver->Pointer_Solver == NULL)
+		{
+			fprintf(stderr, "Error : failed to create the solver of the corpus chunk %d.\n", i);
+			Return_Value = -2;
+			break;
+		}
+		SolverSetDancingLinks(Pointer_Chunk_Solver->Pointer_Solver, Algorithm == WORKER_ALGORITHM_DANCING_LINKS);
+		SolverSetMostConstrainedCellHeuristic(Pointer_Chunk_Solver->Pointer_Solver, Cell_Selection_Heuristic == WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL);
+		SolverSetPropagationLevel(Pointer_Chunk_Solver->Pointer_Solver, Propagation_Level);
+		
+		if (i == 0) Pointer_Chunk_Solver->Pointer_Output_File = stdout;
+		else
+		{
+			Pointer_Chunk_Solver->Pointer_Output_File = tmpfile();
+			if (Pointer_Chunk_Solver->Pointer_Output_File == NULL)
+			{
+				fprintf(stderr, "Error : can't create the results file of the corpus chunk %d.\n", i);
+				Return_Value = -2;
+				break;
+			}
+		}
+	}
+	
+	// Solve the first chunk while the other threads solve the next chunks
+	if (Return_Value == 0)
 	{
-		if (WorkerWaitForAvailableWorker(&Pointer_Worker) == 1)
+		for (i = 1; i < Corpus.Chunks_Count; i++)
 		{
-			// Keep the solved grid to avoid searching for it another time when the function terminates
-			GridCopy(&Pointer_Worker->Grid, &Main_Grid);
-			return 1;
+			if (pthread_create(&Pointer_Chunk_Solvers[i].Thread, NULL, MainSolveCorpusChunk, &Pointer_Chunk_Solvers[i]) != 0)
+			{
+				fprintf(stderr, "Error : failed to create the thread of the corpus chunk %d.\n", i);
+				Return_Value = -2;
+				break;
+			}
+			Created_Threads_Count++;
 		}
-		// Shut worker down to avoid wasting cycles
-		else WorkerExit(Pointer_Worker);
+		if ((Return_Value == 0) && (Corpus.Chunks_Count > 0)) MainSolveCorpusChunk(&Pointer_Chunk_Solvers[0]);
+	}
+	
+	// Print the next chunks results after the first chunk ones, in the corpus order
+	for (i = 1; i <= Created_Threads_Count; i++)
+	{
+		Pointer_Chunk_Solver = &Pointer_Chunk_Solvers[i];
+		pthread_join(Pointer_Chunk_Solver->Thread, NULL);
+		if (Return_Value != 0) continue;
+		
+		rewind(Pointer_Chunk_Solver->Pointer_Output_File);
+		while ((Read_Bytes_Count = fread(Buffer, 1, sizeof(Buffer), Pointer_Chunk_Solver->Pointer_Output_File)) > 0) fwrite(Buffer, 1, Read_Bytes_Count, stdout);
+	}
+	
+	// Gather the chunks results (the solving speed is meaningless if the chunks could not all be solved)
+	Is_Corpus_Solved = Return_Value == 0;
+	for (i = 0; i < Corpus.Chunks_Count; i++)
+	{
+		Pointer_Chunk_Solver = &Pointer_Chunk_Solvers[i];
+		Grids_Count += Pointer_Chunk_Solver->Grids_Count;
+		Solved_Grids_Count += Pointer_Chunk_Solver->Solved_Grids_Count;
+		if (Pointer_Chunk_Solver->Return_Value != 0) Return_Value = Pointer_Chunk_Solver->Return_Value;
+		
+		if (Pointer_Chunk_Solver->Pointer_Solver != NULL) SolverDestroy(Pointer_Chunk_Solver->Pointer_Solver);
+		if ((Pointer_Chunk_Solver->Pointer_Output_File != NULL) && (Pointer_Chunk_Solver->Pointer_Output_File != stdout)) fclose(Pointer_Chunk_Solver->Pointer_Output_File);
 	}
 	
-	return 0;
+	free(Pointer_Chunk_Solvers);
+	CorpusClose(&Corpus);
+	if (Is_Corpus_Solved) MainPrintBatchSpeed(Solved_Grids_Count, Grids_Count, Starting_Time);
+	return Return_Value;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -99,23 +720,152 @@ static int MainManageWorkers(void)
 //-------------------------------------------------------------------------------------------------
 int main(int argc, char *argv[])
 {
-	char *String_Grid_File_Name;
-	int Is_Grid_Solved;
-	time_t Starting_Time, Ending_Time, Seconds, Minutes, Hours;
+	char *String_Grid_File_Name, *String_Affinity_Policy = NULL, String_Strategy[WORKER_STRATEGY_STRING_MAXIMUM_LENGTH + 1];
+	int Is_Grid_Solved, Option, Is_Batch_Mode_Enabled = 0, Propagation_Level = GRID_PROPAGATION_LEVEL_NONE, Result, i, Server_Solvers_Count = 0, Server_Workers_Count, Is_Restart_Policy_Set = 0, Parsed_Characters_Count;
+	TWorkerAlgorithm Algorithm = WORKER_ALGORITHM_BACKTRACK;
+	TWorkerRestartPolicy Restart_Policy = WORKER_RESTART_POLICY_NONE;
+	unsigned long long Restart_Nodes_Count = 0;
+	double Restart_Growth_Factor = 0;
+	TWorkerCellSelectionHeuristic Cell_Selection_Heuristic = WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL;
+	time_t Starting_Date, Ending_Date;
+	unsigned long long Starting_Time, Phase_Starting_Time, Elapsed_Nanoseconds, Seconds, Minutes, Hours;
+	TAffinityProcessor Workers_Placement[CONFIGURATION_WORKERS_MAXIMUM_COUNT];
+	
+	// Check options
+	while ((Option = getopt(argc, argv, "a:bc:d:fkmo:p:r:s:t:x")) != -1)
+	{
+		switch (Option)
+		{
+			case 'a':
+				String_Affinity_Policy = optarg;
+				break;
+				
+			case 'b':
+				Is_Batch_Mode_Enabled = 1;
+				break;
+				
+			case 'c':
+				Main_Maximum_Solutions_Count = strtoull(optarg, NULL, 10);
+				if (Main_Maximum_Solutions_Count == 0)
+				{
+					printf("Error : the maximum solutions count must be a number greater than or equal to 1.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'd':
+				Main_Refuted_States_Table_Size = strtoull(optarg, NULL, 10);
+				if (Main_Refuted_States_Table_Size == 0)
+				{
+					printf("Error : the refuted states table size must be a number of megabytes greater than or equal to 1.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'f':
+				Main_Is_Portfolio_Mode_Enabled = 1;
+				break;
+				
+			case 'k':
+				Is_Batch_Mode_Enabled = 1;
+				Main_Is_Corpus_Format_Enabled = 1;
+				break;
+				
+			case 'm':
+				Cell_Selection_Heuristic = WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL;
+				break;
+				
+			case 'o':
+				if (strcmp(optarg, "text") == 0) Main_Output_Format = MAIN_OUTPUT_FORMAT_TEXT;
+				else if (strcmp(optarg, "json") == 0) Main_Output_Format = MAIN_OUTPUT_FORMAT_JSON;
+				else if (strcmp(optarg, "csv") == 0) Main_Output_Format = MAIN_OUTPUT_FORMAT_CSV;
+				else
+				{
+					printf("Error : the output format must be text, json or csv.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'p':
+				Propagation_Level = atoi(optarg);
+				if ((Propagation_Level < GRID_PROPAGATION_LEVEL_NONE) || (Propagation_Level > GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES))
+				{
+					printf("Error : the propagation level must be in range [%d; %d].\n", GRID_PROPAGATION_LEVEL_NONE, GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'r':
+				Main_Random_Seed = strtoull(optarg, NULL, 10);
+				if (Main_Random_Seed == 0)
+				{
+					printf("Error : the random seed must be a number greater than or equal to 1.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 's':
+				Server_Solvers_Count = atoi(optarg);
+				if (Server_Solvers_Count <= 0)
+				{
+					printf("Error : the solvers count must be a number greater than or equal to 1.\n");
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 't':
+				// The trailing %n makes sure that nothing follows the parameters
+				Parsed_Characters_Count = 0;
+				if (strcmp(optarg, "none") == 0) Restart_Policy = WORKER_RESTART_POLICY_NONE;
+				else if ((sscanf(optarg, "luby:%llu%n", &Restart_Nodes_Count, &Parsed_Characters_Count) == 1) && (optarg[Parsed_Characters_Count] == 0) && (Restart_Nodes_Count > 0)) Restart_Policy = WORKER_RESTART_POLICY_LUBY;
+				else if ((sscanf(optarg, "geometric:%llu:%lf%n", &Restart_Nodes_Count, &Restart_Growth_Factor, &Parsed_Characters_Count) == 2) && (optarg[Parsed_Characters_Count] == 0) && (Restart_Nodes_Count > 0) && (Restart_Growth_Factor > 1)) Restart_Policy = WORKER_RESTART_POLICY_GEOMETRIC;
+				else
+				{
+					printf("Error : the restart policy must be none, luby:Nodes_Count or geometric:Nodes_Count:Growth_Factor, the nodes count being greater than or equal to 1 and the growth factor greater than 1.\n");
+					return EXIT_FAILURE;
+				}
+				Is_Restart_Policy_Set = 1;
+				break;
+				
+			case 'x':
+				Algorithm = WORKER_ALGORITHM_DANCING_LINKS;
+				break;
+				
+			default:
+				argc = 0; // Force usage display
+				break;
+		}
+	}
 	
-	// Show the title
-	printf("+------------------------+\n");
-	printf("| Parallel Sudoku Solver |\n");
-	printf("+------------------------+\n\n");
+	// Show the title (the batch mode and the machine-readable formats only display results to make the output easy to parse)
+	if (!Is_Batch_Mode_Enabled && (Main_Output_Format == MAIN_OUTPUT_FORMAT_TEXT))
+	{
+		printf("+------------------------+\n");
+		printf("| Parallel Sudoku Solver |\n");
+		printf("+------------------------+\n\n");
+	}
 	
 	// Check parameters
-	if (argc != 3)
+	if (argc - optind != 2)
 	{
-		printf("Usage : %s Maximum_Parallel_Threads Grid_File_Name\n", argv[0]);
+		printf("Usage : %s [-a Policy] [-b] [-c Maximum_Count] [-d Megabytes] [-f] [-k] [-m] [-o Format] [-p Level] [-r Seed] [-s Solvers_Count] [-t Policy] [-x] Maximum_Parallel_Threads Grid_File_Name\n"
+			"  -a : bind each thread to a logical processor, compact fills the SMT threads of a core before using the next cores, scatter spreads the threads over all cores and last level caches before using their SMT threads, cores is like scatter but never uses the SMT threads, any other value is a processors list like 0,2,4-7. The chosen placement is printed.\n"
+			"  -b : batch mode, Grid_File_Name contains one grid per line (all grid rows are concatenated), use \"-\" to read the grids from the standard input.\n"
+			"  -c : count the grid solutions instead of solving the grid, stopping as soon as more than Maximum_Count solutions are found (use 1 to check that the grid has a single solution).\n"
+			"  -d : share the grid states proven unsolvable between the threads in a table of at most Megabytes megabytes, so a thread reaching a known unsolvable state skips it (the backtrack algorithm only). It is only used by the randomized searches that restart (see -r) and in portfolio mode. The table hits and misses are printed with the statistics.\n"
+			"  -f : portfolio mode, each thread searches the whole grid with its own strategy (algorithm, cell selection heuristic, propagation level and numbers order) instead of sharing a single search tree, the first thread to finish wins and the winning strategy is printed. -m, -p and -x are ignored, and the threads beyond the 8 fixed strategies run randomized searches (seeded from -r and restarting with -t).\n"
+			"  -k : corpus mode, like the batch mode but Grid_File_Name uses the common format of the big grid collections (the numbers start from 1, '0' or '.' being an empty cell, for instance 81 characters per 9x9 grid). The file is memory-mapped and split between the threads to count its grids, then each grid is parsed straight from the mapped file. The processed grids count is printed every second when the error output is a terminal. The solutions use the same format.\n"
+			"  -m : fill the most constrained cells (the ones having the fewest allowed numbers) first instead of filling the cells in order.\n"
+			"  -o : print the results as text (default), json (an object per grid) or csv (a header line, then a line per grid), the machine-readable formats also give each solving phase duration in nanoseconds.\n"
+			"  -p : deduce values each time a cell is filled, 0 disables the deduction (default), 1 fails as soon as a cell has no allowed number left, 2 also fills the cells having a single allowed number, 3 also fills the numbers having a single place in a row, a column or a square.\n"
+			"  -r : randomize the search with the provided seed (any number greater than or equal to 1), the numbers are tried in a random order, and so are the cells having the same constraints count (the dancing links rows in a random order), each thread deriving its own order from the seed. Randomizing only helps when the most constrained cells are filled first, so -r implies -m. A run is reproduced by giving the same seed and threads count. The search restarts from the grid when its explored nodes budget is exhausted, see -t. The solutions are never restarted from when counting.\n"
+			"  -s : server mode, Grid_File_Name is the UNIX socket to listen on. Clients send grids using the batch mode format and receive the batch mode text results. Solvers_Count grids can be solved at the same time, the threads being shared between the solvers.\n"
+			"  -t : the restart policy of the randomized search, none never restarts, luby:Nodes_Count gives the runs budgets following the Luby sequence (1, 1, 2, 1, 1, 2, 4...) times Nodes_Count, geometric:Nodes_Count:Growth_Factor starts from Nodes_Count and multiplies the budget by Growth_Factor after each restart (default is luby:1024).\n"
+			"  -x : solve the grids as an exact cover problem with the dancing links algorithm instead of the backtrack one, -m and -p are ignored.\n", argv[0]);
 		return EXIT_FAILURE;
 	}
-	Main_Total_Allowed_Workers_Count = atoi(argv[1]);
-	if (Main_Total_Allowed_Workers_Count == 0)
+	Main_Total_Allowed_Workers_Count = atoi(argv[optind]);
+	if (Main_Total_Allowed_Workers_Count <= 0)
 	{
 		printf("Error : maximum threads number must be a number greater than or equal to 1.\n");
 		return EXIT_FAILURE;
@@ -125,14 +875,112 @@ int main(int argc, char *argv[])
 		printf("Warning : program allows up to %d parallel threads, provided value %d has been decreased to %d.\n", CONFIGURATION_WORKERS_MAXIMUM_COUNT, Main_Total_Allowed_Workers_Count, CONFIGURATION_WORKERS_MAXIMUM_COUNT);
 		Main_Total_Allowed_Workers_Count = CONFIGURATION_WORKERS_MAXIMUM_COUNT;
 	}
-	String_Grid_File_Name = argv[2];
+	String_Grid_File_Name = argv[optind + 1];
+	if (Main_Is_Corpus_Format_Enabled && (strcmp(String_Grid_File_Name, "-") == 0))
+	{
+		printf("Error : the corpus can't be read from the standard input, as it must be memory-mapped.\n");
+		return EXIT_FAILURE;
+	}
+	if (Main_Is_Portfolio_Mode_Enabled && (Main_Maximum_Solutions_Count > 0))
+	{
+		printf("Error : the solutions can't be counted in portfolio mode, as each thread explores the whole search tree.\n");
+		return EXIT_FAILURE;
+	}
+	// Filling the cells in order leaves only the numbers order to randomize, which does not change the search tree size much, so the restarts would mostly throw away useful work
+	if (Main_Random_Seed != 0) Cell_Selection_Heuristic = WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL;
+	if ((Main_Refuted_States_Table_Size > 0) && !Main_Is_Portfolio_Mode_Enabled && ((Main_Random_Seed == 0) || (Is_Restart_Policy_Set && (Restart_Policy == WORKER_RESTART_POLICY_NONE)) || (Main_Maximum_Solutions_Count > 0)))
+	{
+		printf("Warning : the refuted states table only helps the searches that restart (-r without counting the solutions) and the portfolio mode, as a single search tree does not reach the same state twice, so -d is ignored.\n");
+		Main_Refuted_States_Table_Size = 0;
+	}
+	
+	// Keep solvers ready to serve the requests until the program is terminated
+	if (Server_Solvers_Count > 0)
+	{
+		if (String_Affinity_Policy != NULL)
+		{
+			printf("Error : the threads can't be bound to processors in server mode.\n");
+			return EXIT_FAILURE;
+		}
+		if (Main_Is_Portfolio_Mode_Enabled)
+		{
+			printf("Error : the portfolio mode is not available in server mode.\n");
+			return EXIT_FAILURE;
+		}
+		if ((Main_Random_Seed != 0) || Is_Restart_Policy_Set)
+		{
+			printf("Error : the randomized search is not available in server mode.\n");
+			return EXIT_FAILURE;
+		}
+		if (Main_Refuted_States_Table_Size > 0)
+		{
+			printf("Error : the refuted states table is not available in server mode.\n");
+			return EXIT_FAILURE;
+		}
+		if (Main_Is_Corpus_Format_Enabled)
+		{
+			printf("Error : the corpus mode is not available in server mode.\n");
+			return EXIT_FAILURE;
+		}
+		Server_Workers_Count = Main_Total_Allowed_Workers_Count / Server_Solvers_Count;
+		if (Server_Workers_Count < 1) Server_Workers_Count = 1;
+		ServerRun(String_Grid_File_Name, Server_Solvers_Count, Server_Workers_Count, Algorithm, Cell_Selection_Heuristic, Propagation_Level, Main_Maximum_Solutions_Count);
+		return EXIT_FAILURE;
+	}
+	
+	// Solve the corpus chunks at the same time, each chunk with its own threads, unless the results need the statistics or the settings only the main workers provide
+	if (Main_Is_Corpus_Format_Enabled && (Main_Output_Format == MAIN_OUTPUT_FORMAT_TEXT) && !Main_Is_Portfolio_Mode_Enabled && (Main_Random_Seed == 0) && !Is_Restart_Policy_Set && (Main_Refuted_States_Table_Size == 0) && (String_Affinity_Policy == NULL))
+	{
+		if (MainSolveCorpus(String_Grid_File_Name, Algorithm, Cell_Selection_Heuristic, Propagation_Level) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
 	
 	// Create all workers
-	if (WorkerInitialize(Main_Total_Allowed_Workers_Count) != 0) return EXIT_FAILURE;
+	if (WorkerInitialize(&Main_Worker_Pool, Main_Total_Allowed_Workers_Count) != 0) return EXIT_FAILURE;
 	atexit(MainExit); // Automatically release the worker resources when the program exits
+	WorkerSetAlgorithm(&Main_Worker_Pool, Algorithm);
+	WorkerSetCellSelectionHeuristic(&Main_Worker_Pool, Cell_Selection_Heuristic);
+	WorkerSetPropagationLevel(&Main_Worker_Pool, Propagation_Level);
+	WorkerSetMaximumSolutionsCount(&Main_Worker_Pool, Main_Maximum_Solutions_Count);
+	WorkerSetRandomSeed(&Main_Worker_Pool, Main_Random_Seed);
+	if (Is_Restart_Policy_Set) WorkerSetRestartPolicy(&Main_Worker_Pool, Restart_Policy, Restart_Nodes_Count, Restart_Growth_Factor);
+	if ((Main_Refuted_States_Table_Size > 0) && (WorkerSetRefutedStatesTableSize(&Main_Worker_Pool, Main_Refuted_States_Table_Size * 1024 * 1024) != 0)) return EXIT_FAILURE;
+	
+	// Keep each worker on its own processor (the placement goes to the error output when the results must be easy to parse)
+	if (String_Affinity_Policy != NULL)
+	{
+		if (AffinityComputePlacement(String_Affinity_Policy, Main_Total_Allowed_Workers_Count, Workers_Placement) != 0) return EXIT_FAILURE;
+		if (WorkerBindToProcessors(&Main_Worker_Pool, Workers_Placement) != 0) return EXIT_FAILURE;
+		if (!Is_Batch_Mode_Enabled && (Main_Output_Format == MAIN_OUTPUT_FORMAT_TEXT))
+		{
+			AffinityShowPlacement(stdout, String_Affinity_Policy, Main_Total_Allowed_Workers_Count, Workers_Placement);
+			putchar('\n');
+		}
+		else AffinityShowPlacement(stderr, String_Affinity_Policy, Main_Total_Allowed_Workers_Count, Workers_Placement);
+	}
+	
+	// Solve all grids of the batch file with the same workers
+	if (Is_Batch_Mode_Enabled)
+	{
+		switch (MainSolveBatch(String_Grid_File_Name))
+		{
+			case -1:
+				fprintf(stderr, "Error : can't open file %s.\n", String_Grid_File_Name);
+				return EXIT_FAILURE;
+				
+			case -2:
+				return EXIT_FAILURE;
+				
+			default:
+				return EXIT_SUCCESS;
+		}
+	}
 	
 	// Try to load the grid file
-	switch (GridLoadFromFile(&Main_Grid, String_Grid_File_Name))
+	Starting_Time = TimerGetNanoseconds();
+	Result = GridLoadFromFile(&Main_Grid, String_Grid_File_Name);
+	Main_Phases_Durations.Loading_Duration = TimerGetNanoseconds() - Starting_Time;
+	switch (Result)
 	{
 		case -1:
 			printf("Error : can't open file %s.\n", String_Grid_File_Name);
@@ -149,13 +997,28 @@ int main(int argc, char *argv[])
 		default:
 			break;
 	}
+	Phase_Starting_Time = TimerGetNanoseconds();
+	GridUpdateFromCellValues(&Main_Grid);
+	Main_Phases_Durations.Bitmasks_Generation_Duration = TimerGetNanoseconds() - Phase_Starting_Time;
+	
+	// Only print the result line when a machine-readable format is used
+	if (Main_Output_Format != MAIN_OUTPUT_FORMAT_TEXT)
+	{
+		Is_Grid_Solved = MainManageWorkers();
+		if ((Main_Maximum_Solutions_Count > 0) && (Is_Grid_Solved >= 0)) Is_Grid_Solved = Main_Solutions_Count > 0; // A grid is considered solved when it has at least one solution
+		MainPrintResultHeader();
+		MainPrintResult(String_Grid_File_Name, MainGetResultKeyword(Is_Grid_Solved), 1, (Is_Grid_Solved > 0) && (Main_Maximum_Solutions_Count == 0));
+		
+		if (Is_Grid_Solved > 0) return EXIT_SUCCESS;
+		return EXIT_FAILURE;
+	}
 	
 	// Display information about the grid to solve
 	// Display file name
 	printf("File : %s.\n", String_Grid_File_Name);
 	// Display starting time
-	Starting_Time = time(NULL);
-	printf("Started solving on %s\n", ctime(&Starting_Time));
+	Starting_Date = time(NULL);
+	printf("Started solving on %s\n", ctime(&Starting_Date));
 	// Display grid
 	printf("Grid to solve :\n");
 	GridShow(&Main_Grid);
@@ -164,19 +1027,60 @@ int main(int argc, char *argv[])
 	// Start solving
 	Is_Grid_Solved = MainManageWorkers();
 	
-	// Show elapsed time
-	Ending_Time = time(NULL);
-	printf("Ended solving on %s", ctime(&Ending_Time));
+	// Show elapsed time (from the grid loading)
+	Elapsed_Nanoseconds = TimerGetNanoseconds() - Starting_Time;
+	Ending_Date = time(NULL);
+	printf("Ended solving on %s", ctime(&Ending_Date));
 	// Compute elapsed time
 	printf("Elapsed time : ");
-	Seconds = Ending_Time - Starting_Time;
+	Seconds = Elapsed_Nanoseconds / 1000000000ULL;
 	Minutes = Seconds / 60;
 	Hours = Minutes / 60;
 	Seconds -= Minutes * 60; // Adjust seconds, if less than 1 minute elapsed this subtracts 0
 	Minutes -= Hours * 60; // Adjust minutes, if less than 1 hour elapsed this subtracts 0
-	if (Hours > 0) printf("%ld hour(s) ", Hours);
-	if ((Minutes > 0) || (Hours > 0)) printf("%ld minute(s) ", Minutes); // Always display minutes if hours are displayed
-	printf("%ld second(s).\n\n", Seconds);
+	if (Hours > 0) printf("%llu hour(s) ", Hours);
+	if ((Minutes > 0) || (Hours > 0)) printf("%llu minute(s) ", Minutes); // Always display minutes if hours are displayed
+	printf("%.3f second(s).\n", Seconds + (Elapsed_Nanoseconds % 1000000000ULL) / 1000000000.0);
+	printf("Explored nodes : %llu.\n", Main_Total_Statistics.Explored_Nodes_Count);
+	printf("Backtracks : %llu.\n", Main_Total_Statistics.Backtracks_Count);
+	printf("Dead ends : %llu.\n", Main_Total_Statistics.Dead_Ends_Count);
+	printf("Phases durations : loading %.3f ms, bitmasks generation %.3f ms, dispatch %.3f ms, search %.3f ms, teardown %.3f ms.\n", TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Phases_Durations.Loading_Duration), TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Phases_Durations.Bitmasks_Generation_Duration),
+		TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Phases_Durations.Dispatch_Duration), TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Phases_Durations.Search_Duration), TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Phases_Durations.Teardown_Duration));
+	if (Main_Random_Seed != 0) printf("Random seed : %llu, restarts : %llu.\n", Main_Random_Seed, Main_Total_Statistics.Restarts_Count);
+	if (Main_Refuted_States_Table_Size > 0) printf("Refuted states table : %llu hits, %llu misses.\n", Main_Total_Statistics.Refuted_States_Hits_Count, Main_Total_Statistics.Refuted_States_Misses_Count);
+	if (Main_Total_Statistics.Scalar_Propagations_Count + Main_Total_Statistics.Board_Propagations_Count > 0) printf("Constraint propagations : %llu with the scalar code, %llu with the SIMD candidates board.\n", Main_Total_Statistics.Scalar_Propagations_Count, Main_Total_Statistics.Board_Propagations_Count);
+	if (Main_Phases_Durations.First_Solution_Duration > 0) printf("Time to first solution : %.3f ms.\n", TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Phases_Durations.First_Solution_Duration));
+	if (Main_Winning_Strategy_Index >= 0)
+	{
+		WorkerConvertStrategyToString(&Main_Winning_Strategy, String_Strategy);
+		printf("Winning strategy : %s (portfolio rank %d).\n", String_Strategy, Main_Winning_Strategy_Index);
+	}
+	putchar('\n');
+	
+	// Show how the work was shared between the workers
+	printf("Workers statistics :\n");
+	printf("Worker | Explored nodes | Backtracks | Dead ends | Jobs | Restarts | Busy (ms) | Idle (ms)\n");
+	for (i = 0; i < Main_Total_Allowed_Workers_Count; i++) printf("%6d | %14llu | %10llu | %9llu | %4llu | %8llu | %9.3f | %9.3f\n", i, Main_Workers_Statistics[i].Explored_Nodes_Count, Main_Workers_Statistics[i].Backtracks_Count, Main_Workers_Statistics[i].Dead_Ends_Count,
+		Main_Workers_Statistics[i].Received_Jobs_Count, Main_Workers_Statistics[i].Restarts_Count, TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Workers_Statistics[i].Busy_Time), TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Workers_Statistics[i].Idle_Time));
+	printf("Workers busy time : minimum %.3f ms, maximum %.3f ms.\n\n", TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Minimum_Busy_Time), TIMER_CONVERT_NANOSECONDS_TO_MILLISECONDS(Main_Maximum_Busy_Time));
+	
+	// The result is unknown when a part of the search tree could not be searched
+	if (Is_Grid_Solved < 0)
+	{
+		printf("Failed to solve this grid because an error occurred.\n");
+		return EXIT_FAILURE;
+	}
+	
+	// Show the solutions count
+	if (Main_Maximum_Solutions_Count > 0)
+	{
+		if (Main_Solutions_Count > Main_Maximum_Solutions_Count) printf("The grid has more than %llu solutions.\n", Main_Maximum_Solutions_Count);
+		else if (Main_Solutions_Count == 1) printf("The grid has a single solution.\n");
+		else printf("The grid has %llu solutions.\n", Main_Solutions_Count);
+		
+		if (Main_Solutions_Count == 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
 	
 	// Show result
 	if (Is_Grid_Solved)
@@ -0,0 +1,298 @@
+/** @file Server.c
+ * See Server.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <assert.h>
+#include <Configuration.h>
+#include <errno.h>
+#include <Log.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <Server.h>
+#include <signal.h>
+#include <Solver.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** Enable or disable this module debug messages. */
+#define SERVER_IS_DEBUG_ENABLED 0
+
+/** How many connections can wait to be accepted. */
+#define SERVER_LISTEN_BACKLOG 64
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** All solvers. */
+static TSolver **Pointer_Server_Solvers;
+
+/** The available solvers stack content. */
+static TSolver **Pointer_Server_Solvers_Stack;
+/** Available solvers stack index. Stack starts from 0 and grows. */
+static int Server_Solvers_Stack_Index = 0;
+/** Allow to atomically access to the stack from the connection threads. */
+static pthread_mutex_t Server_Solvers_Stack_Mutex = PTHREAD_MUTEX_INITIALIZER;
+/** Count how many available solvers remain. */
+static sem_t Server_Semaphore_Available_Solvers_Count;
+
+/** When not zero, count the grid solutions (up to this amount plus one) instead of solving the grid. */
+static unsigned long long Server_Maximum_Solutions_Count;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Block until a solver is available, then take it.
+ * @return The solver, it must be given back with ServerReleaseSolver().
+ */
+static TSolver *ServerAcquireSolver(void)
+{
+	TSolver *Pointer_Solver;
+	
+	sem_wait(&Server_Semaphore_Available_Solvers_Count);
+	
+	pthread_mutex_lock(&Server_Solvers_Stack_Mutex);
+	assert(Server_Solvers_Stack_Index > 0);
+	Server_Solvers_Stack_Index--;
+	Pointer_Solver = Pointer_Server_Solvers_Stack[Server_Solvers_Stack_Index];
+	pthread_mutex_unlock(&Server_Solvers_Stack_Mutex);
+	
+	return Pointer_Solver;
+}
+
+/** Make a solver available to the other connections.
+ * @param Pointer_Solver The solver returned by ServerAcquireSolver().
+ */
+static void ServerReleaseSolver(TSolver *Pointer_Solver)
+{
+	pthread_mutex_lock(&Server_Solvers_Stack_Mutex);
+	Pointer_Server_Solvers_Stack[Server_Solvers_Stack_Index] = Pointer_Solver;
+	Server_Solvers_Stack_Index++;
+	pthread_mutex_unlock(&Server_Solvers_Stack_Mutex);
+	
+	sem_post(&Server_Semaphore_Available_Solvers_Count);
+}
+
+/** Solve a grid and create the result line, which is the one printed by the batch mode text output.
+ * @param String_Grid The grid sent by the client.
+ * @param String_Result On output, contain the result line, including the new line character. Make sure the string has at least GRID_STRING_MAXIMUM_LENGTH + 2 bytes room.
+ */
+static void ServerSolveGrid(char *String_Grid, char *String_Result)
+{
+	TSolver *Pointer_Solver;
+	int Result;
+	unsigned long long Solutions_Count;
+	
+	// Only keep a solver while the grid is solved, so the other connections can use it while this client sends its next grid
+	Pointer_Solver = ServerAcquireSolver();
+	if (Server_Maximum_Solutions_Count > 0) Result = SolverCountSolutions(Pointer_Solver, String_Grid, Server_Maximum_Solutions_Count, &Solutions_Count);
+	else Result = SolverSolve(Pointer_Solver, String_Grid, String_Result);
+	ServerReleaseSolver(Pointer_Solver);
+	
+	if (Result == -1) strcpy(String_Result, "Bad grid\n");
+	else if (Result < 0) strcpy(String_Result, "Error\n");
+	else if (Server_Maximum_Solutions_Count > 0)
+	{
+		// A ">" prefix tells that the limit was exceeded
+		if (Solutions_Count > Server_Maximum_Solutions_Count) sprintf(String_Result, ">%llu\n", Server_Maximum_Solutions_Count);
+		else sprintf(String_Result, "%llu\n", Solutions_Count);
+	}
+	else if (Result == 1) strcat(String_Result, "\n");
+	else strcpy(String_Result, "No solution\n");
+}
+
+/** Write a whole string to a socket.
+ * @param Socket The socket to write to.
+ * @param String The string to write.
+ * @return 0 on success,
+ * @return -1 if the client closed the connection.
+ */
+static int ServerWriteString(int Socket, char *String)
+{
+	size_t Remaining_Bytes_Count;
+	ssize_t Written_Bytes_Count;
+	
+	Remaining_Bytes_Count = strlen(String);
+	while (Remaining_Bytes_Count > 0)
+	{
+		Written_Bytes_Count = write(Socket, String, Remaining_Bytes_Count);
+		if (Written_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		String += Written_Bytes_Count;
+		Remaining_Bytes_Count -= Written_Bytes_Count;
+	}
+	return 0;
+}
+
+/** Serve a client until it closes the connection.
+ * @param Pointer_Argument The connection socket.
+ * @return Unused value.
+ */
+static void *ServerConnectionThreadFunction(void *Pointer_Argument)
+{
+	int Socket = (int) (long) Pointer_Argument, Character;
+	FILE *Pointer_File;
+	char *String_Line, *String_Result;
+	size_t Line_Size = GRID_STRING_MAXIMUM_LENGTH + 3; // +2 for the new line characters and +1 for terminating zero
+	
+	// Use buffered reads to get the grids line by line, the results are directly written to the socket
+	Pointer_File = fdopen(Socket, "rb");
+	String_Line = malloc(Line_Size);
+	String_Result = malloc(GRID_STRING_MAXIMUM_LENGTH + 2); // +1 for the new line character and +1 for terminating zero
+	if ((Pointer_File == NULL) || (String_Line == NULL) || (String_Result == NULL))
+	{
+		LOG(1, "Error : not enough memory to serve a new client.\n");
+		if (Pointer_File != NULL) fclose(Pointer_File);
+		else close(Socket);
+		free(String_Line);
+		free(String_Result);
+		return NULL;
+	}
+	LOG(SERVER_IS_DEBUG_ENABLED, "Client connected on socket %d.\n", Socket);
+	
+	while (fgets(String_Line, Line_Size, Pointer_File) != NULL)
+	{
+		// Silently ignore empty lines, like the batch mode
+		if ((String_Line[0] == '\n') || (String_Line[0] == '\r')) continue;
+		
+		// Discard the end of a too long line
+		if (strchr(String_Line, '\n') == NULL)
+		{
+			do
+			{
+				Character = fgetc(Pointer_File);
+			} while ((Character != '\n') && (Character != EOF));
+			if (strlen(String_Line) == Line_Size - 1) String_Line[0] = 0; // Make sure the grid can't be loaded
+		}
+		
+		ServerSolveGrid(String_Line, String_Result);
+		if (ServerWriteString(Socket, String_Result) != 0) break;
+	}
+	
+	LOG(SERVER_IS_DEBUG_ENABLED, "Client disconnected from socket %d.\n", Socket);
+	fclose(Pointer_File);
+	free(String_Line);
+	free(String_Result);
+	return NULL;
+}
+
+/** Destroy the solvers created so far and release the solvers arrays, when the server can't start.
+ * @param Created_Solvers_Count How many solvers of the solvers array have been created.
+ */
+static void ServerDestroySolvers(int Created_Solvers_Count)
+{
+	int i;
+	
+	for (i = 0; i < Created_Solvers_Count; i++) SolverDestroy(Pointer_Server_Solvers[i]);
+	free(Pointer_Server_Solvers);
+	Pointer_Server_Solvers = NULL;
+	free(Pointer_Server_Solvers_Stack);
+	Pointer_Server_Solvers_Stack = NULL;
+	Server_Solvers_Stack_Index = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ServerRun(char *String_Socket_Path, int Solvers_Count, int Workers_Count, TWorkerAlgorithm Algorithm, TWorkerCellSelectionHeuristic Cell_Selection_Heuristic, TGridPropagationLevel Propagation_Level, unsigned long long Maximum_Solutions_Count)
+{
+	int Listening_Socket, Connection_Socket, i;
+	struct sockaddr_un Address;
+	pthread_t Thread;
+	pthread_attr_t Thread_Attributes;
+	
+	Server_Maximum_Solutions_Count = Maximum_Solutions_Count;
+	if (strlen(String_Socket_Path) >= sizeof(Address.sun_path))
+	{
+		LOG(1, "Error : the socket path is too long (the maximum length is %zu characters).\n", sizeof(Address.sun_path) - 1);
+		return -1;
+	}
+	
+	// A client closing its connection while a result is sent must not terminate the server
+	signal(SIGPIPE, SIG_IGN);
+	
+	// Create all solvers once, so the requests do not pay for the threads creation
+	Pointer_Server_Solvers = malloc(Solvers_Count * sizeof(TSolver *));
+	Pointer_Server_Solvers_Stack = malloc(Solvers_Count * sizeof(TSolver *));
+	if ((Pointer_Server_Solvers == NULL) || (Pointer_Server_Solvers_Stack == NULL))
+	{
+		LOG(1, "Error : not enough memory to create %d solvers.\n", Solvers_Count);
+		ServerDestroySolvers(0);
+		return -1;
+	}
+	for (i = 0; i < Solvers_Count; i++)
+	{
+		Pointer_Server_Solvers[i] = SolverCreate(Workers_Count);
+		if (Pointer_Server_Solvers[i] == NULL)
+		{
+			LOG(1, "Error : failed to create solver %d.\n", i);
+			ServerDestroySolvers(i);
+			return -1;
+		}
+		SolverSetDancingLinks(Pointer_Server_Solvers[i], Algorithm == WORKER_ALGORITHM_DANCING_LINKS);
+		SolverSetMostConstrainedCellHeuristic(Pointer_Server_Solvers[i], Cell_Selection_Heuristic == WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL);
+		SolverSetPropagationLevel(Pointer_Server_Solvers[i], Propagation_Level);
+		Pointer_Server_Solvers_Stack[i] = Pointer_Server_Solvers[i];
+	}
+	Server_Solvers_Stack_Index = Solvers_Count;
+	if (sem_init(&Server_Semaphore_Available_Solvers_Count, 0, Solvers_Count) != 0)
+	{
+		LOG(1, "Error : failed to create the solvers semaphore.\n");
+		ServerDestroySolvers(Solvers_Count);
+		return -1;
+	}
+	
+	// Create the socket
+	Listening_Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Listening_Socket < 0)
+	{
+		LOG(1, "Error : failed to create the socket (%s).\n", strerror(errno));
+		sem_destroy(&Server_Semaphore_Available_Solvers_Count);
+		ServerDestroySolvers(Solvers_Count);
+		return -1;
+	}
+	memset(&Address, 0, sizeof(Address));
+	Address.sun_family = AF_UNIX;
+	strcpy(Address.sun_path, String_Socket_Path);
+	unlink(String_Socket_Path); // Remove the socket left by a previous server
+	if ((bind(Listening_Socket, (struct sockaddr *) &Address, sizeof(Address)) != 0) || (listen(Listening_Socket, SERVER_LISTEN_BACKLOG) != 0))
+	{
+		LOG(1, "Error : failed to listen on %s (%s).\n", String_Socket_Path, strerror(errno));
+		close(Listening_Socket);
+		sem_destroy(&Server_Semaphore_Available_Solvers_Count);
+		ServerDestroySolvers(Solvers_Count);
+		return -1;
+	}
+	printf("Listening on %s with %d solver(s) of %d thread(s).\n", String_Socket_Path, Solvers_Count, Workers_Count);
+	fflush(stdout);
+	
+	// Serve each client with its own thread, the thread resources are released when it terminates
+	pthread_attr_init(&Thread_Attributes);
+	pthread_attr_setdetachstate(&Thread_Attributes, PTHREAD_CREATE_DETACHED);
+	while (1)
+	{
+		Connection_Socket = accept(Listening_Socket, NULL, NULL);
+		if (Connection_Socket < 0)
+		{
+			if (errno != EINTR) LOG(1, "Error : failed to accept a connection (%s).\n", strerror(errno));
+			continue;
+		}
+		
+		if (pthread_create(&Thread, &Thread_Attributes, ServerConnectionThreadFunction, (void *) (long) Connection_Socket) != 0)
+		{
+			LOG(1, "Error : failed to create a connection thread (%s).\n", strerror(errno));
+			close(Connection_Socket);
+		}
+	}
+	
+	return 0;
+}
@@ -0,0 +1,133 @@
+/** @file Solver.c
+ * See Solver.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Grid.h>
+#include <stdlib.h>
+#include <Solver.h>
+#include <Worker.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** All data of a solver. */
+struct TSolver
+{
+	TWorkerPool Worker_Pool; //!< The workers solving the grids.
+	TGrid Grid; //!< The grid being solved.
+};
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Let the solver workers explore a loaded grid.
+ * @param Pointer_Solver The solver to use.
+ * @param Pointer_Grid The grid cell values. On output, contain the solved grid if a solution has been found and the solutions are not counted.
+ * @param Pointer_Solutions_Count On output, contain the solutions counted by the workers. Set to NULL when solving the grid.
+ * @return -2 if an error occurred while searching the grid, so it is unknown whether it has a solution,
+ * @return 0 if the grid has no solution (or if the solutions have been counted),
+ * @return 1 if the grid has been solved.
+ */
+static int SolverExploreGrid(TSolver *Pointer_Solver, TGrid *Pointer_Grid, unsigned long long *Pointer_Solutions_Count)
+{
+	TWorker *Pointer_Worker;
+	int Is_Grid_Solved;
+	
+	GridUpdateFromCellValues(Pointer_Grid);
+	
+	// Provide the whole grid to the first ready worker
+	WorkerWaitForAvailableWorker(&Pointer_Solver->Worker_Pool, &Pointer_Worker);
+	GridCopy(Pointer_Grid, &Pointer_Worker->Grid);
+	WorkerSolve(Pointer_Worker);
+	
+	// Retrieve the result before the workers can be given another job
+	Is_Grid_Solved = WorkerWaitForCompletion(&Pointer_Solver->Worker_Pool, &Pointer_Worker);
+	if ((Is_Grid_Solved > 0) && (Pointer_Solutions_Count == NULL)) GridCopy(&Pointer_Worker->Grid, Pointer_Grid);
+	if (Pointer_Solutions_Count != NULL) *Pointer_Solutions_Count = WorkerGetSolutionsCount(&Pointer_Solver->Worker_Pool);
+	WorkerWaitForAllWorkersIdle(&Pointer_Solver->Worker_Pool);
+	
+	if (Is_Grid_Solved < 0) return -2;
+	return Is_Grid_Solved;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+TSolver *SolverCreate(int Workers_Count)
+{
+	TSolver *Pointer_Solver;
+	
+	if ((Workers_Count <= 0) || (Workers_Count > CONFIGURATION_WORKERS_MAXIMUM_COUNT)) return NULL;
+	
+	Pointer_Solver = malloc(sizeof(TSolver));
+	if (Pointer_Solver == NULL) return NULL;
+	
+	if (WorkerInitialize(&Pointer_Solver->Worker_Pool, Workers_Count) != 0)
+	{
+		free(Pointer_Solver);
+		return NULL;
+	}
+	return Pointer_Solver;
+}
+
+void SolverDestroy(TSolver *Pointer_Solver)
+{
+	WorkerUninitialize(&Pointer_Solver->Worker_Pool);
+	free(Pointer_Solver);
+}
+
+void SolverSetDancingLinks(TSolver *Pointer_Solver, int Is_Enabled)
+{
+	if (Is_Enabled) WorkerSetAlgorithm(&Pointer_Solver->Worker_Pool, WORKER_ALGORITHM_DANCING_LINKS);
+	else WorkerSetAlgorithm(&Pointer_Solver->Worker_Pool, WORKER_ALGORITHM_BACKTRACK);
+}
+
+void SolverSetMostConstrainedCellHeuristic(TSolver *Pointer_Solver, int Is_Enabled)
+{
+	if (Is_Enabled) WorkerSetCellSelectionHeuristic(&Pointer_Solver->Worker_Pool, WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL);
+	else WorkerSetCellSelectionHeuristic(&Pointer_Solver->Worker_Pool, WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL);
+}
+
+void SolverSetPropagationLevel(TSolver *Pointer_Solver, TGridPropagationLevel Propagation_Level)
+{
+	WorkerSetPropagationLevel(&Pointer_Solver->Worker_Pool, Propagation_Level);
+}
+
+void SolverSetIdleTimeout(TSolver *Pointer_Solver, unsigned int Milliseconds)
+{
+	WorkerSetIdleTimeout(&Pointer_Solver->Worker_Pool, Milliseconds);
+}
+
+int SolverSolve(TSolver *Pointer_Solver, char *String_Grid, char *String_Solution)
+{
+	int Is_Grid_Solved;
+	
+	if (GridLoadFromString(&Pointer_Solver->Grid, String_Grid) != 0) return -1;
+	Is_Grid_Solved = SolverExploreGrid(Pointer_Solver, &Pointer_Solver->Grid, NULL);
+	if (Is_Grid_Solved > 0) GridConvertToString(&Pointer_Solver->Grid, String_Solution);
+	return Is_Grid_Solved;
+}
+
+int SolverCountSolutions(TSolver *Pointer_Solver, char *String_Grid, unsigned long long Maximum_Solutions_Count, unsigned long long *Pointer_Solutions_Count)
+{
+	if (GridLoadFromString(&Pointer_Solver->Grid, String_Grid) != 0) return -1;
+	return SolverCountGridSolutions(Pointer_Solver, &Pointer_Solver->Grid, Maximum_Solutions_Count, Pointer_Solutions_Count);
+}
+
+int SolverSolveGrid(TSolver *Pointer_Solver, TGrid *Pointer_Grid)
+{
+	return SolverExploreGrid(Pointer_Solver, Pointer_Grid, NULL);
+}
+
+int SolverCountGridSolutions(TSolver *Pointer_Solver, TGrid *Pointer_Grid, unsigned long long Maximum_Solutions_Count, unsigned long long *Pointer_Solutions_Count)
+{
+	int Result;
+	
+	// Count the solutions for this grid only
+	WorkerSetMaximumSolutionsCount(&Pointer_Solver->Worker_Pool, Maximum_Solutions_Count);
+	Result = SolverExploreGrid(Pointer_Solver, Pointer_Grid, Pointer_Solutions_Count);
+	WorkerSetMaximumSolutionsCount(&Pointer_Solver->Worker_Pool, 0);
+	
+	if (Result < 0) return Result;
+	return 0;
+}
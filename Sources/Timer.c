@@ -0,0 +1,17 @@
+/** @file Timer.c
+ * See Timer.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <time.h>
+#include <Timer.h>
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+unsigned long long TimerGetNanoseconds(void)
+{
+	struct timespec Time;
+	
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return (unsigned long long) Time.tv_sec * 1000000000ULL + Time.tv_nsec;
+}
@@ -2,17 +2,24 @@
  * See Worker.h for description.
  * @author Adrien RICCIARDI
  */
+#define _GNU_SOURCE // Needed by the processor sets macros and by pthread_setaffinity_np()
+#include <Affinity.h>
 #include <assert.h>
 #include <Configuration.h>
 #include <errno.h>
+#include <Exact_Cover.h>
 #include <Grid.h>
+#include <limits.h>
+#include <linux/futex.h>
 #include <Log.h>
 #include <pthread.h>
-#include <semaphore.h>
+#include <sched.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
+#include <Timer.h>
 #include <unistd.h>
 #include <Worker.h>
 
@@ -22,108 +29,923 @@
 /** Enable or disable this module debug messages. */
 #define WORKER_IS_DEBUG_ENABLED 0
 
+/** The biggest amount of solutions a worker can count before adding them to the shared total. */
+#define WORKER_SOLUTIONS_PUBLISHING_MAXIMUM_PERIOD 1024
+
+/** How many times an idle worker checks whether a job has been given before sleeping in the kernel, when each thread can have its own processor. Jobs given during this short time start without a system call on both sides. */
+#define WORKER_JOB_WAITING_SPINS_COUNT 2048
+
+/** How many milliseconds an idle worker thread sleeps before exiting, unless another value is configured. */
+#define WORKER_DEFAULT_IDLE_TIMEOUT 1000
+
+/** The base explored nodes budget of a randomized search run, unless another value is configured. */
+#define WORKER_DEFAULT_RESTART_NODES_COUNT 1024
+/** How much the geometric restart policy budget grows after each restart, unless another value is configured. */
+#define WORKER_DEFAULT_RESTART_GROWTH_FACTOR 1.5
+
+/** How many refuted states hashes a table bucket holds, a bucket fills a cache line so looking for a state reads a single line. */
+#define WORKER_REFUTED_STATES_BUCKET_SIZE (CONFIGURATION_CACHE_LINE_SIZE / sizeof(unsigned long long))
+
+/** How many nodes the subtree of a refuted state must have to be added to the table. Smaller subtrees are explored again faster than the table entries are written, and would evict the big ones. */
+#define WORKER_REFUTED_STATES_MINIMUM_SUBTREE_SIZE 16
+
+/** Tell the processor that the thread is waiting actively, so it can save power and give more resources to its SMT sibling. */
+#if defined(__x86_64__) || defined(__i386__)
+	#define WORKER_SPIN_PAUSE() __builtin_ia32_pause()
+#else
+	#define WORKER_SPIN_PAUSE() do {} while (0)
+#endif
+
 //-------------------------------------------------------------------------------------------------
 // Private variables
 //-------------------------------------------------------------------------------------------------
-/** Use a semaphore to count how many available workers remain. */
-static sem_t Worker_Semaphore_Available_Workers_Count;
-
-/** All workers data. */
-static TWorker Workers[CONFIGURATION_WORKERS_MAXIMUM_COUNT];
-
-/** The worker stack content. */
-static TWorker *Pointer_Worker_Stack[CONFIGURATION_WORKERS_MAXIMUM_COUNT];
-/** Worker stack index. Stack starts from 0 and grows. */
-static volatile int Worker_Stack_Index = 0;
-/** Allow to atomically access to the stack from worker threads. */
-static pthread_mutex_t Worker_Stack_Mutex = PTHREAD_MUTEX_INITIALIZER;
+/** The deterministic strategies raced by WorkerSolvePortfolio(), the ones solving most grids fast coming first as they are used even with few workers. The next workers run randomized searches. */
+static const TWorkerStrategy Worker_Portfolio_Strategies[] =
+{
+	{WORKER_ALGORITHM_DANCING_LINKS, WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL, GRID_PROPAGATION_LEVEL_NONE, 0, 0, WORKER_RESTART_POLICY_NONE, 0, 0},
+	{WORKER_ALGORITHM_BACKTRACK, WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL, GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES, 0, 0, WORKER_RESTART_POLICY_NONE, 0, 0},
+	{WORKER_ALGORITHM_BACKTRACK, WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL, GRID_PROPAGATION_LEVEL_FORWARD_CHECKING, 1, 0, WORKER_RESTART_POLICY_NONE, 0, 0},
+	{WORKER_ALGORITHM_DANCING_LINKS, WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL, GRID_PROPAGATION_LEVEL_NONE, 1, 0, WORKER_RESTART_POLICY_NONE, 0, 0},
+	{WORKER_ALGORITHM_BACKTRACK, WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL, GRID_PROPAGATION_LEVEL_NAKED_SINGLES, 1, 0, WORKER_RESTART_POLICY_NONE, 0, 0},
+	{WORKER_ALGORITHM_BACKTRACK, WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL, GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES, 0, 0, WORKER_RESTART_POLICY_NONE, 0, 0},
+	{WORKER_ALGORITHM_BACKTRACK, WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL, GRID_PROPAGATION_LEVEL_NONE, 0, 0, WORKER_RESTART_POLICY_NONE, 0, 0},
+	{WORKER_ALGORITHM_BACKTRACK, WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL, GRID_PROPAGATION_LEVEL_NONE, 1, 0, WORKER_RESTART_POLICY_NONE, 0, 0}
+};
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
-/** Push a worker pointer to the workers stack top.
- * @param Pointer_Worker The pointer that will become the stack top.
+// The threads are created on demand by the functions giving the jobs, which are called from the threads themselves
+static void *WorkerThreadFunction(void *Pointer_Argument);
+
+/** Sleep while a futex has the expected value.
+ * @param Pointer_Futex The futex.
+ * @param Expected_Value The value telling that the thread must sleep. The function immediately returns if the futex has another value.
+ * @param Pointer_Timeout The longest time to sleep, or NULL to sleep until the futex is woken up.
+ * @return 0 if the thread has been woken up (or if the futex had another value),
+ * @return -1 if the timeout expired.
+ */
+static inline int WorkerFutexWait(int *Pointer_Futex, int Expected_Value, struct timespec *Pointer_Timeout)
+{
+	if ((syscall(SYS_futex, Pointer_Futex, FUTEX_WAIT_PRIVATE, Expected_Value, Pointer_Timeout, NULL, 0) != 0) && (errno == ETIMEDOUT)) return -1;
+	return 0;
+}
+
+/** Wake up the threads sleeping on a futex.
+ * @param Pointer_Futex The futex.
+ * @param Threads_Count How many threads to wake up at most.
+ */
+static inline void WorkerFutexWake(int *Pointer_Futex, int Threads_Count)
+{
+	syscall(SYS_futex, Pointer_Futex, FUTEX_WAKE_PRIVATE, Threads_Count, NULL, NULL, 0);
+}
+
+/** Push a worker to its pool available workers stack, then wake up a thread waiting for an available worker if any. The stack is a lock-free one, so busy workers sharing their work never wait for each other. The last worker that became available is the first one to get a job, as its data are still in the processor caches.
+ * @param Pointer_Worker The worker that is available for a new job.
  */
 static void WorkerStackPush(TWorker *Pointer_Worker)
 {
-	pthread_mutex_lock(&Worker_Stack_Mutex);
-	
-	// Make sure the stack is not overflowing
-	assert(Worker_Stack_Index < CONFIGURATION_WORKERS_MAXIMUM_COUNT);
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	unsigned long long Stack_Top, New_Stack_Top;
 	
-	// Push value
-	Pointer_Worker_Stack[Worker_Stack_Index] = Pointer_Worker;
-	Worker_Stack_Index++;
+	// The release order makes the worker data written before visible to the thread popping the worker
+	Stack_Top = __atomic_load_n(&Pointer_Pool->Available_Workers_Stack_Top, __ATOMIC_RELAXED);
+	do
+	{
+		__atomic_store_n(&Pointer_Worker->Next_Available_Worker_Number, (int) (Stack_Top & 0xFFFFFFFF), __ATOMIC_RELAXED);
+		New_Stack_Top = (((Stack_Top >> 32) + 1) << 32) | (unsigned long long) (Pointer_Worker - Pointer_Pool->Pointer_Workers + 1);
+	} while (!__atomic_compare_exchange_n(&Pointer_Pool->Available_Workers_Stack_Top, &Stack_Top, New_Stack_Top, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
 	
-	pthread_mutex_unlock(&Worker_Stack_Mutex);
+	// Wake up a thread waiting for an available worker, the sequentially consistent order guarantees that a waiter not seen here will see the pushed worker
+	__atomic_add_fetch(&Pointer_Pool->Available_Workers_Futex, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&Pointer_Pool->Available_Workers_Waiters_Count, __ATOMIC_SEQ_CST) > 0) WorkerFutexWake(&Pointer_Pool->Available_Workers_Futex, 1);
 }
 
-/** Pop the top of the worker stack.
- * @return The worker that was on stack's top.
+/** Initialize a worker that has never been used, if the pool maximum workers count is not reached. The worker has no thread yet, it will be created when a job is given to the worker.
+ * @param Pointer_Pool The pool owning the worker.
+ * @return NULL if all workers have already been used,
+ * @return The new worker.
  */
-static TWorker *WorkerStackPop(void)
+static TWorker *WorkerCreate(TWorkerPool *Pointer_Pool)
 {
+	int Created_Workers_Count;
 	TWorker *Pointer_Worker;
 	
-	pthread_mutex_lock(&Worker_Stack_Mutex);
+	// Several threads may want a new worker at the same time
+	Created_Workers_Count = __atomic_load_n(&Pointer_Pool->Created_Workers_Count, __ATOMIC_RELAXED);
+	do
+	{
+		if (Created_Workers_Count >= Pointer_Pool->Workers_Count) return NULL;
+	} while (!__atomic_compare_exchange_n(&Pointer_Pool->Created_Workers_Count, &Created_Workers_Count, Created_Workers_Count + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	
+	// Statistics start from zero
+	Pointer_Worker = &Pointer_Pool->Pointer_Workers[Created_Workers_Count];
+	memset(Pointer_Worker, 0, sizeof(TWorker));
+	Pointer_Worker->Pointer_Pool = Pointer_Pool;
+	Pointer_Worker->Job_State = WORKER_JOB_STATE_STOPPED;
+	
+	return Pointer_Worker;
+}
+
+/** Tell whether a worker can be given a job, either because it is waiting for a job or because it has never been used. This is only a hint, as another thread can take the worker meanwhile.
+ * @param Pointer_Pool The pool owning the workers.
+ * @return 0 if all workers are busy,
+ * @return 1 if a worker may be available.
+ */
+static inline int WorkerIsWorkerAvailable(TWorkerPool *Pointer_Pool)
+{
+	if ((__atomic_load_n(&Pointer_Pool->Available_Workers_Stack_Top, __ATOMIC_RELAXED) & 0xFFFFFFFF) != 0) return 1;
+	return __atomic_load_n(&Pointer_Pool->Created_Workers_Count, __ATOMIC_RELAXED) < Pointer_Pool->Workers_Count;
+}
+
+/** Pop a worker from its pool available workers stack without blocking. When the stack is empty, a worker that has never been used is taken if there are some.
+ * @param Pointer_Pool The pool owning the stack.
+ * @return NULL if no worker is available,
+ * @return The available worker.
+ */
+static TWorker *WorkerStackTryPop(TWorkerPool *Pointer_Pool)
+{
+	unsigned long long Stack_Top, New_Stack_Top;
+	int Worker_Number;
 	
-	// Make sure the stack is not underflowing
-	assert(Worker_Stack_Index > 0);
+	// The next worker number may be read from a worker that has been popped meanwhile, the stack top change counter makes the exchange fail in this case
+	Stack_Top = __atomic_load_n(&Pointer_Pool->Available_Workers_Stack_Top, __ATOMIC_ACQUIRE);
+	do
+	{
+		Worker_Number = Stack_Top & 0xFFFFFFFF;
+		if (Worker_Number == 0) return WorkerCreate(Pointer_Pool);
+		New_Stack_Top = (((Stack_Top >> 32) + 1) << 32) | (unsigned int) __atomic_load_n(&Pointer_Pool->Pointer_Workers[Worker_Number - 1].Next_Available_Worker_Number, __ATOMIC_RELAXED);
+	} while (!__atomic_compare_exchange_n(&Pointer_Pool->Available_Workers_Stack_Top, &Stack_Top, New_Stack_Top, 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
 	
-	// Pop top value
-	Worker_Stack_Index--;
-	Pointer_Worker = Pointer_Worker_Stack[Worker_Stack_Index];
+	return &Pointer_Pool->Pointer_Workers[Worker_Number - 1];
+}
+
+/** Pop a worker from its pool available workers stack, sleeping until a worker is available if needed.
+ * @param Pointer_Pool The pool owning the stack.
+ * @return The available worker.
+ */
+static TWorker *WorkerStackPop(TWorkerPool *Pointer_Pool)
+{
+	TWorker *Pointer_Worker;
+	int Futex_Value;
+	
+	Pointer_Worker = WorkerStackTryPop(Pointer_Pool);
+	if (Pointer_Worker != NULL) return Pointer_Worker;
 	
-	pthread_mutex_unlock(&Worker_Stack_Mutex);
+	// Tell the workers that a thread may sleep, then check the stack again as a worker may have been pushed meanwhile
+	__atomic_add_fetch(&Pointer_Pool->Available_Workers_Waiters_Count, 1, __ATOMIC_SEQ_CST);
+	while (1)
+	{
+		Futex_Value = __atomic_load_n(&Pointer_Pool->Available_Workers_Futex, __ATOMIC_SEQ_CST);
+		Pointer_Worker = WorkerStackTryPop(Pointer_Pool);
+		if (Pointer_Worker != NULL) break;
+		WorkerFutexWait(&Pointer_Pool->Available_Workers_Futex, Futex_Value, NULL); // Immediately returns if a worker has been pushed since the futex value was read
+	}
+	__atomic_sub_fetch(&Pointer_Pool->Available_Workers_Waiters_Count, 1, __ATOMIC_RELAXED);
 	
 	return Pointer_Worker;
 }
 
-/** Solve a grid using the backtrack algorithm.
+/** Create a worker thread. The thread of a worker that previously exited is waited for first, so its resources are released.
+ * @param Pointer_Worker The worker that needs a thread.
+ * @return 0 on success,
+ * @return -1 if the thread could not be created.
+ * @note This function prints an error message if an error occurs.
+ */
+static int WorkerStartThread(TWorker *Pointer_Worker)
+{
+	int Result;
+	
+	if (Pointer_Worker->Is_Thread_Created)
+	{
+		pthread_join(Pointer_Worker->Thread, NULL);
+		Pointer_Worker->Is_Thread_Created = 0;
+	}
+	
+	// A new thread is not bound to any processor
+	Pointer_Worker->Processor_ID = -1;
+	Result = pthread_create(&Pointer_Worker->Thread, NULL, WorkerThreadFunction, Pointer_Worker);
+	if (Result != 0)
+	{
+		LOG(1, "Error : failed to create worker thread %d (%s).\n", (int) (Pointer_Worker - Pointer_Worker->Pointer_Pool->Pointer_Workers), strerror(Result));
+		return -1;
+	}
+	Pointer_Worker->Is_Thread_Created = 1;
+	
+	return 0;
+}
+
+/** Wake a worker thread up to make it start its job, creating the thread if the worker has none.
+ * @param Pointer_Worker The worker to wake up.
+ * @return 0 on success,
+ * @return -1 if the worker thread could not be created.
+ */
+static int WorkerGiveJob(TWorker *Pointer_Worker)
+{
+	int Job_State;
+	
+	// The release order makes the job written before visible to the worker, a system call is only needed when the worker stopped waiting actively
+	Job_State = __atomic_exchange_n(&Pointer_Worker->Job_State, WORKER_JOB_STATE_GIVEN, __ATOMIC_ACQ_REL);
+	if (Job_State == WORKER_JOB_STATE_SLEEPING) WorkerFutexWake(&Pointer_Worker->Job_State, 1);
+	else if (Job_State == WORKER_JOB_STATE_STOPPED)
+	{
+		// The new thread immediately starts the job as it has already been given
+		if (WorkerStartThread(Pointer_Worker) != 0)
+		{
+			__atomic_store_n(&Pointer_Worker->Job_State, WORKER_JOB_STATE_STOPPED, __ATOMIC_RELAXED);
+			return -1;
+		}
+	}
+	
+	return 0;
+}
+
+/** Block the calling worker thread until a job is given to it, or until it is idle for too long.
+ * @param Pointer_Worker The worker waiting for a job.
+ * @return 0 if the thread must exit because it has been idle for too long (the worker will get a new thread when a job is given to it),
+ * @return 1 if a job or an exit request has been given.
+ */
+static int WorkerWaitForJob(TWorker *Pointer_Worker)
+{
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	int i, Job_State;
+	struct timespec Timeout, *Pointer_Timeout = NULL;
+	
+	// Wait actively for a short time, as a busy worker often shares its work with an idle worker soon after the idle worker terminated its job
+	for (i = 0; i < Pointer_Pool->Job_Waiting_Spins_Count; i++)
+	{
+		if (__atomic_load_n(&Pointer_Worker->Job_State, __ATOMIC_ACQUIRE) == WORKER_JOB_STATE_GIVEN) break;
+		WORKER_SPIN_PAUSE();
+	}
+	
+	// The first worker thread never exits, so a grid can always be started without creating a thread
+	if ((Pointer_Pool->Idle_Timeout > 0) && (Pointer_Worker != Pointer_Pool->Pointer_Workers))
+	{
+		Timeout.tv_sec = Pointer_Pool->Idle_Timeout / 1000;
+		Timeout.tv_nsec = (Pointer_Pool->Idle_Timeout % 1000) * 1000000L;
+		Pointer_Timeout = &Timeout;
+	}
+	
+	// Sleep until the job is given, unless it has been given while waiting actively
+	while (__atomic_load_n(&Pointer_Worker->Job_State, __ATOMIC_ACQUIRE) != WORKER_JOB_STATE_GIVEN)
+	{
+		Job_State = WORKER_JOB_STATE_WAITING;
+		__atomic_compare_exchange_n(&Pointer_Worker->Job_State, &Job_State, WORKER_JOB_STATE_SLEEPING, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE); // Job_State is left to "waiting" on success, or it gets the current state
+		if (Job_State == WORKER_JOB_STATE_GIVEN) break;
+		
+		// Tell that the worker has no thread anymore when the timeout expires, unless a job has been given meanwhile (the worker stays in the available workers stack)
+		if (WorkerFutexWait(&Pointer_Worker->Job_State, WORKER_JOB_STATE_SLEEPING, Pointer_Timeout) != 0)
+		{
+			Job_State = WORKER_JOB_STATE_SLEEPING;
+			if (__atomic_compare_exchange_n(&Pointer_Worker->Job_State, &Job_State, WORKER_JOB_STATE_STOPPED, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return 0;
+		}
+	}
+	
+	// Be ready for the next job
+	__atomic_store_n(&Pointer_Worker->Job_State, WORKER_JOB_STATE_WAITING, __ATOMIC_RELAXED);
+	return 1;
+}
+
+/** Move the calling worker thread to the logical processor chosen for its worker, if the thread is not already there.
+ * @param Pointer_Worker The worker owning the calling thread.
+ */
+static void WorkerMoveToProcessor(TWorker *Pointer_Worker)
+{
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	int Processor_ID;
+	cpu_set_t Processors;
+	
+	if (Pointer_Pool->Pointer_Placement == NULL) return;
+	Processor_ID = Pointer_Pool->Pointer_Placement[Pointer_Worker - Pointer_Pool->Pointer_Workers].Processor_ID;
+	if (Pointer_Worker->Processor_ID == Processor_ID) return;
+	
+	// Don't try again for each job if the thread can't be bound
+	CPU_ZERO(&Processors);
+	CPU_SET(Processor_ID, &Processors);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(Processors), &Processors) != 0) LOG(1, "Error : failed to bind worker %d to processor %d.\n", (int) (Pointer_Worker - Pointer_Pool->Pointer_Workers), Processor_ID);
+	Pointer_Worker->Processor_ID = Processor_ID;
+}
+
+/** Give a job to a worker.
+ * @param Pointer_Worker The worker owning the job, its grid must be ready.
+ * @return 0 on success,
+ * @return -1 if the worker thread could not be created, the worker must not be used anymore.
+ */
+static int WorkerStartJob(TWorker *Pointer_Worker)
+{
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	
+	// No solution has been found yet
+	Pointer_Worker->Is_Grid_Solved = 0;
+	
+	// Account for the new job before the worker can terminate it (the job can't terminate if the thread is not created, so the counter can't reach zero without the completion being signaled)
+	__atomic_add_fetch(&Pointer_Pool->Busy_Workers_Count, 1, __ATOMIC_RELAXED);
+	if (WorkerGiveJob(Pointer_Worker) != 0)
+	{
+		__atomic_sub_fetch(&Pointer_Pool->Busy_Workers_Count, 1, __ATOMIC_RELAXED);
+		return -1;
+	}
+	
+	return 0;
+}
+
+/** Add the solutions counted by a worker to the shared total, and stop all workers if there are too many solutions.
+ * @param Pointer_Worker The worker that counted the solutions.
+ */
+static void WorkerPublishSolutionsCount(TWorker *Pointer_Worker)
+{
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	unsigned long long Total_Solutions_Count;
+	
+	Total_Solutions_Count = __atomic_add_fetch(&Pointer_Pool->Solutions_Count, Pointer_Worker->Unpublished_Solutions_Count, __ATOMIC_RELAXED);
+	Pointer_Worker->Unpublished_Solutions_Count = 0;
+	
+	// No need to explore the remaining search tree when the limit is exceeded
+	if (Total_Solutions_Count > Pointer_Pool->Maximum_Solutions_Count) Pointer_Pool->Is_Cancellation_Requested = 1;
+}
+
+/** Remember when the first solution of the grid has been found. Only the first worker calling this function sets the time.
+ * @param Pointer_Pool The pool solving the grid.
+ */
+static void WorkerRecordFirstSolutionTime(TWorkerPool *Pointer_Pool)
+{
+	unsigned long long Expected_Time = 0;
+	
+	// Reading first avoids writing to the shared variable when the time is already known
+	if (__atomic_load_n(&Pointer_Pool->First_Solution_Time, __ATOMIC_RELAXED) != 0) return;
+	__atomic_compare_exchange_n(&Pointer_Pool->First_Solution_Time, &Expected_Time, TimerGetNanoseconds(), 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+/** Get an idle worker to share some work with, without blocking.
+ * @param Pointer_Pool The pool solving the grid.
+ * @return NULL if no worker is available or if the job does not need to be shared anymore,
+ * @return The idle worker, it must be given a job.
+ */
+static TWorker *WorkerTakeIdleWorker(TWorkerPool *Pointer_Pool)
+{
+	TWorker *Pointer_Idle_Worker;
+	
+	// Try to get an idle worker without blocking, another busy worker may have taken it first
+	if (Pointer_Pool->Is_Cancellation_Requested) return NULL;
+	Pointer_Idle_Worker = WorkerStackTryPop(Pointer_Pool);
+	if (Pointer_Idle_Worker == NULL) return NULL;
+	
+	// Give the worker back if the grid has been solved or the job cancelled meanwhile (the idle worker may even be the one that found the solution, so its grid must be left untouched)
+	if (Pointer_Pool->Is_Cancellation_Requested)
+	{
+		WorkerStackPush(Pointer_Idle_Worker);
+		return NULL;
+	}
+	
+	return Pointer_Idle_Worker;
+}
+
+/** Mix the bits of a number so that each input bit changes about half of the output bits (this is the splitmix64 finalizer).
+ * @param Value The number to mix.
+ * @return The mixed number.
+ */
+static inline unsigned long long WorkerMixBits(unsigned long long Value)
+{
+	Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBULL;
+	return Value ^ (Value >> 31);
+}
+
+/** Get the next number of a pseudo-random sequence (this is the xorshift64* generator, which is fast and good enough to shuffle the search orders).
+ * @param Pointer_State The generator state, it must not be zero.
+ * @return A 64-bit pseudo-random number.
+ */
+static inline unsigned long long WorkerGetRandomNumber(unsigned long long *Pointer_State)
+{
+	unsigned long long State = *Pointer_State;
+	
+	State ^= State >> 12;
+	State ^= State << 25;
+	State ^= State >> 27;
+	*Pointer_State = State;
+	return State * 0x2545F4914F6CDD1DULL;
+}
+
+/** Create the random sequence of a worker job from the strategy seed, so each worker of a pool explores the search tree in its own order.
+ * @param Pointer_Worker The worker starting a randomized job.
+ * @return The initial generator state.
+ */
+static unsigned long long WorkerSeedRandomSequence(TWorker *Pointer_Worker)
+{
+	unsigned long long State;
+	
+	// Mix the bits of the seed and the worker index, so close seeds give unrelated sequences
+	State = WorkerMixBits(Pointer_Worker->Strategy.Random_Seed + (unsigned long long) (Pointer_Worker - Pointer_Worker->Pointer_Pool->Pointer_Workers) * 0x9E3779B97F4A7C15ULL);
+	if (State == 0) State = 1; // The generator state must not be zero
+	return State;
+}
+
+/** Take a random number from a bitmask.
+ * @param Bitmask The numbers, it must not be empty.
+ * @param Pointer_Random_State The generator state.
+ * @return The chosen number.
+ */
+static inline unsigned int WorkerPickRandomNumber(TGridBitmask Bitmask, unsigned long long *Pointer_Random_State)
+{
+	unsigned int Rank;
+	
+	// Remove the smaller numbers until the chosen one is the smallest
+	Rank = WorkerGetRandomNumber(Pointer_Random_State) % GRID_BITMASK_COUNT_NUMBERS(Bitmask);
+	while (Rank > 0)
+	{
+		Bitmask &= Bitmask - 1;
+		Rank--;
+	}
+	return GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask);
+}
+
+/** Shuffle the empty cells of a grid, so the most constrained cell ties are broken randomly (filling all cells in a random order would lose the row by row constraints the first empty cell heuristic benefits from).
+ * @param Pointer_Grid The grid.
+ * @param Pointer_Random_State The generator state.
+ */
+static void WorkerShuffleEmptyCells(TGrid *Pointer_Grid, unsigned long long *Pointer_Random_State)
+{
+	int i, j;
+	TCellsStackCellCoordinates *Pointer_Cells_Coordinates = GRID_GET_EMPTY_CELLS(Pointer_Grid), Cell_Coordinates;
+	
+	for (i = Pointer_Grid->Empty_Cells_Count - 1; i > 0; i--)
+	{
+		j = WorkerGetRandomNumber(Pointer_Random_State) % (i + 1);
+		Cell_Coordinates = Pointer_Cells_Coordinates[i];
+		Pointer_Cells_Coordinates[i] = Pointer_Cells_Coordinates[j];
+		Pointer_Cells_Coordinates[j] = Cell_Coordinates;
+	}
+}
+
+/** Compute how many nodes a randomized search run can explore before restarting.
+ * @param Pointer_Worker The worker running the search, its strategy tells the restart policy.
+ * @param Restarts_Count How many times the search has already restarted.
+ * @return The explored nodes budget of the run, ULLONG_MAX if the search must not restart.
+ */
+static unsigned long long WorkerGetRestartNodesCount(TWorker *Pointer_Worker, unsigned long long Restarts_Count)
+{
+	TWorkerStrategy *Pointer_Strategy = &Pointer_Worker->Strategy;
+	unsigned long long Sequence_Size, Term_Exponent, i;
+	double Nodes_Count;
+	
+	// The solutions of the abandoned search trees would be counted again
+	if ((Pointer_Strategy->Random_Seed == 0) || (Pointer_Worker->Pointer_Pool->Maximum_Solutions_Count > 0)) return ULLONG_MAX;
+	
+	switch (Pointer_Strategy->Restart_Policy)
+	{
+		case WORKER_RESTART_POLICY_LUBY:
+			// Find the smallest complete subsequence (of size 2^k - 1) containing the term, then go down into the subsequences until the term is the last one of its subsequence
+			Sequence_Size = 1;
+			Term_Exponent = 0;
+			while (Sequence_Size < Restarts_Count + 1)
+			{
+				Term_Exponent++;
+				Sequence_Size = 2 * Sequence_Size + 1;
+			}
+			while (Sequence_Size - 1 != Restarts_Count)
+			{
+				Sequence_Size = (Sequence_Size - 1) >> 1;
+				Term_Exponent--;
+				Restarts_Count = Restarts_Count % Sequence_Size;
+			}
+			if (Term_Exponent >= 63) return ULLONG_MAX;
+			if (Pointer_Strategy->Restart_Nodes_Count > (ULLONG_MAX >> Term_Exponent)) return ULLONG_MAX;
+			return Pointer_Strategy->Restart_Nodes_Count << Term_Exponent;
+			
+		case WORKER_RESTART_POLICY_GEOMETRIC:
+			Nodes_Count = Pointer_Strategy->Restart_Nodes_Count;
+			for (i = 0; i < Restarts_Count; i++)
+			{
+				Nodes_Count *= Pointer_Strategy->Restart_Growth_Factor;
+				if (Nodes_Count >= 1e18) return ULLONG_MAX; // Such a run never terminates anyway
+			}
+			return Nodes_Count;
+			
+		default:
+			return ULLONG_MAX;
+	}
+}
+
+/** Get the Zobrist key of a number put in a cell. The keys are computed when needed instead of being read from a table, which would be huge with the biggest grids.
+ * @param Row The cell row coordinate.
+ * @param Column The cell column coordinate.
+ * @param Number The cell number.
+ * @return The key.
+ */
+static inline unsigned long long WorkerGetZobristKey(int Row, int Column, unsigned int Number)
+{
+	return WorkerMixBits((((unsigned long long) Row << 16) | (Column << 8) | Number) + 1);
+}
+
+/** Compute the Zobrist hash of a grid state from scratch, the search updates it on its own afterwards.
+ * @param Pointer_Grid The grid.
+ * @return The exclusive or of the keys of all filled cells and of a key telling the grid size.
+ */
+static unsigned long long WorkerComputeStateHash(TGrid *Pointer_Grid)
+{
+	int Row, Column, Grid_Size = Pointer_Grid->Grid_Size;
+	unsigned long long Hash;
+	
+	Hash = WorkerMixBits(~(unsigned long long) Grid_Size); // Make the states of different grid sizes unrelated
+	for (Row = 0; Row < Grid_Size; Row++)
+	{
+		for (Column = 0; Column < Grid_Size; Column++)
+		{
+			if (GRID_CELL(Pointer_Grid, Row, Column) != GRID_EMPTY_CELL_VALUE) Hash ^= WorkerGetZobristKey(Row, Column, GRID_CELL(Pointer_Grid, Row, Column));
+		}
+	}
+	return Hash;
+}
+
+/** Get the address of the bucket a state hash belongs to.
+ * @param Pointer_Pool The pool owning the refuted states table, it must be enabled.
+ * @param State_Hash The state hash, it must not be zero.
+ * @return The first entry of the bucket.
+ */
+static inline unsigned long long *WorkerGetRefutedStatesBucket(TWorkerPool *Pointer_Pool, unsigned long long State_Hash)
+{
+	return &Pointer_Pool->Pointer_Refuted_States[(State_Hash & Pointer_Pool->Refuted_States_Buckets_Mask) * WORKER_REFUTED_STATES_BUCKET_SIZE];
+}
+
+/** Start loading the bucket of a state, so it is in the cache when the state is looked for.
+ * @param Pointer_Pool The pool owning the refuted states table, it must be enabled.
+ * @param State_Hash The state hash.
+ */
+static inline void WorkerPrefetchRefutedStatesBucket(TWorkerPool *Pointer_Pool, unsigned long long State_Hash)
+{
+	__builtin_prefetch(WorkerGetRefutedStatesBucket(Pointer_Pool, State_Hash), 0, 1);
+}
+
+/** Tell whether a grid state has already been proven unsolvable.
+ * @param Pointer_Pool The pool owning the refuted states table, it must be enabled.
+ * @param State_Hash The state hash.
+ * @return 1 if the state is in the table,
+ * @return 0 if the state is unknown.
+ */
+static inline int WorkerIsStateRefuted(TWorkerPool *Pointer_Pool, unsigned long long State_Hash)
+{
+	unsigned long long *Pointer_Bucket;
+	unsigned int i;
+	
+	if (State_Hash == 0) State_Hash = 1; // 0 marks the empty entries
+	Pointer_Bucket = WorkerGetRefutedStatesBucket(Pointer_Pool, State_Hash);
+	for (i = 0; i < WORKER_REFUTED_STATES_BUCKET_SIZE; i++)
+	{
+		if (__atomic_load_n(&Pointer_Bucket[i], __ATOMIC_RELAXED) == State_Hash) return 1;
+	}
+	return 0;
+}
+
+/** Record that a grid state has no solution. When the state bucket is full, an entry chosen from the hash bits is overwritten, so the old states are progressively forgotten.
+ * @param Pointer_Pool The pool owning the refuted states table, it must be enabled.
+ * @param State_Hash The state hash.
+ */
+static void WorkerAddRefutedState(TWorkerPool *Pointer_Pool, unsigned long long State_Hash)
+{
+	unsigned long long *Pointer_Bucket, Entry;
+	unsigned int i;
+	
+	if (State_Hash == 0) State_Hash = 1; // 0 marks the empty entries
+	Pointer_Bucket = WorkerGetRefutedStatesBucket(Pointer_Pool, State_Hash);
+	
+	// Use an empty entry if there is one (another worker may write the same entry at the same time, this only loses one of the states)
+	for (i = 0; i < WORKER_REFUTED_STATES_BUCKET_SIZE; i++)
+	{
+		Entry = __atomic_load_n(&Pointer_Bucket[i], __ATOMIC_RELAXED);
+		if (Entry == State_Hash) return;
+		if (Entry == 0)
+		{
+			__atomic_store_n(&Pointer_Bucket[i], State_Hash, __ATOMIC_RELAXED);
+			return;
+		}
+	}
+	
+	// The bucket selection only used the lowest hash bits, so the highest ones are still random enough to choose the replaced entry
+	__atomic_store_n(&Pointer_Bucket[(State_Hash >> 58) % WORKER_REFUTED_STATES_BUCKET_SIZE], State_Hash, __ATOMIC_RELAXED);
+}
+
+/** Give the first unexplored branch of the shallowest search tree node to an idle worker (if one is still available). A shallow node is chosen because its subtree is the biggest one, so the idle worker will not ask for work again too soon.
+ * @param Pointer_Worker The busy worker sharing its work.
+ * @param Current_Depth The depth of the node being explored by the busy worker. The cell of this node must be empty and its deduced cells must have been restored.
+ */
+static void WorkerShareWork(TWorker *Pointer_Worker, int Current_Depth)
+{
+	int Depth, i;
+	unsigned int Shared_Number;
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	TWorker *Pointer_Idle_Worker;
+	TWorkerSearchNode *Pointer_Node;
+	TGrid *Pointer_Job_Grid;
+	TCellsStackCellCoordinates *Pointer_Forced_Cells_Coordinates;
+	
+	// Find the shallowest node that still has untried numbers
+	for (Depth = Pointer_Worker->Shallowest_Shareable_Node_Depth; Depth <= Current_Depth; Depth++)
+	{
+		if (Pointer_Worker->Search_Nodes[Depth].Bitmask_Untried_Numbers != 0) break;
+	}
+	Pointer_Worker->Shallowest_Shareable_Node_Depth = Depth;
+	if (Depth > Current_Depth) return; // Nothing to share
+	
+	Pointer_Idle_Worker = WorkerTakeIdleWorker(Pointer_Pool);
+	if (Pointer_Idle_Worker == NULL) return;
+	
+	// Remove the shared number from the node so it won't be tried by this worker
+	Pointer_Node = &Pointer_Worker->Search_Nodes[Depth];
+	Shared_Number = GRID_BITMASK_GET_SMALLEST_NUMBER(Pointer_Node->Bitmask_Untried_Numbers);
+	Pointer_Node->Bitmask_Untried_Numbers &= ~GRID_BITMASK_NUMBER(Shared_Number);
+	
+	// Create the job grid by keeping only the numbers set by the nodes shallower than the shared one, including the numbers deduced from them
+	Pointer_Job_Grid = &Pointer_Idle_Worker->Grid;
+	GridCopy(&Pointer_Worker->Grid, Pointer_Job_Grid);
+	for (i = Depth + 1; i < Current_Depth; i++) GridSetCellValue(Pointer_Job_Grid, Pointer_Worker->Search_Nodes[i].Row, Pointer_Worker->Search_Nodes[i].Column, GRID_EMPTY_CELL_VALUE);
+	Pointer_Forced_Cells_Coordinates = Pointer_Worker->Forced_Cells_Stack.Cells_Coordinates;
+	for (i = Pointer_Node->Forced_Cells_Stack_Index; i < Pointer_Worker->Forced_Cells_Stack.Stack_Index; i++) GridSetCellValue(Pointer_Job_Grid, Pointer_Forced_Cells_Coordinates[i].Row, Pointer_Forced_Cells_Coordinates[i].Column, GRID_EMPTY_CELL_VALUE);
+	GridSetCellValue(Pointer_Job_Grid, Pointer_Node->Row, Pointer_Node->Column, Shared_Number);
+	GridUpdateFromCellValues(Pointer_Job_Grid);
+	Pointer_Idle_Worker->Strategy = Pointer_Worker->Strategy;
+	Pointer_Idle_Worker->Portfolio_Strategy_Index = -1;
+	
+	// Keep the number if the idle worker thread can't be created (the idle worker is not used anymore), otherwise this worker won't explore the whole node subtree
+	LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Shared number %u of node at depth %d with worker %d.\n", Pointer_Worker->Thread_ID, Shared_Number, Depth, (int) (Pointer_Idle_Worker - Pointer_Pool->Pointer_Workers));
+	if (WorkerStartJob(Pointer_Idle_Worker) != 0) Pointer_Node->Bitmask_Untried_Numbers |= GRID_BITMASK_NUMBER(Shared_Number);
+	else Pointer_Node->Is_Subtree_Refuted = 0;
+}
+
+// Instantiate the backtrack search for each supported grid size
+#define WORKER_SPECIALIZED_SIZE 6
+#define WORKER_SPECIALIZED_SQUARE_WIDTH 3
+#define WORKER_SPECIALIZED_SQUARE_HEIGHT 2
+#define WORKER_SPECIALIZED_SUFFIX _6x6
+#include <Worker_Specialized.h>
+
+#define WORKER_SPECIALIZED_SIZE 9
+#define WORKER_SPECIALIZED_SQUARE_WIDTH 3
+#define WORKER_SPECIALIZED_SQUARE_HEIGHT 3
+#define WORKER_SPECIALIZED_SUFFIX _9x9
+#include <Worker_Specialized.h>
+
+#define WORKER_SPECIALIZED_SIZE 12
+#define WORKER_SPECIALIZED_SQUARE_WIDTH 4
+#define WORKER_SPECIALIZED_SQUARE_HEIGHT 3
+#define WORKER_SPECIALIZED_SUFFIX _12x12
+#include <Worker_Specialized.h>
+
+#define WORKER_SPECIALIZED_SIZE 16
+#define WORKER_SPECIALIZED_SQUARE_WIDTH 4
+#define WORKER_SPECIALIZED_SQUARE_HEIGHT 4
+#define WORKER_SPECIALIZED_SUFFIX _16x16
+#include <Worker_Specialized.h>
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 25
+	#define WORKER_SPECIALIZED_SIZE 25
+	#define WORKER_SPECIALIZED_SQUARE_WIDTH 5
+	#define WORKER_SPECIALIZED_SQUARE_HEIGHT 5
+	#define WORKER_SPECIALIZED_SUFFIX _25x25
+	#include <Worker_Specialized.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 36
+	#define WORKER_SPECIALIZED_SIZE 36
+	#define WORKER_SPECIALIZED_SQUARE_WIDTH 6
+	#define WORKER_SPECIALIZED_SQUARE_HEIGHT 6
+	#define WORKER_SPECIALIZED_SUFFIX _36x36
+	#include <Worker_Specialized.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 49
+	#define WORKER_SPECIALIZED_SIZE 49
+	#define WORKER_SPECIALIZED_SQUARE_WIDTH 7
+	#define WORKER_SPECIALIZED_SQUARE_HEIGHT 7
+	#define WORKER_SPECIALIZED_SUFFIX _49x49
+	#include <Worker_Specialized.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 64
+	#define WORKER_SPECIALIZED_SIZE 64
+	#define WORKER_SPECIALIZED_SQUARE_WIDTH 8
+	#define WORKER_SPECIALIZED_SQUARE_HEIGHT 8
+	#define WORKER_SPECIALIZED_SUFFIX _64x64
+	#include <Worker_Specialized.h>
+#endif
+
+/** Solve a grid using the backtrack algorithm, with the search loop specialized for the grid size (see Worker_Specialized.h).
+ * @param Pointer_Worker The worker owning the grid to solve.
  * @return 0 if the grid could not be solved,
  * @return 1 if the grid was successfully solved.
  */
-static int WorkerSolveGrid(TGrid *Pointer_Grid)
+static int WorkerSolveGrid(TWorker *Pointer_Worker)
+{
+	switch (Pointer_Worker->Grid.Grid_Size)
+	{
+		case 6:
+			return WorkerSolveGrid_6x6(Pointer_Worker);
+
+		case 9:
+			return WorkerSolveGrid_9x9(Pointer_Worker);
+
+		case 12:
+			return WorkerSolveGrid_12x12(Pointer_Worker);
+
+		case 16:
+			return WorkerSolveGrid_16x16(Pointer_Worker);
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 25
+			case 25:
+				return WorkerSolveGrid_25x25(Pointer_Worker);
+		#endif
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 36
+			case 36:
+				return WorkerSolveGrid_36x36(Pointer_Worker);
+		#endif
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 49
+			case 49:
+				return WorkerSolveGrid_49x49(Pointer_Worker);
+		#endif
+
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 64
+			case 64:
+				return WorkerSolveGrid_64x64(Pointer_Worker);
+		#endif
+
+		default:
+			LOG(1, "Error : the grid size %u is not supported.\n", Pointer_Worker->Grid.Grid_Size);
+			return 0;
+	}
+}
+
+/** Give an untried row of the shallowest dancing links search tree node to an idle worker (if one is still available). The idle worker gets a grid filled with the rows of the explored branch down to the shared node, from which it builds its own smaller matrix.
+ * @param Pointer_Worker The busy worker sharing its work.
+ * @param Current_Depth The depth of the node being explored by the busy worker, its row to try must have been taken but not selected yet.
+ */
+static void WorkerShareExactCoverWork(TWorker *Pointer_Worker, int Current_Depth)
 {
-	int Row, Column;
-	unsigned int Bitmask_Missing_Numbers, Tested_Number;
+	int Depth, Shared_Row_Node, i;
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	TWorker *Pointer_Idle_Worker;
+	TExactCoverMatrix *Pointer_Matrix = &Pointer_Worker->Exact_Cover_Matrix;
+	TExactCoverSearchNode *Pointer_Node;
+	TGrid *Pointer_Job_Grid;
 	
-	// Find the first empty cell (don't remove the stack top now as the backtrack can return soon if no available number is found)
-	if (CellsStackReadTop(&Pointer_Grid->Empty_Cells_Stack, &Row, &Column) == 0)
+	// Find the shallowest node that still has untried rows
+	for (Depth = Pointer_Worker->Shallowest_Shareable_Node_Depth; Depth <= Current_Depth; Depth++)
 	{
-		// No empty cell remain and there is no error in the grid : the solution has been found
-		if (GridIsCorrectlyFilled(Pointer_Grid)) return 1;
-		
-		// A bad grid was generated...
-		return 0;
+		Pointer_Node = &Pointer_Matrix->Pointer_Search_Nodes[Depth];
+		if (Pointer_Node->Tried_Rows_Count < Pointer_Node->Rows_Count) break;
 	}
+	Pointer_Worker->Shallowest_Shareable_Node_Depth = Depth;
+	if (Depth > Current_Depth) return; // Nothing to share
 	
-	// Get available numbers for this cell
-	Bitmask_Missing_Numbers = GridGetCellMissingNumbers(Pointer_Grid, Row, Column);
-	// If no number is available a bad grid has been generated... It's safe to return here as the top of the stack has not been altered
-	if (Bitmask_Missing_Numbers == 0) return 0;
+	Pointer_Idle_Worker = WorkerTakeIdleWorker(Pointer_Pool);
+	if (Pointer_Idle_Worker == NULL) return;
 	
-	// Try each available number
-	for (Tested_Number = 0; Tested_Number < Pointer_Grid->Grid_Size; Tested_Number++)
+	// Remove the shared row from the node so it won't be tried by this worker
+	Pointer_Node->Rows_Count--;
+	Shared_Row_Node = Pointer_Node->Pointer_Rows[Pointer_Node->Rows_Count];
+	
+	// Create the job grid from the grid the worker started with, adding the rows tried by the shallower nodes and the shared row
+	Pointer_Job_Grid = &Pointer_Idle_Worker->Grid;
+	GridCopy(&Pointer_Worker->Grid, Pointer_Job_Grid);
+	for (i = 0; i < Depth; i++) ExactCoverSetCellValue(Pointer_Matrix, Pointer_Matrix->Pointer_Search_Nodes[i].Pointer_Rows[Pointer_Matrix->Pointer_Search_Nodes[i].Tried_Rows_Count - 1], Pointer_Job_Grid);
+	ExactCoverSetCellValue(Pointer_Matrix, Shared_Row_Node, Pointer_Job_Grid);
+	GridUpdateFromCellValues(Pointer_Job_Grid);
+	Pointer_Idle_Worker->Strategy = Pointer_Worker->Strategy;
+	Pointer_Idle_Worker->Portfolio_Strategy_Index = -1;
+	
+	// Keep the row if the idle worker thread can't be created (the idle worker is not used anymore)
+	LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Shared row of node at depth %d with worker %d.\n", Pointer_Worker->Thread_ID, Depth, (int) (Pointer_Idle_Worker - Pointer_Pool->Pointer_Workers));
+	if (WorkerStartJob(Pointer_Idle_Worker) != 0) Pointer_Node->Rows_Count++;
+}
+
+/** Solve a grid using the dancing links algorithm. The search is iterative like the backtrack one, the matrix search nodes recording the covered columns and their tried rows. A randomized search tries the rows of each column in a random order and restarts like the backtrack one.
+ * @param Pointer_Worker The worker owning the grid to solve. The grid is only modified when its solution is found.
+ * @return -1 if the matrix could not be built, so the job has not been searched,
+ * @return 0 if the grid could not be solved,
+ * @return 1 if the grid was successfully solved.
+ * @note This function prints an error message if the matrix can't be built.
+ */
+static int WorkerSolveGridExactCover(TWorker *Pointer_Worker)
+{
+	int Depth = 0, Is_Node_Entered = 1, i, j, Row_Node, Is_Numbers_Order_Reversed = Pointer_Worker->Strategy.Is_Numbers_Order_Reversed, Is_Work_Shared = Pointer_Worker->Portfolio_Strategy_Index < 0;
+	TGrid *Pointer_Grid = &Pointer_Worker->Grid;
+	TExactCoverMatrix *Pointer_Matrix = &Pointer_Worker->Exact_Cover_Matrix;
+	TExactCoverSearchNode *Pointer_Node;
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	unsigned long long Maximum_Solutions_Count = Pointer_Pool->Maximum_Solutions_Count, Solutions_Publishing_Period = Pointer_Pool->Solutions_Publishing_Period;
+	int Is_Search_Randomized = Pointer_Worker->Strategy.Random_Seed != 0;
+	unsigned long long Random_State = 0, Restarts_Count = 0, Run_Explored_Nodes_Count = 0, Run_Maximum_Explored_Nodes_Count = WorkerGetRestartNodesCount(Pointer_Worker, 0);
+	
+	// The matrix memory is reused from the previous jobs when it is big enough
+	if (ExactCoverBuildMatrix(Pointer_Matrix, Pointer_Grid) != 0)
 	{
-		// Loop until an available number is found
-		if (!(Bitmask_Missing_Numbers & (1 << Tested_Number))) continue;
+		LOG(1, "Error : not enough memory to build the exact cover matrix of worker %d.\n", (int) (Pointer_Worker - Pointer_Pool->Pointer_Workers));
+		return -1;
+	}
+	if (Is_Search_Randomized) Random_State = WorkerSeedRandomSequence(Pointer_Worker);
+	
+	while (1)
+	{
+		// Throw the explored tree away when the run budget is exhausted, undoing the selected rows gives back the job matrix (the grid is left untouched by the search)
+		if (Is_Node_Entered && (Run_Explored_Nodes_Count >= Run_Maximum_Explored_Nodes_Count))
+		{
+			for (i = Depth - 1; i >= 0; i--)
+			{
+				Pointer_Node = &Pointer_Matrix->Pointer_Search_Nodes[i];
+				ExactCoverDeselectRow(Pointer_Matrix, Pointer_Node->Pointer_Rows[Pointer_Node->Tried_Rows_Count - 1]);
+				ExactCoverLeaveNode(Pointer_Matrix, i);
+			}
+			Depth = 0;
+			Pointer_Worker->Shallowest_Shareable_Node_Depth = 0;
+			
+			Restarts_Count++;
+			Pointer_Worker->Statistics.Restarts_Count++;
+			Run_Maximum_Explored_Nodes_Count = WorkerGetRestartNodesCount(Pointer_Worker, Restarts_Count);
+			Run_Explored_Nodes_Count = 0;
+			LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Restarted the search, the next run can explore %llu nodes.\n", Pointer_Worker->Thread_ID, Run_Maximum_Explored_Nodes_Count);
+		}
+		Pointer_Node = &Pointer_Matrix->Pointer_Search_Nodes[Depth];
+		
+		// Choose the column to cover when the tree is entered at this depth
+		if (Is_Node_Entered)
+		{
+			Run_Explored_Nodes_Count++;
+			Pointer_Worker->Statistics.Explored_Nodes_Count++;
+			
+			// All columns are covered : the rows tried by the shallower nodes are a solution
+			if (ExactCoverEnterNode(Pointer_Matrix, Depth) == 0)
+			{
+				// Only the first solution counted since the last publication can be the grid first one, this avoids reading the shared time for each solution
+				if (Pointer_Worker->Unpublished_Solutions_Count == 0) WorkerRecordFirstSolutionTime(Pointer_Pool);
+				if (Maximum_Solutions_Count == 0)
+				{
+					for (i = 0; i < Depth; i++) ExactCoverSetCellValue(Pointer_Matrix, Pointer_Matrix->Pointer_Search_Nodes[i].Pointer_Rows[Pointer_Matrix->Pointer_Search_Nodes[i].Tried_Rows_Count - 1], Pointer_Grid);
+					GridUpdateFromCellValues(Pointer_Grid);
+					return 1;
+				}
+				
+				// Count the solution, then keep searching for other ones
+				Pointer_Worker->Unpublished_Solutions_Count++;
+				if (Pointer_Worker->Unpublished_Solutions_Count >= Solutions_Publishing_Period) WorkerPublishSolutionsCount(Pointer_Worker);
+				
+				// Go back to the parent node
+				if (Depth == 0) return 0;
+				Depth--;
+				Pointer_Worker->Statistics.Backtracks_Count++;
+				Is_Node_Entered = 0;
+				continue;
+			}
+			
+			if (Pointer_Node->Rows_Count == 0) Pointer_Worker->Statistics.Dead_Ends_Count++;
+			if (Pointer_Worker->Shallowest_Shareable_Node_Depth > Depth) Pointer_Worker->Shallowest_Shareable_Node_Depth = Depth;
+			
+			// The rows are tried from the first one, so shuffle their list to try them in a random order, or reverse it to try the last one first
+			if (Is_Search_Randomized)
+			{
+				for (i = Pointer_Node->Rows_Count - 1; i > 0; i--)
+				{
+					j = WorkerGetRandomNumber(&Random_State) % (i + 1);
+					Row_Node = Pointer_Node->Pointer_Rows[i];
+					Pointer_Node->Pointer_Rows[i] = Pointer_Node->Pointer_Rows[j];
+					Pointer_Node->Pointer_Rows[j] = Row_Node;
+				}
+			}
+			else if (Is_Numbers_Order_Reversed)
+			{
+				for (i = 0; i < Pointer_Node->Rows_Count / 2; i++)
+				{
+					Row_Node = Pointer_Node->Pointer_Rows[i];
+					Pointer_Node->Pointer_Rows[i] = Pointer_Node->Pointer_Rows[Pointer_Node->Rows_Count - 1 - i];
+					Pointer_Node->Pointer_Rows[Pointer_Node->Rows_Count - 1 - i] = Row_Node;
+				}
+			}
+		}
+		// Otherwise the tried row led to a dead end, remove it from the solution
+		else ExactCoverDeselectRow(Pointer_Matrix, Pointer_Node->Pointer_Rows[Pointer_Node->Tried_Rows_Count - 1]);
+		
+		// All rows were tried unsuccessfully (or given to other workers meanwhile), go back into the tree
+		if (Pointer_Node->Tried_Rows_Count >= Pointer_Node->Rows_Count)
+		{
+			ExactCoverLeaveNode(Pointer_Matrix, Depth);
+			if (Depth == 0) return 0;
+			Depth--;
+			Pointer_Worker->Statistics.Backtracks_Count++;
+			Is_Node_Entered = 0;
+			continue;
+		}
 		
-		// Try the number
-		GridSetCellValue(Pointer_Grid, Row, Column, Tested_Number);
-		GridRemoveCellMissingNumber(Pointer_Grid, Row, Column, Tested_Number);
-		CellsStackRemoveTop(&Pointer_Grid->Empty_Cells_Stack); // Really try to fill this cell, removing it for next simulation step
+		// Stop searching if the job is not needed anymore (the matrix does not need to be restored as it will be built again by the next job)
+		if (Pointer_Pool->Is_Cancellation_Requested) return 0;
 		
-		// Simulate next state
-		if (WorkerSolveGrid(Pointer_Grid) == 1) return 1; // Good solution found, go to tree root
+		// Take the next row, the untried rows are shared from the end of the list
+		Pointer_Node->Tried_Rows_Count++;
+		if (Is_Work_Shared && WorkerIsWorkerAvailable(Pointer_Pool)) WorkerShareExactCoverWork(Pointer_Worker, Depth);
 		
-		// Bad solution found, restore old value
-		GridSetCellValue(Pointer_Grid, Row, Column, GRID_EMPTY_CELL_VALUE);
-		GridRestoreCellMissingNumber(Pointer_Grid, Row, Column, Tested_Number);
-		CellsStackPush(&Pointer_Grid->Empty_Cells_Stack, Row, Column); // The cell is available again
+		// Try the row
+		ExactCoverSelectRow(Pointer_Matrix, Pointer_Node->Pointer_Rows[Pointer_Node->Tried_Rows_Count - 1]);
+		Depth++;
+		Is_Node_Entered = 1;
 	}
-	// All numbers were tested unsuccessfully, go back into the tree
-	return 0;
 }
 
 /** The function executed by the thread.
@@ -133,39 +955,92 @@ static int WorkerSolveGrid(TGrid *Pointer_Grid)
 static void *WorkerThreadFunction(void *Pointer_Argument)
 {
 	TWorker *Pointer_Worker = Pointer_Argument;
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	unsigned long long Starting_Time, Idle_Starting_Time;
+	int Is_Job_Given, Result;
 	
-	// Retrieve TID
+	// Retrieve TID (the worker is already in the available workers stack, a job may even have been given to it)
 	Pointer_Worker->Thread_ID = syscall(SYS_gettid);
 	
-	// Add worker to "ready" stack
-	WorkerStackPush(Pointer_Worker);
-	
-	// Threads do not gracefully terminate, they stop when program exits (this avoids checking for a lot of conditions or changing thread cancellation state)
+	// Threads terminate when WorkerExit() is called on them, or when they are idle for too long
 	while (1)
 	{
 		// Wait for a grid to solve or for an exit request
 		LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Waiting for a grid to solve...\n", Pointer_Worker->Thread_ID);
-		pthread_mutex_lock(&Pointer_Worker->Mutex_Wait_Condition);
-		while (Pointer_Worker->Is_Waiting_Requested) pthread_cond_wait(&Pointer_Worker->Wait_Condition, &Pointer_Worker->Mutex_Wait_Condition);
-		Pointer_Worker->Is_Waiting_Requested = 1;
-		pthread_mutex_unlock(&Pointer_Worker->Mutex_Wait_Condition);
+		__atomic_store_n(&Pointer_Worker->Idle_Starting_Time, TimerGetNanoseconds(), __ATOMIC_RELAXED);
+		Is_Job_Given = WorkerWaitForJob(Pointer_Worker);
+		
+		// Account for the part of the wait that WorkerGetStatistics() has not accounted yet (the thread giving the next job waits for this thread termination before creating a new thread, so the worker data can still be written when the thread is stopping)
+		Idle_Starting_Time = __atomic_exchange_n(&Pointer_Worker->Idle_Starting_Time, 0, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&Pointer_Worker->Statistics.Idle_Time, TimerGetNanoseconds() - Idle_Starting_Time, __ATOMIC_RELAXED);
 		
 		// Should the thread terminate ?
+		if (!Is_Job_Given)
+		{
+			LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Worker exited after being idle for too long.\n", Pointer_Worker->Thread_ID);
+			return NULL;
+		}
 		if (Pointer_Worker->Is_Exit_Requested)
 		{
 			LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Worker exited as requested.\n", Pointer_Worker->Thread_ID);
 			return NULL;
 		}
+		WorkerMoveToProcessor(Pointer_Worker);
 		
 		// Start solving
 		LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Starting solving grid.\n", Pointer_Worker->Thread_ID);
-		Pointer_Worker->Is_Grid_Solved = WorkerSolveGrid(&Pointer_Worker->Grid);
+		Pointer_Worker->Statistics.Received_Jobs_Count++;
+		Starting_Time = TimerGetNanoseconds();
+		Pointer_Worker->Shallowest_Shareable_Node_Depth = 0;
+		CellsStackInitialize(&Pointer_Worker->Forced_Cells_Stack);
+		if (Pointer_Worker->Strategy.Algorithm == WORKER_ALGORITHM_DANCING_LINKS) Result = WorkerSolveGridExactCover(Pointer_Worker);
+		else Result = WorkerSolveGrid(Pointer_Worker);
+		Pointer_Worker->Is_Grid_Solved = Result > 0;
+		
 		if (Pointer_Worker->Is_Grid_Solved) LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] A grid solution has been found.\n", Pointer_Worker->Thread_ID);
 		else LOG(WORKER_IS_DEBUG_ENABLED, "[TID %d] Bad grid generated, worker is available for a new job.\n", Pointer_Worker->Thread_ID);
 		
-		// Tell that the worker is available for a new job
+		// The job subtree has not been searched, so the grid result is unknown unless another worker finds a solution or, when racing, explores its whole search tree : a shared search tree is incomplete, so stop the other workers, but the other racing strategies keep searching
+		if (Result < 0)
+		{
+			Pointer_Pool->Is_Error = 1;
+			if (Pointer_Worker->Portfolio_Strategy_Index < 0) Pointer_Pool->Is_Cancellation_Requested = 1;
+		}
+		// A racing job that was not cancelled explored its whole search tree, so the grid has no solution and the other strategies can stop
+		else if ((Result == 0) && (Pointer_Worker->Portfolio_Strategy_Index >= 0) && !Pointer_Pool->Is_Cancellation_Requested)
+		{
+			Pointer_Pool->Is_Search_Tree_Exhausted = 1;
+			Pointer_Pool->Is_Cancellation_Requested = 1;
+		}
+		
+		// Add the remaining counted solutions to the total before the job is reported as terminated, so the total is complete when all workers are idle
+		if (Pointer_Worker->Unpublished_Solutions_Count > 0) WorkerPublishSolutionsCount(Pointer_Worker);
+		Pointer_Worker->Statistics.Busy_Time += TimerGetNanoseconds() - Starting_Time; // The statistics are updated before the job is reported as terminated, so they are up to date when all workers are idle
+		
+		// Report the solution (it must be known before the worker is made available, so nobody gives it a new job overwriting the solved grid)
+		if (Pointer_Worker->Is_Grid_Solved)
+		{
+			pthread_mutex_lock(&Pointer_Pool->Completion_Mutex);
+			if (!Pointer_Pool->Is_Solution_Found)
+			{
+				Pointer_Pool->Is_Solution_Found = 1;
+				Pointer_Pool->Pointer_Worker_Solution = Pointer_Worker;
+				Pointer_Pool->Is_Cancellation_Requested = 1; // Stop the other workers
+				pthread_cond_broadcast(&Pointer_Pool->Completion_Condition);
+			}
+			pthread_mutex_unlock(&Pointer_Pool->Completion_Mutex);
+		}
+		
+		// Tell that the worker is available for a new job before the job is reported as terminated, so all workers are in the available workers stack when no worker is busy
 		WorkerStackPush(Pointer_Worker);
-		sem_post(&Worker_Semaphore_Available_Workers_Count); // Increment the atomic counter
+		
+		// Only the last busy worker needs to take the lock, the waiting thread checks the counter with the lock taken so it can't miss the signal
+		if (__atomic_sub_fetch(&Pointer_Pool->Busy_Workers_Count, 1, __ATOMIC_ACQ_REL) == 0)
+		{
+			pthread_mutex_lock(&Pointer_Pool->Completion_Mutex);
+			pthread_cond_broadcast(&Pointer_Pool->Completion_Condition);
+			pthread_mutex_unlock(&Pointer_Pool->Completion_Mutex);
+		}
 	}
 	
 	return NULL;
@@ -174,97 +1049,358 @@ static void *WorkerThreadFunction(void *Pointer_Argument)
 //-------------------------------------------------------------------------------------------------
 // Public functions
 //-------------------------------------------------------------------------------------------------
-int WorkerInitialize(int Maximum_Workers_Count)
+int WorkerInitialize(TWorkerPool *Pointer_Pool, int Maximum_Workers_Count)
 {
-	int i;
-	pthread_t Thread_ID;
+	TWorker *Pointer_Worker;
+	
+	// Start from a clean pool with the default settings
+	memset(Pointer_Pool, 0, sizeof(TWorkerPool));
+	Pointer_Pool->Algorithm = WORKER_ALGORITHM_BACKTRACK;
+	Pointer_Pool->Cell_Selection_Heuristic = WORKER_CELL_SELECTION_HEURISTIC_FIRST_EMPTY_CELL;
+	Pointer_Pool->Propagation_Level = GRID_PROPAGATION_LEVEL_NONE;
+	Pointer_Pool->Solutions_Publishing_Period = 1;
+	Pointer_Pool->Idle_Timeout = WORKER_DEFAULT_IDLE_TIMEOUT;
+	Pointer_Pool->Restart_Policy = WORKER_RESTART_POLICY_LUBY;
+	Pointer_Pool->Restart_Nodes_Count = WORKER_DEFAULT_RESTART_NODES_COUNT;
+	Pointer_Pool->Restart_Growth_Factor = WORKER_DEFAULT_RESTART_GROWTH_FACTOR;
+	
+	// Allocate the workers (they are aligned on a cache line to keep their statistics away from the other workers ones), they are initialized when they are used for the first time
+	Pointer_Pool->Pointer_Workers = aligned_alloc(CONFIGURATION_CACHE_LINE_SIZE, Maximum_Workers_Count * sizeof(TWorker));
+	if (Pointer_Pool->Pointer_Workers == NULL)
+	{
+		LOG(1, "Error : not enough memory to create %d workers.\n", Maximum_Workers_Count);
+		return -1;
+	}
+	Pointer_Pool->Maximum_Workers_Count = Maximum_Workers_Count;
+	WorkerSetWorkersCount(Pointer_Pool, Maximum_Workers_Count);
+	
+	// Create the synchronization primitives
+	if ((pthread_mutex_init(&Pointer_Pool->Completion_Mutex, NULL) != 0) || (pthread_cond_init(&Pointer_Pool->Completion_Condition, NULL) != 0))
+	{
+		LOG(1, "Error : failed to create the workers synchronization primitives.\n");
+		return -1;
+	}
+	
+	// Create the first worker thread only, the other threads are created when there is work for them
+	Pointer_Worker = WorkerCreate(Pointer_Pool);
+	Pointer_Worker->Job_State = WORKER_JOB_STATE_WAITING; // Thread will wait until a job is given to it or it receives an exit request
+	if (WorkerStartThread(Pointer_Worker) != 0) return -1;
+	WorkerStackPush(Pointer_Worker);
+	
+	return 0;
+}
+
+void WorkerSetAlgorithm(TWorkerPool *Pointer_Pool, TWorkerAlgorithm Algorithm)
+{
+	Pointer_Pool->Algorithm = Algorithm;
+}
+
+void WorkerSetCellSelectionHeuristic(TWorkerPool *Pointer_Pool, TWorkerCellSelectionHeuristic Heuristic)
+{
+	Pointer_Pool->Cell_Selection_Heuristic = Heuristic;
+}
+
+void WorkerSetPropagationLevel(TWorkerPool *Pointer_Pool, TGridPropagationLevel Propagation_Level)
+{
+	Pointer_Pool->Propagation_Level = Propagation_Level;
+}
+
+void WorkerSetRandomSeed(TWorkerPool *Pointer_Pool, unsigned long long Random_Seed)
+{
+	Pointer_Pool->Random_Seed = Random_Seed;
+}
+
+void WorkerSetRestartPolicy(TWorkerPool *Pointer_Pool, TWorkerRestartPolicy Restart_Policy, unsigned long long Restart_Nodes_Count, double Restart_Growth_Factor)
+{
+	Pointer_Pool->Restart_Policy = Restart_Policy;
+	Pointer_Pool->Restart_Nodes_Count = Restart_Nodes_Count;
+	Pointer_Pool->Restart_Growth_Factor = Restart_Growth_Factor;
+}
+
+int WorkerSetRefutedStatesTableSize(TWorkerPool *Pointer_Pool, unsigned long long Maximum_Size)
+{
+	unsigned long long Buckets_Count = 1;
 	
-	// Create the atomic counter
-	if (sem_init(&Worker_Semaphore_Available_Workers_Count, 0, Maximum_Workers_Count) != 0)
+	free(Pointer_Pool->Pointer_Refuted_States);
+	Pointer_Pool->Pointer_Refuted_States = NULL;
+	if (Maximum_Size < CONFIGURATION_CACHE_LINE_SIZE) return 0;
+	
+	// Use the biggest power of two buckets count that fits
+	while (Buckets_Count * 2 <= Maximum_Size / CONFIGURATION_CACHE_LINE_SIZE) Buckets_Count *= 2;
+	Pointer_Pool->Pointer_Refuted_States = aligned_alloc(CONFIGURATION_CACHE_LINE_SIZE, Buckets_Count * CONFIGURATION_CACHE_LINE_SIZE);
+	if (Pointer_Pool->Pointer_Refuted_States == NULL)
 	{
-		LOG(1, "Error : failed to create the workers semaphore.\n");
+		LOG(1, "Error : not enough memory to allocate a %llu-byte refuted states table.\n", Buckets_Count * CONFIGURATION_CACHE_LINE_SIZE);
 		return -1;
 	}
+	memset(Pointer_Pool->Pointer_Refuted_States, 0, Buckets_Count * CONFIGURATION_CACHE_LINE_SIZE);
+	Pointer_Pool->Refuted_States_Buckets_Mask = Buckets_Count - 1;
 	
-	// Create all workers
-	for (i = 0; i < Maximum_Workers_Count; i++)
+	return 0;
+}
+
+void WorkerSetMaximumSolutionsCount(TWorkerPool *Pointer_Pool, unsigned long long Maximum_Solutions_Count)
+{
+	Pointer_Pool->Maximum_Solutions_Count = Maximum_Solutions_Count;
+	
+	// Share the counted solutions often enough to detect that the limit is exceeded without exploring too much of the search tree
+	Pointer_Pool->Solutions_Publishing_Period = Maximum_Solutions_Count / 256;
+	if (Pointer_Pool->Solutions_Publishing_Period < 1) Pointer_Pool->Solutions_Publishing_Period = 1;
+	else if (Pointer_Pool->Solutions_Publishing_Period > WORKER_SOLUTIONS_PUBLISHING_MAXIMUM_PERIOD) Pointer_Pool->Solutions_Publishing_Period = WORKER_SOLUTIONS_PUBLISHING_MAXIMUM_PERIOD;
+}
+
+int WorkerSetWorkersCount(TWorkerPool *Pointer_Pool, int Workers_Count)
+{
+	// The workers already used stay in the available workers stack, so they can't be removed
+	if ((Workers_Count < 1) || (Workers_Count < Pointer_Pool->Created_Workers_Count) || (Workers_Count > Pointer_Pool->Maximum_Workers_Count))
+	{
+		LOG(1, "Error : the workers count must be in range [%d; %d].\n", Pointer_Pool->Created_Workers_Count > 1 ? Pointer_Pool->Created_Workers_Count : 1, Pointer_Pool->Maximum_Workers_Count);
+		return -1;
+	}
+	Pointer_Pool->Workers_Count = Workers_Count;
+	
+	// Waiting actively only helps when the thread giving the job runs at the same time on another processor, otherwise it delays the thread giving the job
+	if (Workers_Count < sysconf(_SC_NPROCESSORS_ONLN)) Pointer_Pool->Job_Waiting_Spins_Count = WORKER_JOB_WAITING_SPINS_COUNT;
+	else Pointer_Pool->Job_Waiting_Spins_Count = 0;
+	
+	return 0;
+}
+
+void WorkerSetIdleTimeout(TWorkerPool *Pointer_Pool, unsigned int Milliseconds)
+{
+	Pointer_Pool->Idle_Timeout = Milliseconds;
+}
+
+int WorkerBindToProcessors(TWorkerPool *Pointer_Pool, TAffinityProcessor Placement[])
+{
+	// Keep the placement, as most threads do not exist yet
+	if (Pointer_Pool->Pointer_Placement == NULL)
 	{
-		// Create wait condition mutex first because thread callback will use it
-		if (pthread_mutex_init(&Workers[i].Mutex_Wait_Condition, NULL) != 0)
+		Pointer_Pool->Pointer_Placement = malloc(Pointer_Pool->Maximum_Workers_Count * sizeof(TAffinityProcessor));
+		if (Pointer_Pool->Pointer_Placement == NULL)
 		{
-			LOG(1, "Error : failed to create worker %d wait condition mutex (%s).\n", i, strerror(errno));
+			LOG(1, "Error : not enough memory to keep the placement of %d workers.\n", Pointer_Pool->Maximum_Workers_Count);
 			return -1;
 		}
+	}
+	memcpy(Pointer_Pool->Pointer_Placement, Placement, Pointer_Pool->Maximum_Workers_Count * sizeof(TAffinityProcessor));
+	
+	return 0;
+}
+
+unsigned long long WorkerGetSolutionsCount(TWorkerPool *Pointer_Pool)
+{
+	return __atomic_load_n(&Pointer_Pool->Solutions_Count, __ATOMIC_RELAXED);
+}
+
+unsigned long long WorkerGetFirstSolutionTime(TWorkerPool *Pointer_Pool)
+{
+	return __atomic_load_n(&Pointer_Pool->First_Solution_Time, __ATOMIC_RELAXED);
+}
+
+void WorkerGetStatistics(TWorkerPool *Pointer_Pool, TWorkerStatistics Workers_Statistics[])
+{
+	int i, Created_Workers_Count;
+	TWorker *Pointer_Worker;
+	unsigned long long Current_Time, Idle_Starting_Time;
+	
+	Created_Workers_Count = __atomic_load_n(&Pointer_Pool->Created_Workers_Count, __ATOMIC_ACQUIRE);
+	for (i = 0; i < Created_Workers_Count; i++)
+	{
+		Pointer_Worker = &Pointer_Pool->Pointer_Workers[i];
 		
-		// Create wait condition first because thread callback will use it
-		Workers[i].Is_Waiting_Requested = 1; // Thread will wait until a job is given to it or it receives an exit request
-		if (pthread_cond_init(&Workers[i].Wait_Condition, NULL) != 0)
+		// Account for the current wait up to now, moving the wait starting time forward succeeds only if the thread has not stopped waiting meanwhile (otherwise the thread accounts for the whole wait)
+		Idle_Starting_Time = __atomic_load_n(&Pointer_Worker->Idle_Starting_Time, __ATOMIC_RELAXED);
+		if (Idle_Starting_Time != 0)
 		{
-			LOG(1, "Error : failed to create worker %d wait condition (%s).\n", i, strerror(errno));
-			return -1;
+			Current_Time = TimerGetNanoseconds();
+			if (__atomic_compare_exchange_n(&Pointer_Worker->Idle_Starting_Time, &Idle_Starting_Time, Current_Time, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) __atomic_add_fetch(&Pointer_Worker->Statistics.Idle_Time, Current_Time - Idle_Starting_Time, __ATOMIC_RELAXED);
 		}
 		
-		// Create thread
-		Workers[i].Is_Exit_Requested = 0;
-		if (pthread_create(&Thread_ID, NULL, WorkerThreadFunction, &Workers[i]) != 0) // Thread ID is not needed, so do not keep it
-		{
-			LOG(1, "Error : failed to create worker thread %d (%s).\n", i, strerror(errno));
-			return -1;
-		}
+		Workers_Statistics[i] = Pointer_Worker->Statistics;
+		Workers_Statistics[i].Idle_Time = __atomic_load_n(&Pointer_Worker->Statistics.Idle_Time, __ATOMIC_RELAXED);
 	}
 	
-	// Wait for all threads to become ready (each thread adds itself to workers stack when ready)
-	while (Worker_Stack_Index < Maximum_Workers_Count);
-
-	return 0;
+	// The workers that have never been used did nothing
+	for (; i < Pointer_Pool->Workers_Count; i++) memset(&Workers_Statistics[i], 0, sizeof(TWorkerStatistics));
 }
 
-void WorkerUninitialize(void)
+void WorkerUninitialize(TWorkerPool *Pointer_Pool)
 {
-	// Release the semaphore (threads are not gracefully released because they do not handle data that should be kept safe, like files)
-	sem_destroy(&Worker_Semaphore_Available_Workers_Count);
+	int i;
+	TWorker *Pointer_Worker;
+	
+	// Stop all jobs, so all workers are waiting for a new job
+	WorkerCancel(Pointer_Pool);
+	WorkerWaitForAllWorkersIdle(Pointer_Pool);
+	
+	// Terminate all threads, including the ones that exited after being idle for too long and have not been waited for
+	for (i = 0; i < Pointer_Pool->Created_Workers_Count; i++)
+	{
+		Pointer_Worker = &Pointer_Pool->Pointer_Workers[i];
+		WorkerExit(Pointer_Worker);
+		if (Pointer_Worker->Is_Thread_Created) pthread_join(Pointer_Worker->Thread, NULL);
+		ExactCoverReleaseMatrix(&Pointer_Worker->Exact_Cover_Matrix);
+	}
+	
+	// Release the pool resources
+	pthread_cond_destroy(&Pointer_Pool->Completion_Condition);
+	pthread_mutex_destroy(&Pointer_Pool->Completion_Mutex);
+	free(Pointer_Pool->Pointer_Workers);
+	Pointer_Pool->Pointer_Workers = NULL;
+	free(Pointer_Pool->Pointer_Placement);
+	Pointer_Pool->Pointer_Placement = NULL;
+	free(Pointer_Pool->Pointer_Refuted_States);
+	Pointer_Pool->Pointer_Refuted_States = NULL;
+	Pointer_Pool->Available_Workers_Stack_Top = 0;
+	Pointer_Pool->Workers_Count = 0;
+	Pointer_Pool->Maximum_Workers_Count = 0;
+	Pointer_Pool->Created_Workers_Count = 0;
 }
 
 void WorkerSolve(TWorker *Pointer_Worker)
 {
-	// No solution has been found yet
-	Pointer_Worker->Is_Grid_Solved = 0;
+	TWorker *Pointer_Available_Worker;
+	TWorkerPool *Pointer_Pool = Pointer_Worker->Pointer_Pool;
+	
+	// Use the pool settings, the workers taking parts of the search tree will use them too
+	Pointer_Worker->Strategy.Algorithm = Pointer_Pool->Algorithm;
+	Pointer_Worker->Strategy.Cell_Selection_Heuristic = Pointer_Pool->Cell_Selection_Heuristic;
+	Pointer_Worker->Strategy.Propagation_Level = Pointer_Pool->Propagation_Level;
+	Pointer_Worker->Strategy.Is_Numbers_Order_Reversed = 0;
+	Pointer_Worker->Strategy.Random_Seed = Pointer_Pool->Random_Seed;
+	Pointer_Worker->Strategy.Restart_Policy = Pointer_Pool->Restart_Policy;
+	Pointer_Worker->Strategy.Restart_Nodes_Count = Pointer_Pool->Restart_Nodes_Count;
+	Pointer_Worker->Strategy.Restart_Growth_Factor = Pointer_Pool->Restart_Growth_Factor;
+	Pointer_Worker->Portfolio_Strategy_Index = -1;
 	
-	// Wake thread up
-	pthread_mutex_lock(&Pointer_Worker->Mutex_Wait_Condition);
-	Pointer_Worker->Is_Waiting_Requested = 0;
-	pthread_cond_signal(&Pointer_Worker->Wait_Condition);
-	pthread_mutex_unlock(&Pointer_Worker->Mutex_Wait_Condition);
+	// Give the grid to another worker if the thread can't be created (the first worker thread never exits, so a worker will be available at last)
+	while (WorkerStartJob(Pointer_Worker) != 0)
+	{
+		Pointer_Available_Worker = WorkerStackPop(Pointer_Pool);
+		GridCopy(&Pointer_Worker->Grid, &Pointer_Available_Worker->Grid);
+		Pointer_Available_Worker->Strategy = Pointer_Worker->Strategy;
+		Pointer_Available_Worker->Portfolio_Strategy_Index = -1;
+		Pointer_Worker = Pointer_Available_Worker;
+	}
 }
 
-int WorkerWaitForAvailableWorker(TWorker **Pointer_Pointer_Worker)
+int WorkerSolvePortfolio(TWorkerPool *Pointer_Pool, TGrid *Pointer_Grid)
 {
+	int Deterministic_Strategies_Count = sizeof(Worker_Portfolio_Strategies) / sizeof(Worker_Portfolio_Strategies[0]), Started_Jobs_Count = 0, i;
 	TWorker *Pointer_Worker;
-	int Available_Workers;
+	TWorkerStrategy *Pointer_Strategy;
 	
-	// Block until a worker is available
-	sem_wait(&Worker_Semaphore_Available_Workers_Count); // Decrement the atomic counter
-	sem_getvalue(&Worker_Semaphore_Available_Workers_Count, &Available_Workers);
+	for (i = 0; i < Pointer_Pool->Workers_Count; i++)
+	{
+		// Stop giving the grid when a worker already found the result (the worker that found the solution is given back untouched)
+		Pointer_Worker = WorkerTakeIdleWorker(Pointer_Pool);
+		if (Pointer_Worker == NULL) break;
+		
+		GridCopy(Pointer_Grid, &Pointer_Worker->Grid);
+		Pointer_Strategy = &Pointer_Worker->Strategy;
+		if (i < Deterministic_Strategies_Count) *Pointer_Strategy = Worker_Portfolio_Strategies[i];
+		// The workers beyond the fixed portfolio run the strongest backtrack strategy with a random search order of their own, restarting with the pool policy
+		else
+		{
+			Pointer_Strategy->Algorithm = WORKER_ALGORITHM_BACKTRACK;
+			Pointer_Strategy->Cell_Selection_Heuristic = WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL;
+			Pointer_Strategy->Propagation_Level = GRID_PROPAGATION_LEVEL_HIDDEN_SINGLES;
+			Pointer_Strategy->Is_Numbers_Order_Reversed = 0;
+			Pointer_Strategy->Random_Seed = Pointer_Pool->Random_Seed + i;
+			if (Pointer_Strategy->Random_Seed == 0) Pointer_Strategy->Random_Seed = 1; // Zero would disable the randomization
+			Pointer_Strategy->Restart_Policy = Pointer_Pool->Restart_Policy;
+			Pointer_Strategy->Restart_Nodes_Count = Pointer_Pool->Restart_Nodes_Count;
+			Pointer_Strategy->Restart_Growth_Factor = Pointer_Pool->Restart_Growth_Factor;
+		}
+		Pointer_Worker->Portfolio_Strategy_Index = i;
+		
+		// A worker whose thread can't be created is not used anymore, so its strategy is skipped
+		if (WorkerStartJob(Pointer_Worker) == 0) Started_Jobs_Count++;
+	}
+	
+	return Started_Jobs_Count;
+}
+
+void WorkerConvertStrategyToString(TWorkerStrategy *Pointer_Strategy, char *Pointer_Output_String)
+{
+	static const char *String_Propagation_Levels[] = {"no propagation", "forward checking", "naked singles", "hidden singles"};
+	int Length;
 	
-	// Retrieve first available worker
-	Pointer_Worker = WorkerStackPop();
+	// A randomized search order replaces the fixed one
+	if (Pointer_Strategy->Algorithm == WORKER_ALGORITHM_DANCING_LINKS)
+	{
+		if (Pointer_Strategy->Random_Seed != 0) Length = sprintf(Pointer_Output_String, "dancing links, rows tried in random order");
+		else Length = sprintf(Pointer_Output_String, "dancing links, rows tried %s", Pointer_Strategy->Is_Numbers_Order_Reversed ? "in reverse order" : "in order");
+	}
+	else Length = sprintf(Pointer_Output_String, "backtrack, %s, %s, %s", Pointer_Strategy->Cell_Selection_Heuristic == WORKER_CELL_SELECTION_HEURISTIC_MOST_CONSTRAINED_CELL ? "most constrained cell" : "first empty cell",
+		String_Propagation_Levels[Pointer_Strategy->Propagation_Level], Pointer_Strategy->Random_Seed != 0 ? "random numbers order" : (Pointer_Strategy->Is_Numbers_Order_Reversed ? "biggest numbers first" : "smallest numbers first"));
+	if (Pointer_Strategy->Random_Seed == 0) return;
+	
+	// Tell how to reproduce the randomized search
+	Length += sprintf(&Pointer_Output_String[Length], ", random seed %llu", Pointer_Strategy->Random_Seed);
+	if (Pointer_Strategy->Restart_Policy == WORKER_RESTART_POLICY_LUBY) sprintf(&Pointer_Output_String[Length], ", Luby restarts of %llu nodes", Pointer_Strategy->Restart_Nodes_Count);
+	else if (Pointer_Strategy->Restart_Policy == WORKER_RESTART_POLICY_GEOMETRIC) sprintf(&Pointer_Output_String[Length], ", geometric restarts from %llu nodes growing by %g", Pointer_Strategy->Restart_Nodes_Count, Pointer_Strategy->Restart_Growth_Factor);
+}
+
+int WorkerWaitForAvailableWorker(TWorkerPool *Pointer_Pool, TWorker **Pointer_Pointer_Worker)
+{
+	TWorker *Pointer_Worker;
+	
+	// Block until a worker is available
+	Pointer_Worker = WorkerStackPop(Pointer_Pool);
 	*Pointer_Pointer_Worker = Pointer_Worker;
-	LOG(WORKER_IS_DEBUG_ENABLED, "A worker with TID %d is available (remaining available workers = %d, workers stack index = %d).\n", Pointer_Worker->Thread_ID, Available_Workers, Worker_Stack_Index);
+	LOG(WORKER_IS_DEBUG_ENABLED, "A worker with TID %d is available.\n", Pointer_Worker->Thread_ID);
 	
 	// Did this worker solve the grid ?
 	if (Pointer_Worker->Is_Grid_Solved) return 1;
 	return 0;
 }
 
+int WorkerWaitForCompletion(TWorkerPool *Pointer_Pool, TWorker **Pointer_Pointer_Worker)
+{
+	int Is_Grid_Solved;
+	
+	pthread_mutex_lock(&Pointer_Pool->Completion_Mutex);
+	while (!Pointer_Pool->Is_Solution_Found && (__atomic_load_n(&Pointer_Pool->Busy_Workers_Count, __ATOMIC_ACQUIRE) > 0)) pthread_cond_wait(&Pointer_Pool->Completion_Condition, &Pointer_Pool->Completion_Mutex);
+	Is_Grid_Solved = Pointer_Pool->Is_Solution_Found;
+	*Pointer_Pointer_Worker = Pointer_Pool->Pointer_Worker_Solution;
+	
+	// A part of the search tree that has not been searched can't prove that the grid has no solution (when counting, the solutions count is incomplete)
+	if (!Is_Grid_Solved && Pointer_Pool->Is_Error && !Pointer_Pool->Is_Search_Tree_Exhausted) Is_Grid_Solved = -1;
+	pthread_mutex_unlock(&Pointer_Pool->Completion_Mutex);
+	
+	return Is_Grid_Solved;
+}
+
+void WorkerCancel(TWorkerPool *Pointer_Pool)
+{
+	Pointer_Pool->Is_Cancellation_Requested = 1;
+}
+
+void WorkerWaitForAllWorkersIdle(TWorkerPool *Pointer_Pool)
+{
+	int i;
+	
+	pthread_mutex_lock(&Pointer_Pool->Completion_Mutex);
+	while (__atomic_load_n(&Pointer_Pool->Busy_Workers_Count, __ATOMIC_ACQUIRE) > 0) pthread_cond_wait(&Pointer_Pool->Completion_Condition, &Pointer_Pool->Completion_Mutex);
+	
+	// No worker is running, so the results can be safely cleared
+	Pointer_Pool->Is_Solution_Found = 0;
+	Pointer_Pool->Is_Cancellation_Requested = 0;
+	Pointer_Pool->Is_Error = 0;
+	Pointer_Pool->Is_Search_Tree_Exhausted = 0;
+	Pointer_Pool->Pointer_Worker_Solution = NULL;
+	Pointer_Pool->Solutions_Count = 0;
+	Pointer_Pool->First_Solution_Time = 0;
+	for (i = 0; i < Pointer_Pool->Created_Workers_Count; i++) Pointer_Pool->Pointer_Workers[i].Is_Grid_Solved = 0;
+	pthread_mutex_unlock(&Pointer_Pool->Completion_Mutex);
+}
+
 void WorkerExit(TWorker *Pointer_Worker)
 {
-	// Tell thread to exit (no need to remove worker from stack as it has been already popped by WorkerWaitForAvailableWorker())
+	// Tell thread to exit (no need to remove worker from stack as it has been already popped by WorkerWaitForAvailableWorker()), a worker without thread has nothing to do
 	LOG(WORKER_IS_DEBUG_ENABLED, "Telling thread with TID %d to exit.\n", Pointer_Worker->Thread_ID);
 	Pointer_Worker->Is_Exit_Requested = 1;
-	
-	// Wake thread up
-	pthread_mutex_lock(&Pointer_Worker->Mutex_Wait_Condition);
-	Pointer_Worker->Is_Waiting_Requested = 0;
-	pthread_cond_signal(&Pointer_Worker->Wait_Condition);
-	pthread_mutex_unlock(&Pointer_Worker->Mutex_Wait_Condition);
+	if (__atomic_exchange_n(&Pointer_Worker->Job_State, WORKER_JOB_STATE_GIVEN, __ATOMIC_ACQ_REL) == WORKER_JOB_STATE_SLEEPING) WorkerFutexWake(&Pointer_Worker->Job_State, 1);
 }
@@ -4,6 +4,9 @@
 if [ "$1" = "--slow" ]
 then
 	Is_Slow_Grids_Enabled=1
+elif [ "$1" = "--big" ]
+then
+	Is_Big_Grids_Enabled=1
 elif [ -n "$1" ]
 then
 	Result_File_Name="$1"
@@ -82,6 +85,16 @@ SolveList
 Files_List=$(find 16x16_*.txt)
 SolveList
 
+# Solve the grids bigger than 16x16 if enabled (the program must have been built with "make GRID_MAXIMUM_SIZE=64")
+if [ "$Is_Big_Grids_Enabled" = "1" ]
+then
+	Files_List=$(find 25x25_*.txt)
+	SolveList
+	
+	Files_List=$(find 36x36_*.txt)
+	SolveList
+fi
+
 # Solve slow grids if enabled
 if [ "$Is_Slow_Grids_Enabled" = "1" ]
 then